@@ -14,12 +14,29 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+
 #include "ngraph/cpio.hpp"
 #include "ngraph/log.hpp"
 
 using namespace ngraph;
 using namespace std;
 
+// Name of the records Writer inserts to align the data of the following record
+static const string s_padding_name = "!PADDING!";
+
+// filesize of a record whose size does not fit in 32 bits. The real size follows the padded
+// name as a little endian 64 bit value.
+static const uint32_t s_large_file_size = 0xFFFFFFFF;
+
+// Size of a record header including the padded name
+static size_t header_size(const string& name, uint64_t size)
+{
+    // namesize includes the null string terminator so + 1
+    size_t namesize = name.size() + 1;
+    return 26 + namesize + (namesize % 2) + (size >= s_large_file_size ? 8 : 0);
+}
+
 static uint16_t read_u16(istream& stream, bool big_endian = false)
 {
     uint8_t ch[2];
@@ -50,6 +67,20 @@ static uint32_t read_u32(istream& stream, bool big_endian = false)
     return rc;
 }
 
+static uint64_t read_u64(istream& stream)
+{
+    uint8_t ch[8];
+    uint64_t rc = 0;
+
+    stream.read(reinterpret_cast<char*>(&ch[0]), 8);
+    for (size_t i = 8; i > 0; i--)
+    {
+        rc = (rc << 8) + ch[i - 1];
+    }
+
+    return rc;
+}
+
 static void write_u16(ostream& stream, uint16_t value)
 {
     const char* p = reinterpret_cast<const char*>(&value);
@@ -63,6 +94,16 @@ static void write_u32(ostream& stream, uint32_t value)
     write_u16(stream, v[0]);
 }
 
+static void write_u64(ostream& stream, uint64_t value)
+{
+    uint8_t ch[8];
+    for (size_t i = 0; i < 8; i++)
+    {
+        ch[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+    stream.write(reinterpret_cast<const char*>(&ch[0]), 8);
+}
+
 cpio::Header cpio::Header::read(istream& stream)
 {
     uint8_t ch;
@@ -115,7 +156,7 @@ cpio::Header cpio::Header::read(istream& stream)
     return rc;
 }
 
-void cpio::Header::write(ostream& stream, const string& name, uint32_t size)
+void cpio::Header::write(ostream& stream, const string& name, uint64_t size)
 {
     // namesize includes the null string terminator so + 1
     uint16_t namesize = static_cast<uint16_t>(name.size()) + 1;
@@ -129,12 +170,17 @@ void cpio::Header::write(ostream& stream, const string& name, uint32_t size)
     write_u16(stream, 0);        // rdev
     write_u32(stream, 0);        // mtime
     write_u16(stream, namesize); // namesize
-    write_u32(stream, size);     // filesize
+    write_u32(stream, static_cast<uint32_t>(min<uint64_t>(size, s_large_file_size))); // filesize
     stream.write(name.c_str(), namesize + (namesize % 2));
+    if (size >= s_large_file_size)
+    {
+        write_u64(stream, size);
+    }
 }
 
 cpio::Writer::Writer()
     : m_stream(nullptr)
+    , m_offset(0)
 {
 }
 
@@ -162,15 +208,17 @@ cpio::Writer::~Writer()
 void cpio::Writer::open(ostream& out)
 {
     m_stream = &out;
+    m_offset = 0;
 }
 
 void cpio::Writer::open(const string& filename)
 {
     m_stream = &m_my_stream;
+    m_offset = 0;
     m_my_stream.open(filename, ios_base::binary | ios_base::out);
 }
 
-void cpio::Writer::write(const string& record_name, const void* data, uint32_t size_in_bytes)
+void cpio::Writer::write(const string& record_name, const void* data, size_t size_in_bytes)
 {
     if (m_stream)
     {
@@ -181,6 +229,7 @@ void cpio::Writer::write(const string& record_name, const void* data, uint32_t s
             char ch = 0;
             m_stream->write(&ch, 1);
         }
+        m_offset += header_size(record_name, size_in_bytes) + size_in_bytes + (size_in_bytes % 2);
     }
     else
     {
@@ -188,6 +237,27 @@ void cpio::Writer::write(const string& record_name, const void* data, uint32_t s
     }
 }
 
+void cpio::Writer::write(const string& record_name,
+                         const void* data,
+                         size_t size_in_bytes,
+                         size_t alignment)
+{
+    if (alignment % 2)
+    {
+        throw runtime_error("cpio alignment must be even");
+    }
+    if ((m_offset + header_size(record_name, size_in_bytes)) % alignment != 0)
+    {
+        // Everything in the archive is a multiple of 2 bytes, so the padding is too
+        size_t data_offset = m_offset + header_size(s_padding_name, 0) +
+                             header_size(record_name, size_in_bytes);
+        size_t padding = (alignment - data_offset % alignment) % alignment;
+        vector<char> zeros(padding, 0);
+        write(s_padding_name, zeros.data(), padding);
+    }
+    write(record_name, data, size_in_bytes);
+}
+
 cpio::Reader::Reader()
     : m_stream(nullptr)
 {
@@ -247,14 +317,21 @@ const vector<cpio::FileInfo>& cpio::Reader::get_file_info()
             {
                 m_stream->seekg(1, ios_base::cur);
             }
+            if (header.filesize == s_large_file_size)
+            {
+                header.filesize = read_u64(*m_stream);
+            }
 
             if (file_name == "TRAILER!!!")
             {
                 break;
             }
 
-            size_t offset = m_stream->tellg();
-            m_file_info.emplace_back(file_name, header.filesize, offset);
+            if (file_name != s_padding_name)
+            {
+                size_t offset = m_stream->tellg();
+                m_file_info.emplace_back(file_name, header.filesize, offset);
+            }
 
             m_stream->seekg((header.filesize % 2) + header.filesize, ios_base::cur);
         }
@@ -51,10 +51,12 @@ public:
     uint16_t rdev;
     uint32_t mtime;
     uint16_t namesize;
-    uint32_t filesize;
+    /// \brief Size of the record. Records of 0xFFFFFFFF bytes or more are written with a
+    ///        filesize of 0xFFFFFFFF and their 64 bit size stored after the name.
+    uint64_t filesize;
 
     static Header read(std::istream&);
-    static void write(std::ostream&, const std::string& name, uint32_t size);
+    static void write(std::ostream&, const std::string& name, uint64_t size);
 
 private:
 };
@@ -88,11 +90,20 @@ public:
 
     void open(std::ostream& out);
     void open(const std::string& filename);
-    void write(const std::string& file_name, const void* data, uint32_t size_in_bytes);
+    void write(const std::string& file_name, const void* data, size_t size_in_bytes);
+    /// \brief Write a file whose data starts at a multiple of alignment bytes from the start
+    ///        of the archive, so a memory mapped archive can use the data in place. Padding is
+    ///        written as a separate record that Reader skips.
+    /// \param alignment Must be even
+    void write(const std::string& file_name,
+               const void* data,
+               size_t size_in_bytes,
+               size_t alignment);
 
 private:
     std::ostream* m_stream;
     std::ofstream m_my_stream;
+    size_t m_offset;
 };
 
 class ngraph::cpio::Reader
@@ -14,6 +14,10 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
 #include <sstream>
 
 #include "ngraph/env_util.hpp"
@@ -65,6 +69,47 @@ int32_t ngraph::getenv_int(const char* env_var, int32_t default_value)
     return env;
 }
 
+size_t ngraph::getenv_size(const char* env_var, size_t default_value)
+{
+    const char* env_p = ::getenv(env_var);
+    size_t env = default_value;
+    if (env_p && *env_p)
+    {
+        const char* begin = env_p;
+        while (isspace(*begin))
+        {
+            begin++;
+        }
+        // strtoull negates a value with a leading minus sign instead of failing
+        if (*begin == '-')
+        {
+            return default_value;
+        }
+        errno = 0;
+        char* err;
+        unsigned long long value = strtoull(begin, &err, 0);
+        if (errno || value > numeric_limits<size_t>::max())
+        {
+            std::stringstream ss;
+            ss << "Environment variable \"" << env_var << "\"=\"" << env_p
+               << "\" is out of range." << std::endl;
+            throw runtime_error(ss.str());
+        }
+        if (*err)
+        {
+            std::stringstream ss;
+            ss << "Environment variable \"" << env_var << "\"=\"" << env_p
+               << "\" has a syntax error \"" << err << '\"' << std::endl;
+            throw runtime_error(ss.str());
+        }
+        if (value > 0)
+        {
+            env = static_cast<size_t>(value);
+        }
+    }
+    return env;
+}
+
 bool ngraph::getenv_bool(const char* env_var, bool default_value)
 {
     string value = to_lower(getenv_string(env_var));
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace ngraph
@@ -33,6 +35,14 @@ namespace ngraph
     /// \return Returns value or default_value if the environment variable is not set.
     int32_t getenv_int(const char* env_var, int32_t default_value = -1);
 
+    /// \brief Get the names environment variable as a size. If the value is not a valid
+    ///        integer or does not fit in a size_t then an exception is thrown.
+    /// \param env_var The string name of the environment variable to get.
+    /// \param default_value The value to return if the environment variable is not set or is
+    ///        not positive.
+    /// \return Returns the value of the environment variable or default_value.
+    size_t getenv_size(const char* env_var, size_t default_value);
+
     /// \brief Get the names environment variable as a boolean. If the value is not a
     ///        valid boolean then an exception is thrown. Valid booleans are one of
     ///        1, 0, on, off, true, false
@@ -21,6 +21,7 @@
 #include "distributed.hpp"
 #include "event_tracing.hpp"
 #include "ngraph/env_util.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 #include "nlohmann/json.hpp"
 
 using namespace std;
@@ -28,41 +29,51 @@ using namespace std;
 NGRAPH_API mutex ngraph::Event::s_file_mutex;
 NGRAPH_API ofstream ngraph::Event::s_event_log;
 NGRAPH_API bool ngraph::Event::s_tracing_enabled = ngraph::getenv_bool("NGRAPH_ENABLE_TRACING");
-NGRAPH_API bool ngraph::Event::s_event_writer_registered = false;
+NGRAPH_API atomic<bool> ngraph::Event::s_event_writer_registered{false};
 NGRAPH_API std::function<void(const ngraph::Event& event)> ngraph::Event::s_event_writer;
 
 void ngraph::Event::write_trace(const ngraph::Event& event)
 {
     if (is_tracing_enabled())
     {
-        lock_guard<mutex> lock(s_file_mutex);
         if (s_event_writer_registered)
         {
+            lock_guard<mutex> lock(s_file_mutex);
             s_event_writer(event);
             return;
         }
-        static bool so_initialized = false;
-        if (!so_initialized)
-        {
-            // Open the file
-            std::string file_name = "ngraph_event_trace.json";
-            if (get_distributed_interface()->get_size() > 1)
-            {
-                auto rank = std::to_string(get_distributed_interface()->get_rank());
-                int num_zero = 3;
-                std::string prefix = std::string(num_zero - rank.length(), '0') + rank + "_";
-                file_name.insert(0, prefix);
-            }
-            s_event_log.open(file_name, ios_base::trunc);
-            s_event_log << "[\n";
-            so_initialized = true;
-        }
-        else
-        {
-            s_event_log << ",\n";
-        }
+        static runtime::event::Recorder recorder(
+            [](const string& events) {
+                lock_guard<mutex> lock(s_file_mutex);
+                static bool so_initialized = false;
+                if (!so_initialized)
+                {
+                    // Open the file
+                    std::string file_name = "ngraph_event_trace.json";
+                    if (get_distributed_interface()->get_size() > 1)
+                    {
+                        auto rank = std::to_string(get_distributed_interface()->get_rank());
+                        int num_zero = 3;
+                        std::string prefix =
+                            std::string(num_zero - rank.length(), '0') + rank + "_";
+                        file_name.insert(0, prefix);
+                    }
+                    s_event_log.open(file_name, ios_base::trunc);
+                    s_event_log << "[\n";
+                    so_initialized = true;
+                }
+                else
+                {
+                    s_event_log << ",\n";
+                }
 
-        s_event_log << event.to_json() << "\n" << flush;
+                s_event_log << events << "\n" << flush;
+            },
+            getenv_size("NGRAPH_TRACE_BUFFER_RECORDS", 8192),
+            chrono::milliseconds(getenv_size("NGRAPH_TRACE_FLUSH_MS", 100)));
+        auto start = event.m_start.time_since_epoch().count() / 1000;
+        auto stop = event.m_stop.time_since_epoch().count() / 1000;
+        recorder.record(event.m_name, event.m_category, event.m_args, start, stop - start, true);
     }
 }
 
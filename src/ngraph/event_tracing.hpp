@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <iostream>
@@ -111,6 +112,8 @@ namespace ngraph
             s_event_writer_registered = true;
             s_event_writer = callback;
         }
+        // Passes the event to the registered writer, or buffers it for the background thread
+        // that writes ngraph_event_trace.json (see runtime::event::Recorder)
         static void write_trace(const Event& event);
         static bool is_tracing_enabled() { return s_tracing_enabled; }
         static void enable_event_tracing();
@@ -130,7 +133,7 @@ namespace ngraph
         NGRAPH_API static std::ofstream s_event_log;
         NGRAPH_API static bool s_tracing_enabled;
         NGRAPH_API static std::function<void(const Event& event)> s_event_writer;
-        NGRAPH_API static bool s_event_writer_registered;
+        NGRAPH_API static std::atomic<bool> s_event_writer_registered;
     };
 
 } // namespace ngraph
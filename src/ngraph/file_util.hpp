@@ -32,7 +32,8 @@ namespace ngraph
         /// \param path The path to the output file
         std::string get_file_ext(const std::string& path);
 
-        /// \brief Returns the directory portion of the given path
+        /// \brief Returns the directory portion of the given path, or an empty string if the
+        ///        path has no directory component
         /// \param path The path to the output file
         std::string get_directory(const std::string& path);
 
@@ -93,21 +93,39 @@ namespace ngraph
         } // namespace detail
 
         Graph::Graph(const onnx::GraphProto& graph_proto, Model& model)
+            : Graph(graph_proto, model, nullptr)
+        {
+        }
+
+        Graph::Graph(onnx::GraphProto& graph_proto, Model& model)
+            : Graph(graph_proto, model, &graph_proto)
+        {
+        }
+
+        Graph::Graph(const onnx::GraphProto& graph_proto,
+                     Model& model,
+                     onnx::GraphProto* owned_proto)
             : m_graph_proto{&graph_proto}
             , m_model{&model}
         {
             // Process all initializers in the graph
-            for (const auto& initializer_tensor : m_graph_proto->initializer())
+            for (int i = 0; i < m_graph_proto->initializer_size(); ++i)
             {
+                const auto& initializer_tensor = m_graph_proto->initializer(i);
                 if (initializer_tensor.has_name())
                 {
-                    Tensor tensor = Tensor{initializer_tensor};
+                    Tensor tensor = Tensor{initializer_tensor, &m_model->get_external_data()};
                     m_initializers.emplace(initializer_tensor.name(), tensor);
 
                     // For each initializer, create a Constant node and store in cache
                     auto ng_constant = tensor.get_ng_constant();
                     add_provenance_tag_to_initializer(tensor, ng_constant);
                     m_ng_node_cache.emplace(initializer_tensor.name(), std::move(ng_constant));
+                    if (owned_proto != nullptr)
+                    {
+                        // The constant holds its own copy of the data, or a mapping of it
+                        detail::tensor::release_data(*owned_proto->mutable_initializer(i));
+                    }
                 }
             }
 
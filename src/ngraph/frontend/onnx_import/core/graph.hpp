@@ -34,6 +34,9 @@ namespace ngraph
         {
         public:
             Graph(const onnx::GraphProto& proto, Model& model);
+            /// \brief Import a graph the caller owns. The data of each initializer is released
+            ///        once its constant is built, so the import does not hold both at once.
+            Graph(onnx::GraphProto& proto, Model& model);
             const std::vector<Node>& get_nodes() const { return m_nodes; }
             const std::vector<ValueInfo>& get_inputs() const { return m_inputs; }
             const std::vector<ValueInfo>& get_outputs() const { return m_outputs; }
@@ -56,6 +59,8 @@ namespace ngraph
             void add_provenance_tags(const Node& onnx_node, const NodeVector& ng_node_vector) const;
 
         private:
+            Graph(const onnx::GraphProto& proto, Model& model, onnx::GraphProto* owned_proto);
+
             const onnx::GraphProto* m_graph_proto;
             std::vector<Node> m_nodes;
             std::vector<ValueInfo> m_inputs;
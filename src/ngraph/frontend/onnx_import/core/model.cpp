@@ -24,8 +24,10 @@ namespace ngraph
 {
     namespace onnx_import
     {
-        Model::Model(const onnx::ModelProto& model_proto)
+        Model::Model(const onnx::ModelProto& model_proto, const std::string& model_dir)
             : m_model_proto{&model_proto}
+            , m_model_dir{model_dir}
+            , m_external_data{std::make_shared<ExternalData>(model_dir)}
         {
             // Walk through the elements of opset_import field and register operator sets
             // for each domain. An exception UnknownDomain() will raise if the domain is
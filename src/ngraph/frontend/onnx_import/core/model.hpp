@@ -16,12 +16,14 @@
 
 #pragma once
 
+#include <memory>
 #include <onnx/onnx_pb.h>
 #include <ostream>
 #include <string>
 #include <unordered_map>
 
 #include "operator_set.hpp"
+#include "tensor.hpp"
 
 namespace ngraph
 {
@@ -31,7 +33,10 @@ namespace ngraph
         {
         public:
             Model() = delete;
-            explicit Model(const onnx::ModelProto& model_proto);
+            /// \param model_proto The model
+            /// \param model_dir The directory of the model file, against which the locations of
+            ///        external tensor data are resolved
+            explicit Model(const onnx::ModelProto& model_proto, const std::string& model_dir = "");
 
             Model(const Model&) = default;
             Model(Model&&) = default;
@@ -42,6 +47,9 @@ namespace ngraph
             const std::string& get_producer_name() const { return m_model_proto->producer_name(); }
             const onnx::GraphProto& get_graph() const { return m_model_proto->graph(); }
             std::int64_t get_model_version() const { return m_model_proto->model_version(); }
+            const std::string& get_model_dir() const { return m_model_dir; }
+            /// \brief The external data files of the model's tensors, mapped while importing
+            ExternalData& get_external_data() const { return *m_external_data; }
             const std::string& get_producer_version() const
             {
                 return m_model_proto->producer_version();
@@ -75,6 +83,8 @@ namespace ngraph
         private:
             const onnx::ModelProto* m_model_proto;
             std::unordered_map<std::string, OperatorSet> m_opset;
+            std::string m_model_dir;
+            std::shared_ptr<ExternalData> m_external_data;
         };
 
         inline std::ostream& operator<<(std::ostream& outs, const Model& model)
@@ -16,11 +16,17 @@
 
 #pragma once
 
+#include <memory>
 #include <onnx/onnx_pb.h>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "ngraph/file_util.hpp"
+#include "ngraph/mapped_file.hpp"
 #include "ngraph/op/constant.hpp"
+#include "ngraph/runtime/shared_buffer.hpp"
 #include "ngraph/shape.hpp"
 #include "ngraph/type/element_type.hpp"
 
@@ -90,6 +96,23 @@ namespace ngraph
                     {
                     }
                 };
+
+                struct invalid_data_size : ngraph_error
+                {
+                    invalid_data_size(std::size_t expected, std::size_t actual)
+                        : ngraph_error{"tensor data has " + std::to_string(actual) +
+                                       " bytes, expected " + std::to_string(expected)}
+                    {
+                    }
+                };
+
+                struct invalid_external_data : ngraph_error
+                {
+                    explicit invalid_external_data(const std::string& reason)
+                        : ngraph_error{"invalid external data: " + reason}
+                    {
+                    }
+                };
             }
         }
 
@@ -141,6 +164,19 @@ namespace ngraph
                     }
                 }
 
+                /// \brief Drop the payload of a tensor whose Constant has been built. The
+                ///        type, dims and external data location are kept.
+                inline void release_data(onnx::TensorProto& tensor)
+                {
+                    tensor.clear_raw_data();
+                    tensor.clear_float_data();
+                    tensor.clear_double_data();
+                    tensor.clear_int32_data();
+                    tensor.clear_int64_data();
+                    tensor.clear_uint64_data();
+                    tensor.clear_string_data();
+                }
+
                 template <typename T>
                 inline std::vector<T> get_data(const onnx::TensorProto& tensor)
                 {
@@ -337,6 +373,36 @@ namespace ngraph
             }
         }
 
+        /// \brief The external data files of one model. Each file is memory mapped once and
+        ///        shared by all of the tensors stored in it. Constants that use a mapping in
+        ///        place keep it alive after the import.
+        class ExternalData
+        {
+        public:
+            /// \param model_dir The directory of the model file, against which the locations
+            ///        of external data are resolved
+            explicit ExternalData(const std::string& model_dir)
+                : m_model_dir{model_dir}
+            {
+            }
+
+            std::shared_ptr<MappedFile> get_file(const std::string& location)
+            {
+                auto it = m_files.find(location);
+                if (it == m_files.end())
+                {
+                    auto mapping =
+                        std::make_shared<MappedFile>(file_util::path_join(m_model_dir, location));
+                    it = m_files.emplace(location, mapping).first;
+                }
+                return it->second;
+            }
+
+        private:
+            std::string m_model_dir;
+            std::unordered_map<std::string, std::shared_ptr<MappedFile>> m_files;
+        };
+
         class Tensor
         {
         public:
@@ -361,9 +427,13 @@ namespace ngraph
             };
 
             Tensor() = delete;
-            explicit Tensor(const onnx::TensorProto& tensor)
+            /// \param tensor The tensor proto
+            /// \param external_data The external data files of the model. When null, locations
+            ///        are resolved against the working directory.
+            explicit Tensor(const onnx::TensorProto& tensor, ExternalData* external_data = nullptr)
                 : m_tensor_proto{&tensor}
                 , m_shape{std::begin(tensor.dims()), std::end(tensor.dims())}
+                , m_external_data{external_data}
             {
                 if (m_shape == Shape{0})
                 {
@@ -438,6 +508,23 @@ namespace ngraph
             operator TensorProto_DataType() const { return m_tensor_proto->data_type(); }
             std::shared_ptr<ngraph::op::Constant> get_ng_constant() const
             {
+                if (m_tensor_proto->has_segment())
+                {
+                    throw error::tensor::segments_unsupported{};
+                }
+                // Build the constant straight from the serialized bytes, which are laid out
+                // like the constant data, instead of going through get_data()
+                if (m_tensor_proto->data_location() ==
+                    onnx::TensorProto_DataLocation::TensorProto_DataLocation_EXTERNAL)
+                {
+                    return make_external_ng_constant();
+                }
+                if (m_tensor_proto->has_raw_data() &&
+                    m_tensor_proto->raw_data().size() == get_data_size(get_ng_type()))
+                {
+                    return std::make_shared<ngraph::op::Constant>(
+                        get_ng_type(), m_shape, m_tensor_proto->raw_data().data());
+                }
                 switch (m_tensor_proto->data_type())
                 {
                 case onnx::TensorProto_DataType::TensorProto_DataType_BOOL:
@@ -475,8 +562,88 @@ namespace ngraph
                 return std::make_shared<ngraph::op::Constant>(type, m_shape, get_data<T>());
             }
 
+            std::size_t get_data_size(const element::Type& type) const
+            {
+                return shape_size(m_shape) * type.size();
+            }
+
+            /// \brief Creates a constant from data stored in a separate file. The file is
+            ///        memory mapped, and the constant uses the data in place if it is suitably
+            ///        aligned. Otherwise the data is copied once.
+            std::shared_ptr<ngraph::op::Constant> make_external_ng_constant() const
+            {
+                const element::Type& type = get_ng_type();
+                std::string location;
+                std::size_t offset = 0;
+                std::size_t length = get_data_size(type);
+                for (const auto& entry : m_tensor_proto->external_data())
+                {
+                    if (entry.key() == "location")
+                    {
+                        location = entry.value();
+                    }
+                    else if (entry.key() == "offset")
+                    {
+                        offset = parse_external_size(entry.key(), entry.value());
+                    }
+                    else if (entry.key() == "length")
+                    {
+                        length = parse_external_size(entry.key(), entry.value());
+                    }
+                }
+                if (location.empty())
+                {
+                    throw error::tensor::invalid_external_data{"no location"};
+                }
+                if (length != get_data_size(type))
+                {
+                    throw error::tensor::invalid_data_size{get_data_size(type), length};
+                }
+
+                std::shared_ptr<MappedFile> mapping = m_external_data
+                                                          ? m_external_data->get_file(location)
+                                                          : ExternalData{""}.get_file(location);
+                if (offset > mapping->size() || length > mapping->size() - offset)
+                {
+                    throw error::tensor::invalid_external_data{"data extends past the end of " +
+                                                               location};
+                }
+                char* data = mapping->data() + offset;
+                if (reinterpret_cast<std::size_t>(data) %
+                        ngraph::op::Constant::host_alignment() ==
+                    0)
+                {
+                    auto buffer =
+                        std::make_shared<runtime::SharedBuffer<std::shared_ptr<MappedFile>>>(
+                            data, length, mapping);
+                    return std::make_shared<ngraph::op::Constant>(type, m_shape, buffer);
+                }
+                return std::make_shared<ngraph::op::Constant>(type, m_shape, data);
+            }
+
+            static std::size_t parse_external_size(const std::string& key,
+                                                   const std::string& value)
+            {
+                // std::stoull accepts signs and trailing characters, and wraps negative values
+                if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+                {
+                    throw error::tensor::invalid_external_data{"invalid " + key + " '" + value +
+                                                               "'"};
+                }
+                try
+                {
+                    return std::stoull(value);
+                }
+                catch (const std::out_of_range&)
+                {
+                    throw error::tensor::invalid_external_data{key + " " + value +
+                                                               " is out of range"};
+                }
+            }
+
             const onnx::TensorProto* m_tensor_proto;
             Shape m_shape;
+            ExternalData* m_external_data;
         };
 
         inline std::ostream& operator<<(std::ostream& outs, const Tensor& tensor)
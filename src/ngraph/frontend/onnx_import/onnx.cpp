@@ -15,13 +15,18 @@
 //*****************************************************************************
 
 #include <fstream>
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/text_format.h>
+#include <limits>
 #include <memory>
 
 #include "core/graph.hpp"
 #include "core/model.hpp"
 #include "ngraph/except.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/mapped_file.hpp"
 #include "onnx.hpp"
 #include "ops_bridge.hpp"
 
@@ -49,18 +54,61 @@ namespace ngraph
                     }
                 };
 
+                struct file_parse : ngraph_error
+                {
+                    explicit file_parse(const std::string& path)
+                        : ngraph_error{"Failure parsing data from file: " + path}
+                    {
+                    }
+                };
+
             } // namespace error
-        }     // namespace detail
 
-        std::shared_ptr<Function> import_onnx_model(std::istream& sin)
+            // Parses a binary model. Protobuf limits messages to 64 MB by default, which is
+            // raised to its hard limit of 2 GB. Larger models have to keep their initializers
+            // in external data files.
+            bool parse_binary(google::protobuf::io::ZeroCopyInputStream& input,
+                              onnx::ModelProto& model_proto)
+            {
+                google::protobuf::io::CodedInputStream coded_input(&input);
+                coded_input.SetTotalBytesLimit(std::numeric_limits<int>::max(),
+                                               std::numeric_limits<int>::max());
+                return model_proto.ParseFromCodedStream(&coded_input) &&
+                       coded_input.ConsumedEntireMessage();
+            }
+
+            std::shared_ptr<Function> convert_model(onnx::ModelProto& model_proto,
+                                                    const std::string& model_dir)
+            {
+                Model model{model_proto, model_dir};
+                Graph graph{*model_proto.mutable_graph(), model};
+                auto function = std::make_shared<Function>(
+                    graph.get_ng_outputs(), graph.get_ng_parameters(), graph.get_name());
+                for (std::size_t i{0}; i < function->get_output_size(); ++i)
+                {
+                    function->get_output_op(i)->set_friendly_name(
+                        graph.get_outputs().at(i).get_name());
+                }
+                return function;
+            }
+        } // namespace detail
+
+        std::shared_ptr<Function> import_onnx_model(std::istream& sin,
+                                                    const std::string& model_dir)
         {
             onnx::ModelProto model_proto;
-            // Try parsing input as a binary protobuf message
-            if (!model_proto.ParseFromIstream(&sin))
+            bool parsed;
+            {
+                // Try parsing input as a binary protobuf message
+                google::protobuf::io::IstreamInputStream iistream(&sin);
+                parsed = detail::parse_binary(iistream, model_proto);
+            }
+            if (!parsed)
             {
                 // Rewind to the beginning and clear stream state.
                 sin.clear();
                 sin.seekg(0);
+                model_proto.Clear();
                 google::protobuf::io::IstreamInputStream iistream(&sin);
                 // Try parsing input as a prototxt message
                 if (!google::protobuf::TextFormat::Parse(&iistream, &model_proto))
@@ -68,26 +116,43 @@ namespace ngraph
                     throw detail::error::stream_parse{sin};
                 }
             }
-
-            Model model{model_proto};
-            Graph graph{model_proto.graph(), model};
-            auto function = std::make_shared<Function>(
-                graph.get_ng_outputs(), graph.get_ng_parameters(), graph.get_name());
-            for (std::size_t i{0}; i < function->get_output_size(); ++i)
-            {
-                function->get_output_op(i)->set_friendly_name(graph.get_outputs().at(i).get_name());
-            }
-            return function;
+            return detail::convert_model(model_proto, model_dir);
         }
 
         std::shared_ptr<Function> import_onnx_model(const std::string& path)
         {
-            std::ifstream ifs{path, std::ios::in | std::ios::binary};
-            if (!ifs.is_open())
+            onnx::ModelProto model_proto;
             {
-                throw detail::error::file_open{path};
+                // Parse straight from a mapping of the file rather than through a stream
+                // buffer. The mapping is released once the message holds the data.
+                std::unique_ptr<MappedFile> mapping;
+                try
+                {
+                    mapping.reset(new MappedFile(path));
+                }
+                catch (const ngraph_error&)
+                {
+                    throw detail::error::file_open{path};
+                }
+                if (mapping->size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+                {
+                    throw ngraph_error("ONNX model file " + path +
+                                       " exceeds 2 GB; store its initializers as external data");
+                }
+                int size = static_cast<int>(mapping->size());
+                google::protobuf::io::ArrayInputStream binary_input(mapping->data(), size);
+                if (!detail::parse_binary(binary_input, model_proto))
+                {
+                    model_proto.Clear();
+                    google::protobuf::io::ArrayInputStream text_input(mapping->data(), size);
+                    if (!google::protobuf::TextFormat::Parse(&text_input, &model_proto))
+                    {
+                        throw detail::error::file_parse{path};
+                    }
+                }
             }
-            return import_onnx_model(ifs);
+            // External data locations are relative to the directory of the model file
+            return detail::convert_model(model_proto, file_util::get_directory(path));
         }
 
         void register_operator(const std::string& name,
@@ -70,9 +70,12 @@ namespace ngraph
         /// The function translated serialized ONNX model to nGraph function. The serialized
         /// ONNX model is read from input stream.
         /// \param sin       input stream (e.g. file stream, memory stream, etc)
+        /// \param model_dir directory that external data locations are relative to; when empty
+        ///                  they are resolved against the current working directory
         /// \return The function returns a nGraph function representing single output from graph.
         NGRAPH_API
-        std::shared_ptr<Function> import_onnx_model(std::istream& sin);
+        std::shared_ptr<Function> import_onnx_model(std::istream& sin,
+                                                    const std::string& model_dir = "");
 
         /// \brief Convert an ONNX model to nGraph functions
         /// The function translated serialized ONNX model to nGraph functions. The ONNX model
@@ -98,6 +98,19 @@ void Function::init()
 
 std::list<shared_ptr<Node>> Function::get_ordered_ops(bool include_control_deps) const
 {
+    lock_guard<mutex> lock(m_ordered_ops_mutex);
+    OrderedOps& cache = m_ordered_ops[include_control_deps ? 1 : 0];
+    size_t topology_version = Node::get_topology_version();
+    if (cache.valid && cache.topology_version == topology_version)
+    {
+        std::list<shared_ptr<Node>> ordered_ops;
+        for (Node* node : cache.nodes)
+        {
+            ordered_ops.push_back(node->shared_from_this());
+        }
+        return ordered_ops;
+    }
+
     NodeVector nodes;
     for (auto& r : get_results())
     {
@@ -108,7 +121,15 @@ std::list<shared_ptr<Node>> Function::get_ordered_ops(bool include_control_deps)
         nodes.push_back(param);
     }
 
-    return topological_sort(nodes, include_control_deps);
+    std::list<shared_ptr<Node>> ordered_ops = topological_sort(nodes, include_control_deps);
+    cache.nodes.clear();
+    for (auto& node : ordered_ops)
+    {
+        cache.nodes.push_back(node.get());
+    }
+    cache.topology_version = topology_version;
+    cache.valid = true;
+    return ordered_ops;
 }
 
 void Function::map_unordered_ops(std::function<void(Node*)> f) const
@@ -168,7 +189,7 @@ void Function::set_friendly_name(const string& name)
     }
 }
 
-size_t Function::get_temporary_pool_size()
+size_t Function::get_temporary_pool_size() const
 {
     return m_temporary_pool_size;
 }
@@ -294,4 +315,5 @@ void Function::replace_parameter(size_t parameter_index, const shared_ptr<op::Pa
                  " parameters.");
     replace_node(m_parameters[parameter_index], parameter);
     m_parameters[parameter_index] = parameter;
+    Node::increment_topology_version();
 }
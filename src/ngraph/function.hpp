@@ -20,6 +20,7 @@
 #include <initializer_list>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -93,12 +94,17 @@ namespace ngraph
         const std::string& get_friendly_name() const;
 
         std::list<std::shared_ptr<Node>> get_ops(bool include_control_deps = true) const;
+        /// \brief The function's nodes in topological order. The order is cached and only
+        ///        recomputed after the topology version changes.
         std::list<std::shared_ptr<Node>> get_ordered_ops(bool include_control_deps = true) const;
+        /// \brief Changes whenever the result of get_ordered_ops() may have changed, so passes
+        ///        can cheaply tell whether the graph was rewired since they last looked.
+        size_t get_topology_version() const { return Node::get_topology_version(); }
         void map_unordered_ops(std::function<void(Node*)> f) const;
 
         friend std::ostream& operator<<(std::ostream&, const Function&);
         size_t get_instance_id() { return m_instance_id; }
-        size_t get_temporary_pool_size();
+        size_t get_temporary_pool_size() const;
         void set_temporary_pool_size(size_t);
         // updates graph and m_results list
         void replace_node(std::shared_ptr<Node> old, std::shared_ptr<Node> repl);
@@ -139,5 +145,18 @@ namespace ngraph
         std::string m_name;
         const std::string m_unique_name;
         size_t m_placement{0};
+
+        // Topological orders with and without control dependencies and the topology versions
+        // they were computed at. Nodes are not owned: while the version is unchanged every
+        // cached node is reachable from m_results or m_parameters and so kept alive by them,
+        // and holding them would keep replaced nodes alive as users of live ones.
+        struct OrderedOps
+        {
+            bool valid{false};
+            size_t topology_version{0};
+            std::vector<Node*> nodes;
+        };
+        mutable OrderedOps m_ordered_ops[2];
+        mutable std::mutex m_ordered_ops_mutex;
     };
 }
@@ -0,0 +1,85 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include "ngraph/check.hpp"
+#include "ngraph/mapped_file.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+MappedFile::MappedFile(const string& path)
+{
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    NGRAPH_CHECK(fd != -1, "Unable to open '", path, "': ", strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        int err = errno;
+        close(fd);
+        NGRAPH_CHECK(false, "Unable to stat '", path, "': ", strerror(err));
+    }
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size > 0)
+    {
+        // A private writable mapping is copy-on-write: pages are shared with the page cache
+        // until written, and writes are never carried through to the file.
+        void* p = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        int err = errno;
+        close(fd);
+        NGRAPH_CHECK(p != MAP_FAILED, "Unable to map '", path, "': ", strerror(err));
+        m_data = static_cast<char*>(p);
+        m_mapped = true;
+    }
+    else
+    {
+        close(fd);
+    }
+#else
+    ifstream in(path, ios_base::binary | ios_base::in | ios_base::ate);
+    NGRAPH_CHECK(in, "Unable to open '", path, "'");
+    m_size = static_cast<size_t>(in.tellg());
+    if (m_size > 0)
+    {
+        m_data = static_cast<char*>(ngraph_malloc(m_size));
+        in.seekg(0, ios_base::beg);
+        in.read(m_data, m_size);
+    }
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+    {
+#ifndef _WIN32
+        munmap(m_data, m_size);
+#else
+        ngraph_free(m_data);
+#endif
+    }
+}
@@ -0,0 +1,53 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ngraph/ngraph_visibility.hpp"
+
+namespace ngraph
+{
+    class MappedFile;
+}
+
+/// \brief Copy-on-write memory mapping of a whole file. The data may be modified, but changes
+///        are private to the mapping and never written back to the file. The mapping is
+///        released when the object is destroyed. On platforms without mmap the file is read
+///        into memory instead.
+class NGRAPH_API ngraph::MappedFile
+{
+public:
+    /// \brief Map the file at path. Throws if the file cannot be opened or mapped.
+    MappedFile(const std::string& path);
+    ~MappedFile();
+
+    char* data() { return m_data; }
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    /// \brief True if data() points into a memory mapping rather than a heap copy
+    bool is_mapped() const { return m_mapped; }
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    char* m_data{nullptr};
+    size_t m_size{0};
+    bool m_mapped{false};
+};
@@ -34,6 +34,7 @@ using namespace std;
 using namespace ngraph;
 
 atomic<size_t> Node::m_next_instance_id(0);
+atomic<size_t> Node::m_topology_version(0);
 
 Node::Node(size_t output_size)
     : Node()
@@ -538,6 +539,7 @@ void Node::add_control_dependency(std::shared_ptr<Node> node)
         {
             node->m_control_dependents.push_back(this);
         }
+        increment_topology_version();
     }
 }
 
@@ -564,6 +566,7 @@ void Node::remove_control_dependency(std::shared_ptr<Node> node)
         if (it != m_control_dependencies.end())
         {
             m_control_dependencies.erase(it);
+            increment_topology_version();
         }
     }
     {
@@ -585,7 +588,11 @@ void Node::clear_control_dependencies()
             node->m_control_dependents.erase(it);
         }
     }
-    m_control_dependencies.clear();
+    if (!m_control_dependencies.empty())
+    {
+        m_control_dependencies.clear();
+        increment_topology_version();
+    }
 }
 
 void Node::clear_control_dependents()
@@ -311,6 +311,14 @@ namespace ngraph
         /// This node becomes a dependent of every node dependent on source_node
         void add_node_control_dependents(std::shared_ptr<Node> source_node);
 
+        /// \brief Incremented whenever an input of any node is connected to a different output
+        ///        or a control dependency is added or removed, i.e. whenever the nodes reachable
+        ///        from a function's results, or their order, may have changed. Cached
+        ///        traversals such as Function::get_ordered_ops() compare it to detect that they
+        ///        are stale.
+        static size_t get_topology_version() { return m_topology_version; }
+        static void increment_topology_version() { m_topology_version++; }
+
         /// Returns the number of outputs from the node.
         size_t get_output_size() const;
 
@@ -526,6 +534,7 @@ namespace ngraph
         std::string m_friendly_name;
         std::string m_unique_name;
         static std::atomic<size_t> m_next_instance_id;
+        static std::atomic<size_t> m_topology_version;
         std::unordered_set<std::string> m_provenance_tags;
         std::set<std::shared_ptr<Node>> m_provenance_group;
         std::deque<descriptor::Input> m_inputs;
@@ -94,6 +94,18 @@ namespace ngraph
                 /// \param data A void* to constant data.
                 Constant(const element::Type& type, const Shape& shape, const void* data);
 
+                /// \brief Constructs a tensor constant that uses data as its storage without
+                ///        copying it
+                ///
+                /// \param type The element type of the tensor constant.
+                /// \param shape The shape of the tensor constant.
+                /// \param data The buffer holding the constant data, for example a
+                ///        runtime::SharedBuffer over a memory mapped file. It must be at least as
+                ///        large as the tensor.
+                Constant(const element::Type& type,
+                         const Shape& shape,
+                         const std::shared_ptr<runtime::AlignedBuffer>& data);
+
                 virtual ~Constant() override;
 
                 void validate_and_infer_types() override
@@ -266,6 +278,12 @@ namespace ngraph
                 }
 
                 const void* get_data_ptr() const { return (m_data ? m_data->get_ptr() : nullptr); }
+                /// \brief The buffer holding the constant data. Other constants may share it, so
+                ///        it must not be modified.
+                const std::shared_ptr<runtime::AlignedBuffer>& get_data_buffer() const
+                {
+                    return m_data;
+                }
                 template <typename T>
                 const T* get_data_ptr() const
                 {
@@ -279,6 +297,9 @@ namespace ngraph
                 }
                 std::string convert_value_to_string(size_t index) const;
 
+                /// \brief Alignment in bytes of the constant data
+                static constexpr size_t host_alignment() { return 64; }
+
             protected:
                 void* get_data_ptr_nc() { return (m_data ? m_data->get_ptr() : nullptr); }
                 Constant(const OutputVector& args)
@@ -371,10 +392,9 @@ namespace ngraph
 #endif
                 }
 
-                static constexpr size_t host_alignment() { return 64; }
                 element::Type m_element_type;
                 Shape m_shape{};
-                std::unique_ptr<runtime::AlignedBuffer> m_data;
+                std::shared_ptr<runtime::AlignedBuffer> m_data;
                 bool m_all_elements_bitwise_identical;
                 bool are_all_data_elements_bitwise_identical() const;
                 Constant(const Constant&) = delete;
@@ -15,18 +15,194 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <list>
 #include <regex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "graph_rewrite.hpp"
 #include "ngraph/env_util.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/pass/pass_profile.hpp"
+#include "ngraph/pattern/op/pattern.hpp"
 
 using namespace std;
 using namespace ngraph;
 
+namespace
+{
+    // Per-matcher statistics of one GraphRewrite run, merged by matcher name since matchers
+    // that request another pass register new Matcher objects.
+    class MatcherProfiler
+    {
+    public:
+        pass::PassProfile::MatcherRecord& get_record(const string& name)
+        {
+            auto it = m_index.find(name);
+            if (it == m_index.end())
+            {
+                it = m_index.insert({name, m_records.size()}).first;
+                m_records.emplace_back();
+                m_records.back().name = name;
+            }
+            return m_records[it->second];
+        }
+
+        void write_to(pass::PassProfile& profile) const
+        {
+            for (auto& record : m_records)
+            {
+                profile.add_matcher_record(record);
+            }
+        }
+
+    private:
+        unordered_map<string, size_t> m_index;
+        vector<pass::PassProfile::MatcherRecord> m_records;
+    };
+
+    // Charges the time spent trying one matcher on one node to its record
+    class MatcherTimer
+    {
+    public:
+        MatcherTimer(pass::PassProfile::MatcherRecord* record)
+            : m_record(record)
+        {
+            if (m_record)
+            {
+                m_record->attempts++;
+                m_start = chrono::steady_clock::now();
+            }
+        }
+        ~MatcherTimer()
+        {
+            if (m_record)
+            {
+                m_record->time += chrono::steady_clock::now() - m_start;
+            }
+        }
+
+    private:
+        pass::PassProfile::MatcherRecord* m_record;
+        chrono::steady_clock::time_point m_start;
+    };
+
+    // For each node type, the matchers whose pattern root can match a node of that type, in
+    // registration order. A pattern rooted at an ordinary op only matches nodes of exactly
+    // that type; one rooted at a pattern op (Label, Any, Skip, ...) may match any node.
+    class MatcherDispatch
+    {
+    public:
+        // root_types[i] is the root type of matcher i, or nullptr if it may match any node
+        MatcherDispatch(const vector<const Node::type_info_t*>& root_types)
+            : m_root_types(root_types)
+        {
+        }
+
+        const vector<size_t>& get_matchers(const Node& node)
+        {
+            const Node::type_info_t& type_info = node.get_type_info();
+            auto it = m_matchers.find(type_info);
+            if (it == m_matchers.end())
+            {
+                vector<size_t> matchers;
+                for (size_t i = 0; i < m_root_types.size(); i++)
+                {
+                    if (m_root_types[i] == nullptr || *m_root_types[i] == type_info)
+                    {
+                        matchers.push_back(i);
+                    }
+                }
+                it = m_matchers.insert({type_info, matchers}).first;
+            }
+            return it->second;
+        }
+
+    private:
+        vector<const Node::type_info_t*> m_root_types;
+        unordered_map<Node::type_info_t, vector<size_t>> m_matchers;
+    };
+
+    // The input sources and user count of every node at the start of a GraphRewrite iteration,
+    // used to find what the iteration changed.
+    class ConnectionSnapshot
+    {
+    public:
+        bool is_taken() const { return m_taken; }
+        void take(const list<shared_ptr<Node>>& nodes)
+        {
+            for (auto& node : nodes)
+            {
+                m_connections[node.get()] = get_connections(*node);
+            }
+            m_taken = true;
+        }
+
+        // Mark a node a successful callback was run on, which may not have changed its
+        // connections but was not tried with the remaining matchers.
+        void add_rewritten_root(const Node* node) { m_rewritten_roots.insert(node); }
+        // The nodes of nodes, in the same order, that were added or rewired since the snapshot
+        // was taken, or whose inputs transitively are.
+        list<shared_ptr<Node>> get_changed_cone(const list<shared_ptr<Node>>& nodes) const
+        {
+            unordered_set<const Node*> cone;
+            list<shared_ptr<Node>> result;
+            for (auto& node : nodes)
+            {
+                bool changed = (m_rewritten_roots.count(node.get()) != 0);
+                if (!changed)
+                {
+                    auto it = m_connections.find(node.get());
+                    changed = (it == m_connections.end() || it->second != get_connections(*node));
+                }
+                for (size_t i = 0; !changed && i < node->get_input_size(); i++)
+                {
+                    changed = (cone.count(node->get_input_node_ptr(i)) != 0);
+                }
+                if (changed)
+                {
+                    cone.insert(node.get());
+                    result.push_back(node);
+                }
+            }
+            return result;
+        }
+
+    private:
+        // The source of each input followed by the number of users
+        using Connections = vector<pair<const Node*, size_t>>;
+
+        static Connections get_connections(const Node& node)
+        {
+            Connections connections;
+            for (size_t i = 0; i < node.get_input_size(); i++)
+            {
+                Output<Node> source = node.input_value(i);
+                connections.push_back({source.get_node(), source.get_index()});
+            }
+            connections.push_back({nullptr, node.get_users().size()});
+            return connections;
+        }
+
+        bool m_taken = false;
+        // Keyed by address; the nodes of the snapshot must stay alive until the comparison, or
+        // no new nodes may be created after they are released.
+        unordered_map<const Node*, Connections> m_connections;
+        unordered_set<const Node*> m_rewritten_roots;
+    };
+
+    // A node that was replaced earlier in the same iteration is no longer reachable from the
+    // function's results and cannot be replaced again.
+    bool is_unreachable(const Node& node)
+    {
+        return node.get_users().empty() && node.get_control_dependents().empty() &&
+               !node.is_output() && !node.is_parameter();
+    }
+}
+
 // GraphRewrite algorithm:
 // GraphRewrite processes an input graph in an topological order(i.e. args before users)
 // Given the following graph:          Abs2
@@ -60,6 +236,14 @@ using namespace ngraph;
 // c) there's no linear order of fusions which will give
 //    the correct final fusion. i.e. the same fusion needs to occur before and after some other
 //    fusion
+// When every matcher registered for another pass also ran in the previous one, the next pass
+// only visits the nodes that pass added or rewired and the nodes downstream of them, since the
+// match of a pattern only depends on the nodes above its root. Matchers are compared by
+// identity, so only a callback that registers the same Matcher object again gets an incremental
+// pass; a freshly constructed matcher makes the next pass visit every node.
+//
+// Each node is only tried with the matchers whose pattern root has its type, see
+// MatcherDispatch, in the order they were registered.
 
 bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
 {
@@ -71,6 +255,11 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
     // it behind an environment variable for now. TODO: Find a less expensive way to handle this.
     static bool s_rerun_dynamic_check = getenv_bool("NGRAPH_GRAPH_REWRITE_RERUN_DYNAMIC_CHECK");
     bool is_dyn_func = s_rerun_dynamic_check && f->is_dynamic();
+    PassProfile* profile = get_pass_profile();
+    MatcherProfiler matcher_profiler;
+
+    list<shared_ptr<Node>> nodes = f->get_ordered_ops();
+    list<shared_ptr<Node>> worklist = nodes;
     do
     {
         rewritten = false;
@@ -78,14 +267,30 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
         // that need multiple passes. See comments above.
         vector<MatchClosure> matchers_to_run{m_matchers};
         m_matchers.clear();
-        for (auto node : f->get_ordered_ops())
+
+        vector<const Node::type_info_t*> root_types;
+        for (auto& closure : matchers_to_run)
         {
+            Node* root = closure.matcher->get_pattern_value().get_node();
+            bool matches_any_node = (dynamic_cast<pattern::op::Pattern*>(root) != nullptr);
+            root_types.push_back(matches_any_node ? nullptr : &root->get_type_info());
+        }
+        MatcherDispatch dispatch(root_types);
+        ConnectionSnapshot snapshot;
+
+        for (auto& node : worklist)
+        {
+            if (rewritten && is_unreachable(*node))
+            {
+                continue;
+            }
             if (m_enable_shape_inference)
             {
                 node->revalidate_and_infer_types();
             }
-            for (auto& closure : matchers_to_run)
+            for (size_t matcher_index : dispatch.get_matchers(*node))
             {
+                auto& closure = matchers_to_run[matcher_index];
                 if (is_dyn_func && closure.property[PassProperty::REQUIRE_STATIC_SHAPE])
                 {
                     NGRAPH_DEBUG << "matcher callback requires static shape but the "
@@ -97,13 +302,29 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
                 NGRAPH_DEBUG << "Running matcher " << closure.matcher->get_name() << "("
                              << closure.matcher->get_pattern()->get_name() << ") on "
                              << node->get_name();
+                PassProfile::MatcherRecord* record =
+                    profile ? &matcher_profiler.get_record(closure.matcher->get_name()) : nullptr;
+                MatcherTimer timer(record);
                 if (closure.matcher->match(node))
                 {
                     NGRAPH_DEBUG << "Matcher " << closure.matcher << closure.matcher->get_name()
                                  << " matched " << node->get_name();
+                    if (record)
+                    {
+                        record->matches++;
+                    }
+                    if (!snapshot.is_taken())
+                    {
+                        snapshot.take(nodes);
+                    }
                     if (closure.callback(*closure.matcher.get()))
                     {
+                        if (record)
+                        {
+                            record->rewrites++;
+                        }
                         rewritten = true;
+                        snapshot.add_rewritten_root(node.get());
                         // If call back may change function's is_dynamic state, we need to
                         // update the cached value.
                         if (closure.property.is_set(PassProperty::CHANGE_DYNAMIC_STATE))
@@ -116,9 +337,31 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
             }
         }
 
+        if (rewritten && m_matchers.size() > 0 && tries > 0)
+        {
+            bool incremental = true;
+            for (auto& closure : m_matchers)
+            {
+                incremental = incremental &&
+                              any_of(matchers_to_run.begin(),
+                                     matchers_to_run.end(),
+                                     [&closure](const MatchClosure& previous) {
+                                         return previous.matcher == closure.matcher;
+                                     });
+            }
+            // Nodes replaced in this pass are released here, before the comparison, so their
+            // addresses cannot be reused by new nodes.
+            worklist.clear();
+            nodes = f->get_ordered_ops();
+            worklist = incremental ? snapshot.get_changed_cone(nodes) : nodes;
+        }
     } while (rewritten && m_matchers.size() > 0 && tries--);
 
     m_matchers.assign(original_matchers.begin(), original_matchers.end());
+    if (profile)
+    {
+        matcher_profiler.write_to(*profile);
+    }
     return (NUM_TRIES - tries) > 1; // this means a graph was transformed
 }
 
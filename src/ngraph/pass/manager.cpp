@@ -19,9 +19,11 @@
 #else
 #include <cxxabi.h>
 #endif
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
 
 #include "ngraph/env_util.hpp"
 #include "ngraph/function.hpp"
@@ -31,6 +33,7 @@
 #include "ngraph/pass/pass.hpp"
 #include "ngraph/pass/serialize.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
@@ -39,7 +42,7 @@ using namespace ngraph;
 pass::Manager::Manager()
     : m_visualize(getenv_bool("NGRAPH_ENABLE_VISUALIZE_TRACING"))
     , m_serialize(getenv_bool("NGRAPH_ENABLE_SERIALIZE_TRACING"))
-
+    , m_profile_passes(getenv_bool("NGRAPH_PROFILE_PASS_ENABLE"))
 {
 }
 
@@ -47,11 +50,30 @@ pass::Manager::~Manager()
 {
 }
 
+static string get_pass_name(const pass::PassBase& pass)
+{
+    string name = typeid(pass).name();
+#ifndef _WIN32
+    int status;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (demangled)
+    {
+        name = demangled;
+        free(demangled);
+    }
+#endif
+    return name;
+}
+
 void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
 {
     static bool profile_enabled = getenv_bool("NGRAPH_PROFILE_PASS_ENABLE");
+    bool tracing_enabled = runtime::event::Manager::is_tracing_enabled();
 
     get_state().set_function(func);
+    // The profile describes the most recent run only, so repeated runs do not accumulate records
+    m_pass_profile.clear();
+    get_state().set_pass_profile(m_profile_passes ? &m_pass_profile : nullptr);
     vector<std::pair<shared_ptr<Function>, bool>> fs{std::make_pair(func, func->is_dynamic())};
     vector<shared_ptr<Function>> f_array{func};
 
@@ -61,6 +83,16 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
     overall_timer.start();
     for (shared_ptr<PassBase> pass : m_pass_list)
     {
+        string pass_name;
+        if (m_profile_passes || profile_enabled || tracing_enabled)
+        {
+            pass_name = get_pass_name(*pass);
+        }
+        runtime::event::Duration pass_event(pass_name, "Pass");
+        if (m_profile_passes)
+        {
+            m_pass_profile.begin_pass(pass_name, func->get_ops().size());
+        }
         pass_timer.start();
         pass->set_state(get_state());
         auto module_pass = dynamic_pointer_cast<ModulePass>(pass);
@@ -154,17 +186,22 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
         }
         index++;
         pass_timer.stop();
+        if (m_profile_passes)
+        {
+            m_pass_profile.end_pass(func->get_ops().size());
+            if (tracing_enabled)
+            {
+                stringstream args;
+                PassProfile::write_json_counters(args, m_pass_profile.get_records().back());
+                pass_event.set_args(args.str());
+            }
+        }
         if (profile_enabled)
         {
-            PassBase* p = pass.get();
-            string name = typeid(*p).name();
-#ifndef _WIN32
-            int status;
-            name = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
-#endif
-            cout << setw(7) << pass_timer.get_milliseconds() << "ms " << name << "\n";
+            cout << setw(7) << pass_timer.get_milliseconds() << "ms " << pass_name << "\n";
         }
     }
+    get_state().set_pass_profile(nullptr);
     if (profile_enabled)
     {
         cout << "passes done in " << overall_timer.get_milliseconds() << "ms\n";
@@ -24,6 +24,7 @@
 #include "ngraph/pass/manager_state.hpp"
 #include "ngraph/pass/pass.hpp"
 #include "ngraph/pass/pass_config.hpp"
+#include "ngraph/pass/pass_profile.hpp"
 #include "ngraph/pass/validate.hpp"
 
 namespace ngraph
@@ -60,6 +61,13 @@ public:
     void set_pass_visualization(bool new_state) { m_visualize = new_state; }
     void set_pass_serialization(bool new_state) { m_serialize = new_state; }
     void set_per_pass_validation(bool new_state) { m_per_pass_validation = new_state; }
+    /// \brief Record per-pass statistics in get_pass_profile(). Also enabled by
+    ///        NGRAPH_PROFILE_PASS_ENABLE. When event tracing is enabled the statistics are
+    ///        attached to each pass's trace event. Each run_passes call replaces the statistics
+    ///        of the previous one.
+    void set_pass_profiling(bool new_state) { m_profile_passes = new_state; }
+    const PassProfile& get_pass_profile() const { return m_pass_profile; }
+    PassProfile& get_pass_profile() { return m_pass_profile; }
 private:
     template <typename T, class... Args>
     std::shared_ptr<T> push_pass(Args&&... args)
@@ -91,4 +99,6 @@ private:
     bool m_visualize = false;
     bool m_serialize = false;
     bool m_per_pass_validation = true;
+    bool m_profile_passes;
+    PassProfile m_pass_profile;
 };
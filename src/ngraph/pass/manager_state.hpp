@@ -36,6 +36,7 @@ namespace ngraph
     namespace pass
     {
         class ManagerState;
+        class PassProfile;
     }
 }
 
@@ -60,7 +61,11 @@ public:
         return {m_function};
     }
 
+    /// \brief The profile passes add their statistics to, nullptr when profiling is disabled
+    PassProfile* get_pass_profile() const { return m_pass_profile; }
+    void set_pass_profile(PassProfile* pass_profile) { m_pass_profile = pass_profile; }
 private:
     visualize_tree_ops_map_t m_visualize_tree_ops_map;
     std::shared_ptr<Function> m_function;
+    PassProfile* m_pass_profile{nullptr};
 };
@@ -35,6 +35,7 @@ namespace ngraph
         class NodePass;
         class CallGraphPass;
         class Manager;
+        class PassProfile;
         enum class FusionType : uint32_t
         {
             //`DIFFERENTIABLE_FUSIONS` produce ops that support autodiff
@@ -82,6 +83,9 @@ public:
 protected:
     ManagerState& get_state();
     void set_state(ManagerState&);
+    /// \brief The profile of the running Manager, nullptr if profiling is disabled or the pass
+    ///        is run outside of a Manager
+    PassProfile* get_pass_profile() const;
     void set_property(const PassPropertyMask& prop, bool value);
 
 private:
@@ -0,0 +1,117 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "ngraph/check.hpp"
+#include "ngraph/pass/pass_profile.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+void pass::PassProfile::begin_pass(const string& name, size_t node_count)
+{
+    PassRecord record;
+    record.name = name;
+    record.nodes_before = node_count;
+    m_records.push_back(record);
+    m_pass_start_peak_rss = get_peak_rss();
+    m_pass_start = chrono::steady_clock::now();
+}
+
+void pass::PassProfile::end_pass(size_t node_count)
+{
+    NGRAPH_CHECK(!m_records.empty(), "end_pass called without begin_pass");
+    PassRecord& record = m_records.back();
+    record.time = chrono::steady_clock::now() - m_pass_start;
+    record.nodes_after = node_count;
+    record.peak_rss_delta = get_peak_rss() - m_pass_start_peak_rss;
+}
+
+void pass::PassProfile::add_matcher_record(const MatcherRecord& matcher_record)
+{
+    NGRAPH_CHECK(!m_records.empty(), "add_matcher_record called outside of a pass");
+    PassRecord& record = m_records.back();
+    record.rewrites += matcher_record.rewrites;
+    record.matchers.push_back(matcher_record);
+}
+
+static void write_json_string(ostream& out, const string& s)
+{
+    string escaped;
+    append_json_escaped(escaped, s.data(), s.size());
+    out << '"' << escaped << '"';
+}
+
+static int64_t to_microseconds(chrono::nanoseconds time)
+{
+    return chrono::duration_cast<chrono::microseconds>(time).count();
+}
+
+void pass::PassProfile::write_json_counters(ostream& out, const PassRecord& record)
+{
+    out << "{\"nodes_before\":" << record.nodes_before << ",\"nodes_after\":"
+        << record.nodes_after << ",\"rewrites\":" << record.rewrites
+        << ",\"peak_rss_delta\":" << record.peak_rss_delta << "}";
+}
+
+void pass::PassProfile::write_json(ostream& out) const
+{
+    out << "{\"passes\":[";
+    for (size_t i = 0; i < m_records.size(); i++)
+    {
+        const PassRecord& record = m_records[i];
+        out << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+        write_json_string(out, record.name);
+        out << ",\"time_us\":" << to_microseconds(record.time)
+            << ",\"nodes_before\":" << record.nodes_before
+            << ",\"nodes_after\":" << record.nodes_after << ",\"rewrites\":" << record.rewrites
+            << ",\"peak_rss_delta\":" << record.peak_rss_delta << ",\"matchers\":[";
+        for (size_t j = 0; j < record.matchers.size(); j++)
+        {
+            const MatcherRecord& matcher = record.matchers[j];
+            out << (j == 0 ? "" : ",") << "{\"name\":";
+            write_json_string(out, matcher.name);
+            out << ",\"time_us\":" << to_microseconds(matcher.time)
+                << ",\"attempts\":" << matcher.attempts << ",\"matches\":" << matcher.matches
+                << ",\"rewrites\":" << matcher.rewrites << "}";
+        }
+        out << "]}";
+    }
+    out << "\n]}\n";
+}
+
+size_t pass::PassProfile::get_peak_rss()
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    // ru_maxrss is in bytes on macOS and in kilobytes on Linux
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
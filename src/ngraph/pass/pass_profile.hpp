@@ -0,0 +1,86 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ngraph/ngraph_visibility.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class PassProfile;
+    }
+}
+
+/// \brief Compile-time statistics collected by pass::Manager when pass profiling is enabled.
+///
+/// One record is kept for every pass run: its wall time, the number of nodes in the function
+/// before and after it, the number of graph rewrites it made and how much it grew the peak
+/// resident set size of the process. GraphRewrite passes also record, for each matcher, how
+/// often it was tried, matched and rewrote the graph, and the time spent in it.
+class NGRAPH_API ngraph::pass::PassProfile
+{
+public:
+    struct MatcherRecord
+    {
+        std::string name;
+        size_t attempts = 0;
+        size_t matches = 0;
+        size_t rewrites = 0;
+        std::chrono::nanoseconds time{0};
+    };
+
+    struct PassRecord
+    {
+        std::string name;
+        std::chrono::nanoseconds time{0};
+        size_t nodes_before = 0;
+        size_t nodes_after = 0;
+        /// \brief Matcher callbacks that rewrote the graph; only counted for GraphRewrite passes
+        size_t rewrites = 0;
+        /// \brief Growth of the peak resident set size in bytes while the pass ran
+        size_t peak_rss_delta = 0;
+        std::vector<MatcherRecord> matchers;
+    };
+
+    /// \brief Start the record of a pass about to run on a function of node_count nodes
+    void begin_pass(const std::string& name, size_t node_count);
+    /// \brief Finish the current record once the function has node_count nodes
+    void end_pass(size_t node_count);
+    /// \brief Attach matcher statistics to the current record
+    void add_matcher_record(const MatcherRecord& record);
+
+    const std::vector<PassRecord>& get_records() const { return m_records; }
+    void clear() { m_records.clear(); }
+    /// \brief Write all records as a JSON object with a "passes" array
+    void write_json(std::ostream& out) const;
+    /// \brief Write the counters of a record as a JSON object, as used for trace event args
+    static void write_json_counters(std::ostream& out, const PassRecord& record);
+
+    /// \brief Peak resident set size of this process in bytes, 0 where it is not available
+    static size_t get_peak_rss();
+
+private:
+    std::vector<PassRecord> m_records;
+    std::chrono::steady_clock::time_point m_pass_start;
+    size_t m_pass_start_peak_rss = 0;
+};
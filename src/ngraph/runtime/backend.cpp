@@ -23,6 +23,7 @@
 #include <sstream>
 
 #include "ngraph/file_util.hpp"
+#include "ngraph/log.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/runtime/dynamic/dynamic_backend.hpp"
@@ -173,3 +174,28 @@ bool runtime::Backend::executable_can_create_tensors()
     remove_compiled_function(exec);
     return exec_can_create_tensors;
 }
+
+void runtime::Backend::set_persistent_cache(const shared_ptr<PersistentCache>& cache)
+{
+    lock_guard<mutex> lock(m_persistent_cache_mutex);
+    m_persistent_cache = cache;
+    m_persistent_cache_initialized = true;
+}
+
+shared_ptr<runtime::PersistentCache> runtime::Backend::get_persistent_cache()
+{
+    lock_guard<mutex> lock(m_persistent_cache_mutex);
+    if (!m_persistent_cache_initialized)
+    {
+        m_persistent_cache_initialized = true;
+        try
+        {
+            m_persistent_cache = PersistentCache::create_default();
+        }
+        catch (const exception& e)
+        {
+            NGRAPH_WARN << "Compiling without the compilation cache: " << e.what();
+        }
+    }
+    return m_persistent_cache;
+}
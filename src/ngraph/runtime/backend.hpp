@@ -24,6 +24,7 @@
 #include "ngraph/runtime/allocator.hpp"
 #include "ngraph/runtime/executable.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
+#include "ngraph/runtime/persistent_cache.hpp"
 #include "ngraph/shape.hpp"
 #include "ngraph/type/element_type.hpp"
 #include "ngraph/util.hpp"
@@ -178,8 +179,24 @@ public:
     /// \brief Get the version of the backend
     /// The default value of 0.0.0 is chosen to be a parsable version number
     virtual std::string get_version() const { return "0.0.0"; }
+    /// \brief Set the cache through which backends that support it reuse executables compiled
+    ///        by other processes
+    /// \param cache The cache, or nullptr to disable it. By default the cache in
+    ///        NGRAPH_COMPILATION_CACHE_DIR is used if that variable is set.
+    void set_persistent_cache(const std::shared_ptr<PersistentCache>& cache);
+    /// \brief The cache set with set_persistent_cache, otherwise the default cache, which is
+    ///        created on first use. nullptr if caching is disabled.
+    ///
+    /// Only backends whose load restores an executable without compiling it again should use
+    /// the cache, since otherwise a hit costs as much as a miss.
+    std::shared_ptr<PersistentCache> get_persistent_cache();
+
 private:
     // mutex to modify s_backend_shared_library_search_directory thread safe
     static std::mutex m_mtx;
     static std::string s_backend_shared_library_search_directory;
+
+    std::mutex m_persistent_cache_mutex;
+    std::shared_ptr<PersistentCache> m_persistent_cache;
+    bool m_persistent_cache_initialized = false;
 };
@@ -0,0 +1,358 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <iterator>
+
+#include "ngraph/check.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/op/result.hpp"
+#include "ngraph/runtime/batching_executable.hpp"
+#include "ngraph/runtime/tensor.hpp"
+#include "ngraph/specialize_function.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Shape of one sample of a tensor with the batch on axis 0
+static Shape get_sample_shape(const Shape& shape)
+{
+    Shape sample_shape = shape;
+    sample_shape[0] = 1;
+    return sample_shape;
+}
+
+runtime::BatchingExecutable::BatchingExecutable(
+    const shared_ptr<Backend>& backend,
+    const map<size_t, shared_ptr<Executable>>& executables,
+    chrono::microseconds max_delay,
+    size_t pipeline_depth)
+    : m_executables(executables)
+    , m_max_delay(max_delay)
+{
+    NGRAPH_CHECK(!m_executables.empty(), "No executables to batch calls with");
+    NGRAPH_CHECK(m_executables.begin()->first > 0, "Batch sizes must be positive");
+    NGRAPH_CHECK(pipeline_depth > 0, "Pipeline depth must be positive");
+    m_max_batch_size = m_executables.rbegin()->first;
+
+    // The parameters and results of a single sample
+    const auto& largest = m_executables.rbegin()->second;
+    ParameterVector parameters;
+    for (auto& parameter : largest->get_parameters())
+    {
+        NGRAPH_CHECK(parameter->get_output_shape(0).size() > 0,
+                     "Parameters must have a batch axis");
+        Shape shape = get_sample_shape(parameter->get_output_shape(0));
+        parameters.push_back(make_shared<op::Parameter>(parameter->get_element_type(), shape));
+        m_input_sample_bytes.push_back(shape_size(shape) * parameter->get_element_type().size());
+    }
+    ResultVector results;
+    for (auto& result : largest->get_results())
+    {
+        NGRAPH_CHECK(result->get_output_shape(0).size() > 0, "Results must have a batch axis");
+        Shape shape = get_sample_shape(result->get_output_shape(0));
+        results.push_back(make_shared<op::Result>(
+            make_shared<op::Parameter>(result->get_element_type(), shape)));
+        m_output_sample_bytes.push_back(shape_size(shape) * result->get_element_type().size());
+    }
+    set_parameters(parameters);
+    set_results(results);
+
+    for (auto& entry : m_executables)
+    {
+        size_t batch_size = entry.first;
+        const auto& executable = entry.second;
+        NGRAPH_CHECK(executable->get_parameters().size() == parameters.size() &&
+                         executable->get_results().size() == results.size(),
+                     "Executable for batch size ",
+                     batch_size,
+                     " has a different signature");
+        for (size_t i = 0; i < parameters.size(); i++)
+        {
+            const Shape& shape = executable->get_parameters()[i]->get_output_shape(0);
+            NGRAPH_CHECK(shape.size() > 0 && shape[0] == batch_size &&
+                             get_sample_shape(shape) == parameters[i]->get_output_shape(0),
+                         "Parameter ",
+                         i,
+                         " of the executable for batch size ",
+                         batch_size,
+                         " has shape ",
+                         shape);
+        }
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Shape& shape = executable->get_results()[i]->get_output_shape(0);
+            NGRAPH_CHECK(shape.size() > 0 && shape[0] == batch_size &&
+                             get_sample_shape(shape) == results[i]->get_output_shape(0),
+                         "Result ",
+                         i,
+                         " of the executable for batch size ",
+                         batch_size,
+                         " has shape ",
+                         shape);
+        }
+    }
+
+    m_stages.resize(pipeline_depth);
+    for (auto& stage : m_stages)
+    {
+        for (size_t bytes : m_input_sample_bytes)
+        {
+            stage.input_buffers.emplace_back(
+                new AlignedBuffer(bytes * m_max_batch_size));
+        }
+        for (size_t bytes : m_output_sample_bytes)
+        {
+            stage.output_buffers.emplace_back(
+                new AlignedBuffer(bytes * m_max_batch_size));
+        }
+        // The tensors for smaller batch sizes use the start of the buffers
+        for (auto& entry : m_executables)
+        {
+            const auto& executable = entry.second;
+            auto& inputs = stage.inputs[entry.first];
+            for (size_t i = 0; i < parameters.size(); i++)
+            {
+                const auto& parameter = executable->get_parameters()[i];
+                inputs.push_back(backend->create_tensor(parameter->get_element_type(),
+                                                        parameter->get_output_shape(0),
+                                                        stage.input_buffers[i]->get_ptr()));
+            }
+            auto& outputs = stage.outputs[entry.first];
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                const auto& result = executable->get_results()[i];
+                outputs.push_back(backend->create_tensor(result->get_element_type(),
+                                                         result->get_output_shape(0),
+                                                         stage.output_buffers[i]->get_ptr()));
+            }
+        }
+    }
+
+    m_dispatcher = thread([this]() { run_dispatcher(); });
+}
+
+runtime::BatchingExecutable::~BatchingExecutable()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    // The dispatcher runs the queued calls before it returns
+    m_dispatcher.join();
+    // Wait for the batches in flight
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() {
+        return none_of(
+            m_stages.begin(), m_stages.end(), [](const Stage& stage) { return stage.busy; });
+    });
+}
+
+shared_ptr<Function>
+    runtime::BatchingExecutable::specialize_batch(const shared_ptr<Function>& function,
+                                                  size_t batch_size)
+{
+    vector<element::Type> element_types;
+    vector<PartialShape> shapes;
+    vector<void*> values;
+    for (auto& parameter : function->get_parameters())
+    {
+        PartialShape shape = parameter->get_output_partial_shape(0);
+        NGRAPH_CHECK(shape.rank().is_static() && static_cast<size_t>(shape.rank()) > 0,
+                     "Parameters must have a batch axis");
+        shape[0] = batch_size;
+        element_types.push_back(parameter->get_element_type());
+        shapes.push_back(shape);
+        values.push_back(nullptr);
+    }
+    return specialize_function(function, element_types, shapes, values);
+}
+
+bool runtime::BatchingExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                       const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    return call_async(outputs, inputs).get();
+}
+
+void runtime::BatchingExecutable::call_async(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                             const vector<shared_ptr<runtime::Tensor>>& inputs,
+                                             const CallCallback& callback)
+{
+    const ParameterVector& parameters = get_parameters();
+    const ResultVector& results = get_results();
+    NGRAPH_CHECK(inputs.size() == parameters.size() && outputs.size() == results.size(),
+                 "Call has ",
+                 inputs.size(),
+                 " inputs and ",
+                 outputs.size(),
+                 " outputs, expected ",
+                 parameters.size(),
+                 " and ",
+                 results.size());
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        NGRAPH_CHECK(inputs[i]->get_element_type() == parameters[i]->get_element_type() &&
+                         inputs[i]->get_shape() == parameters[i]->get_output_shape(0),
+                     "Input ",
+                     i,
+                     " must have type ",
+                     parameters[i]->get_element_type(),
+                     " and shape ",
+                     parameters[i]->get_output_shape(0));
+    }
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        NGRAPH_CHECK(outputs[i]->get_element_type() == results[i]->get_element_type() &&
+                         outputs[i]->get_shape() == results[i]->get_output_shape(0),
+                     "Output ",
+                     i,
+                     " must have type ",
+                     results[i]->get_element_type(),
+                     " and shape ",
+                     results[i]->get_output_shape(0));
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_requests.push_back(Request{outputs, inputs, callback, chrono::steady_clock::now()});
+    }
+    m_calls++;
+    m_cv.notify_all();
+}
+
+void runtime::BatchingExecutable::flush()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_flush_requests = m_requests.size();
+    }
+    m_cv.notify_all();
+}
+
+runtime::BatchingExecutable::Statistics runtime::BatchingExecutable::get_statistics() const
+{
+    return Statistics{m_calls, m_batches};
+}
+
+runtime::BatchingExecutable::Stage* runtime::BatchingExecutable::get_free_stage()
+{
+    for (auto& stage : m_stages)
+    {
+        if (!stage.busy)
+        {
+            return &stage;
+        }
+    }
+    return nullptr;
+}
+
+void runtime::BatchingExecutable::run_dispatcher()
+{
+    unique_lock<mutex> lock(m_mutex);
+    while (true)
+    {
+        m_cv.wait(lock, [this]() { return m_stop || !m_requests.empty(); });
+        if (m_requests.empty())
+        {
+            return;
+        }
+        Stage* stage = nullptr;
+        m_cv.wait(lock, [this, &stage]() { return (stage = get_free_stage()) != nullptr; });
+        // Collect more calls until the batch is full, the oldest call is due or it is flushed
+        auto deadline = m_requests.front().arrival + m_max_delay;
+        m_cv.wait_until(lock, deadline, [this]() {
+            return m_stop || m_requests.size() >= m_max_batch_size || m_flush_requests > 0;
+        });
+
+        size_t count = min(m_requests.size(), m_max_batch_size);
+        m_flush_requests -= min(m_flush_requests, count);
+        vector<Request> requests(make_move_iterator(m_requests.begin()),
+                                 make_move_iterator(m_requests.begin() + count));
+        m_requests.erase(m_requests.begin(), m_requests.begin() + count);
+        stage->busy = true;
+
+        lock.unlock();
+        run_batch(*stage, move(requests));
+        lock.lock();
+    }
+}
+
+void runtime::BatchingExecutable::run_batch(Stage& stage, vector<Request> requests)
+{
+    auto batch = make_shared<vector<Request>>(move(requests));
+    size_t batch_size = m_executables.lower_bound(batch->size())->first;
+    try
+    {
+        for (size_t i = 0; i < m_input_sample_bytes.size(); i++)
+        {
+            size_t bytes = m_input_sample_bytes[i];
+            auto data = static_cast<char*>(stage.input_buffers[i]->get_ptr());
+            for (size_t row = 0; row < batch->size(); row++)
+            {
+                (*batch)[row].inputs[i]->read(data + row * bytes, bytes);
+            }
+        }
+        m_batches++;
+        m_executables.at(batch_size)
+            ->call_async(stage.outputs.at(batch_size),
+                         stage.inputs.at(batch_size),
+                         [this, &stage, batch](bool result, exception_ptr error) {
+                             finish_batch(stage, *batch, result, error);
+                         });
+    }
+    catch (...)
+    {
+        finish_batch(stage, *batch, false, current_exception());
+    }
+}
+
+void runtime::BatchingExecutable::finish_batch(Stage& stage,
+                                               const vector<Request>& requests,
+                                               bool result,
+                                               exception_ptr error)
+{
+    if (!error)
+    {
+        try
+        {
+            for (size_t i = 0; i < m_output_sample_bytes.size(); i++)
+            {
+                size_t bytes = m_output_sample_bytes[i];
+                auto data = static_cast<const char*>(stage.output_buffers[i]->get_ptr());
+                for (size_t row = 0; row < requests.size(); row++)
+                {
+                    requests[row].outputs[i]->write(data + row * bytes, bytes);
+                }
+            }
+        }
+        catch (...)
+        {
+            error = current_exception();
+        }
+    }
+    {
+        // Notify under the lock, since the destructor may return as soon as it is released
+        lock_guard<mutex> lock(m_mutex);
+        stage.busy = false;
+        m_cv.notify_all();
+    }
+    // This object may be gone now, so only the requests are used
+    for (auto& request : requests)
+    {
+        request.callback(error ? false : result, error);
+    }
+}
@@ -0,0 +1,143 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ngraph/function.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/executable.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class BatchingExecutable;
+    }
+}
+
+/// \brief Executable that serves single-sample calls by running them in batches.
+///
+/// Concurrent calls are queued. A dispatcher thread waits until either as many calls as the
+/// largest batch size are queued, the oldest call has waited for max_delay, or flush is called.
+/// It then copies the inputs of the queued calls into consecutive rows along axis 0 of a host
+/// buffer, runs the executable for the smallest batch size that holds them asynchronously, and
+/// copies each row of the outputs back to its call. Rows beyond the number of calls hold stale
+/// data, so this is only correct for functions where rows do not affect each other, as is usual
+/// for the batch axis of inference graphs.
+///
+/// Each of the pipeline_depth stages has its own host buffers, so the next batch is gathered
+/// while the previous ones run.
+class NGRAPH_API ngraph::runtime::BatchingExecutable : public ngraph::runtime::Executable
+{
+public:
+    struct Statistics
+    {
+        size_t calls;
+        size_t batches;
+    };
+
+    /// \param backend Backend the executables were compiled on, used to create the tensors
+    ///        that wrap the host buffers
+    /// \param executables Executable for each batch size. All parameters and results must have
+    ///        static shapes with the batch size on axis 0 and otherwise equal shapes across
+    ///        batch sizes.
+    /// \param max_delay Longest time a call waits for other calls to batch with
+    /// \param pipeline_depth Number of batches that may be in flight at once
+    BatchingExecutable(const std::shared_ptr<Backend>& backend,
+                       const std::map<size_t, std::shared_ptr<Executable>>& executables,
+                       std::chrono::microseconds max_delay,
+                       size_t pipeline_depth = 2);
+    ~BatchingExecutable() override;
+
+    /// \brief Clone function with axis 0 of every parameter set to batch_size
+    ///
+    /// Axis 0 of the parameters of function must be dynamic or batch_size.
+    static std::shared_ptr<Function> specialize_batch(const std::shared_ptr<Function>& function,
+                                                      size_t batch_size);
+
+    /// \brief Run one sample. Inputs and outputs have size 1 on axis 0.
+    bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+              const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
+
+    using Executable::call_async;
+    /// \brief Queue one sample. Inputs and outputs have size 1 on axis 0. The callback is
+    ///        invoked on the thread that ran the batch.
+    void call_async(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                    const CallCallback& callback) override;
+
+    /// \brief Run the calls queued so far without waiting for max_delay
+    void flush();
+
+    /// \brief Number of calls and of batches they ran in
+    Statistics get_statistics() const;
+
+private:
+    struct Request
+    {
+        std::vector<std::shared_ptr<runtime::Tensor>> outputs;
+        std::vector<std::shared_ptr<runtime::Tensor>> inputs;
+        CallCallback callback;
+        std::chrono::steady_clock::time_point arrival;
+    };
+
+    struct Stage
+    {
+        std::vector<std::unique_ptr<AlignedBuffer>> input_buffers;
+        std::vector<std::unique_ptr<AlignedBuffer>> output_buffers;
+        /// \brief Tensors over the buffers for each batch size
+        std::map<size_t, std::vector<std::shared_ptr<runtime::Tensor>>> inputs;
+        std::map<size_t, std::vector<std::shared_ptr<runtime::Tensor>>> outputs;
+        bool busy = false;
+    };
+
+    void run_dispatcher();
+    void run_batch(Stage& stage, std::vector<Request> requests);
+    void finish_batch(Stage& stage,
+                      const std::vector<Request>& requests,
+                      bool result,
+                      std::exception_ptr error);
+    Stage* get_free_stage();
+
+    std::map<size_t, std::shared_ptr<Executable>> m_executables;
+    std::chrono::microseconds m_max_delay;
+    size_t m_max_batch_size;
+    /// \brief Bytes of one sample of each parameter and result
+    std::vector<size_t> m_input_sample_bytes;
+    std::vector<size_t> m_output_sample_bytes;
+    std::vector<Stage> m_stages;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Request> m_requests;
+    /// \brief Number of queued calls to run without waiting for max_delay
+    size_t m_flush_requests = 0;
+    bool m_stop = false;
+    std::atomic<size_t> m_calls{0};
+    std::atomic<size_t> m_batches{0};
+    std::thread m_dispatcher;
+};
@@ -14,117 +14,180 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+
+#include "ngraph/env_util.hpp"
+#include "ngraph/op/constant.hpp"
 #include "ngraph/runtime/cache.hpp"
+#include "ngraph/util.hpp"
 
 using namespace ngraph;
 using namespace std;
 
-// Constructor
-runtime::LRUCache::LRUCache()
+size_t runtime::CacheKeyHash::operator()(const CacheKey& key) const
 {
-    char* cache_size = getenv("NGRAPH_CACHE_SIZE");
-    if (cache_size == nullptr)
+    FNV1aHash hash;
+    for (int64_t value : key)
     {
-        m_cache_size = 1024; // TODO(nbpatel): Figure out a default size for the cache
+        hash.add(static_cast<uint64_t>(value));
     }
-    else
+    return static_cast<size_t>(hash.get());
+}
+
+runtime::LRUCache::LRUCache()
+    : LRUCache(getenv_size("NGRAPH_CACHE_SIZE", 1024), getenv_size("NGRAPH_CACHE_BYTES", 0))
+{
+}
+
+runtime::LRUCache::LRUCache(size_t max_entries, size_t max_bytes, size_t shard_count)
+    : m_max_entries(max<size_t>(1, max_entries))
+    , m_max_bytes(max_bytes)
+{
+    shard_count = max<size_t>(1, shard_count);
+    for (size_t i = 0; i < shard_count; ++i)
     {
-        m_cache_size = atoi(cache_size);
+        m_shards.emplace_back(new Shard());
     }
-
-    m_map = {};
-    m_list = {};
 }
 
-// Destructor
 runtime::LRUCache::~LRUCache()
 {
-    m_list.clear();
-    m_map.clear();
-    m_clone_function_map.clear();
 }
 
-void runtime::LRUCache::convert_shape_to_string(const vector<int>& shape, ostringstream& key)
+runtime::LRUCache::Shard& runtime::LRUCache::get_shard(const CacheKey& key)
 {
-    if (!shape.empty())
-    {
-        std::copy(shape.begin(), shape.end(), std::ostream_iterator<int>(key, ", "));
-    }
+    return *m_shards[CacheKeyHash()(key) % m_shards.size()];
 }
 
-void runtime::LRUCache::add_entry(const vector<int>& shape,
+void runtime::LRUCache::add_entry(const CacheKey& key,
                                   shared_ptr<runtime::Executable> exec,
                                   shared_ptr<Function> func)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    ostringstream key;
-    // check if the list is empty
-    if (m_list.size() == m_cache_size)
+    Entry entry{exec, func, estimate_footprint(*func)};
+    if (m_max_bytes != 0 && entry.bytes > m_max_bytes)
     {
-        ostringstream key;
-        convert_shape_to_string(m_list.back(), key);
-        m_list.pop_back();
-        m_map.erase(key.str());
+        // Caching it would evict everything else and still exceed the budget
+        return;
+    }
+
+    {
+        Shard& shard = get_shard(key);
+        lock_guard<mutex> guard(shard.mutex);
+        if (shard.map.find(key) != shard.map.end())
+        {
+            // Another caller compiled the same key first, keep theirs
+            return;
+        }
+        shard.lru.push_front(key);
+        shard.map.insert({key, {entry, shard.lru.begin(), m_clock++}});
+        shard.bytes += entry.bytes;
+        m_entries++;
+        m_bytes += entry.bytes;
     }
 
-    convert_shape_to_string(shape, key);
-    m_map.insert({key.str(), exec});
-    m_list.push_front(shape);
-    m_clone_function_map.insert({key.str(), func});
+    // Shards are only locked one at a time below, so concurrent callers cannot deadlock. They
+    // may each evict an entry for the same overrun, which only frees more than needed.
+    while (m_entries > m_max_entries || (m_max_bytes != 0 && m_bytes > m_max_bytes))
+    {
+        if (!evict_one(key))
+        {
+            break;
+        }
+    }
 }
 
-bool runtime::LRUCache::is_cached(const vector<int>& shape)
+bool runtime::LRUCache::evict_one(const CacheKey& keep)
 {
-    for (auto itr = m_list.begin(); itr != m_list.end(); itr++)
+    // The back of each shard's list is that shard's least recently used entry, so the oldest
+    // of those is the least recently used entry of the whole cache.
+    Shard* oldest_shard = nullptr;
+    uint64_t oldest_use = 0;
+    for (auto& shard : m_shards)
     {
-        if (*itr == shape)
+        lock_guard<mutex> guard(shard->mutex);
+        if (shard->lru.empty() || shard->lru.back() == keep)
         {
-            return true;
+            continue;
         }
+        uint64_t last_use = shard->map.at(shard->lru.back()).last_use;
+        if (oldest_shard == nullptr || last_use < oldest_use)
+        {
+            oldest_shard = shard.get();
+            oldest_use = last_use;
+        }
+    }
+    if (oldest_shard == nullptr)
+    {
+        return false;
+    }
+
+    lock_guard<mutex> guard(oldest_shard->mutex);
+    if (oldest_shard->lru.empty() ||
+        oldest_shard->map.at(oldest_shard->lru.back()).last_use != oldest_use)
+    {
+        // Used or evicted since it was chosen, let the caller look again
+        return true;
     }
-    return false;
+    auto victim = oldest_shard->map.find(oldest_shard->lru.back());
+    oldest_shard->bytes -= victim->second.entry.bytes;
+    m_entries--;
+    m_bytes -= victim->second.entry.bytes;
+    oldest_shard->map.erase(victim);
+    oldest_shard->lru.pop_back();
+    m_evictions++;
+    return true;
 }
 
-shared_ptr<runtime::Executable> runtime::LRUCache::get_cached_entry(const vector<int>& shape)
+bool runtime::LRUCache::get_entry(const CacheKey& key, Entry& entry)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    ostringstream key;
-    convert_shape_to_string(shape, key);
+    Shard& shard = get_shard(key);
+    lock_guard<mutex> guard(shard.mutex);
 
-    // find the entry and return the function
-    auto it = m_map.find(key.str());
-    if (it == m_map.end())
+    auto it = shard.map.find(key);
+    if (it == shard.map.end())
     {
-        throw ngraph_error("Entry not found in cache");
+        m_misses++;
+        return false;
     }
-    else
+    // move this entry to the front of the LRU list
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_position);
+    it->second.last_use = m_clock++;
+    entry = it->second.entry;
+    m_hits++;
+    return true;
+}
+
+runtime::LRUCache::Statistics runtime::LRUCache::get_statistics() const
+{
+    Statistics stats{m_hits, m_misses, m_evictions, 0, 0};
+    for (auto& shard : m_shards)
     {
-        // update list to push this reference to the front
-        for (auto itr = m_list.begin(); itr != m_list.end(); itr++)
-        {
-            if (*itr == shape)
-            {
-                m_list.remove(shape);
-                m_list.push_front(shape);
-                break;
-            }
-        }
-        return it->second;
+        lock_guard<mutex> guard(shard->mutex);
+        stats.entries += shard->map.size();
+        stats.bytes += shard->bytes;
     }
+    return stats;
 }
 
-// Need the clone function to get the output shape so that
-// storage can be allocated for output
-shared_ptr<Function> runtime::LRUCache::get_cloned_function(const vector<int>& shape)
+size_t runtime::LRUCache::estimate_footprint(const Function& func)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    ostringstream key;
-    convert_shape_to_string(shape, key);
-    // find the entry and return the function
-    auto it = m_clone_function_map.find(key.str());
-    if (it == m_clone_function_map.end())
+    size_t constant_bytes = 0;
+    size_t tensor_bytes = 0;
+    for (auto& node : func.get_ops())
     {
-        throw ngraph_error("Cloned function not found");
+        for (size_t i = 0; i < node->get_output_size(); ++i)
+        {
+            size_t bytes =
+                shape_size(node->get_output_shape(i)) * node->get_output_element_type(i).size();
+            if (node->is_constant())
+            {
+                constant_bytes += bytes;
+            }
+            else if (!node->is_parameter())
+            {
+                tensor_bytes += bytes;
+            }
+        }
     }
-    return it->second;
+    return 2 * constant_bytes + tensor_bytes;
 }
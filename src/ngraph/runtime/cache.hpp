@@ -16,14 +16,14 @@
 
 #pragma once
 
-#include <algorithm>
-#include <iostream>
-#include <iterator>
+#include <atomic>
+#include <cstdint>
 #include <list>
+#include <memory>
 #include <mutex>
-#include <sstream>
-#include <string>
 #include <unordered_map>
+#include <vector>
+
 #include "ngraph/function.hpp"
 #include "ngraph/runtime/executable.hpp"
 #include "ngraph/shape.hpp"
@@ -32,30 +32,102 @@ namespace ngraph
 {
     namespace runtime
     {
+        /// \brief Key identifying one specialization of a function, built from the function's
+        ///        identity and the element type and shape (or shape-relevant values) of every
+        ///        input.
+        using CacheKey = std::vector<int64_t>;
+
+        struct CacheKeyHash
+        {
+            size_t operator()(const CacheKey& key) const;
+        };
+
+        /// \brief Cache of compiled executables and the cloned functions they were compiled
+        ///        from.
+        ///
+        /// Entries are evicted in least-recently-used order when either the number of entries
+        /// exceeds NGRAPH_CACHE_SIZE or their estimated memory footprint exceeds
+        /// NGRAPH_CACHE_BYTES. An entry larger than NGRAPH_CACHE_BYTES on its own is not
+        /// cached. The cache is split into shards, each with its own lock and LRU list, so
+        /// concurrent lookups of different keys do not contend. Both limits apply to the cache
+        /// as a whole, and eviction takes the least recently used entry across all shards.
         class LRUCache : public std::enable_shared_from_this<LRUCache>
         {
         public:
-            using GraphCache = std::unordered_map<std::string, std::shared_ptr<Executable>>;
-            using ClonedFunctionMap = std::unordered_map<std::string, std::shared_ptr<Function>>;
+            struct Entry
+            {
+                std::shared_ptr<Executable> executable;
+                std::shared_ptr<Function> function;
+                size_t bytes;
+            };
+
+            struct Statistics
+            {
+                size_t hits;
+                size_t misses;
+                size_t evictions;
+                size_t entries;
+                size_t bytes;
+            };
 
+            /// \brief Construct a cache sized by NGRAPH_CACHE_SIZE (entries, default 1024) and
+            ///        NGRAPH_CACHE_BYTES (0, the default, means no byte limit).
             LRUCache();
 
+            /// \param max_entries Maximum number of cached entries
+            /// \param max_bytes Maximum estimated footprint of cached entries, 0 for no limit
+            /// \param shard_count Number of independently locked shards
+            LRUCache(size_t max_entries, size_t max_bytes, size_t shard_count = 16);
+
             virtual ~LRUCache();
 
-            void add_entry(const std::vector<int>& shape,
+            void add_entry(const CacheKey& key,
                            std::shared_ptr<Executable> exec,
                            std::shared_ptr<Function> func);
-            bool is_cached(const std::vector<int>& shape);
-            std::shared_ptr<Executable> get_cached_entry(const std::vector<int>& shape);
-            void convert_shape_to_string(const std::vector<int>& shape, std::ostringstream& key);
-            std::shared_ptr<Function> get_cloned_function(const std::vector<int>& shape);
+
+            /// \brief Look up key and mark it most recently used.
+            /// \returns true and fills entry on a hit, false on a miss
+            bool get_entry(const CacheKey& key, Entry& entry);
+
+            Statistics get_statistics() const;
+
+            /// \brief Estimated memory footprint of an executable compiled from func, counting
+            ///        the cloned function's constants, the executable's own copy of them and
+            ///        every intermediate tensor.
+            static size_t estimate_footprint(const Function& func);
 
         private:
-            int m_cache_size;
-            GraphCache m_map;
-            ClonedFunctionMap m_clone_function_map;
-            std::list<std::vector<int>> m_list;
-            std::mutex m_mutex;
+            struct Slot
+            {
+                Entry entry;
+                std::list<CacheKey>::iterator lru_position;
+                /// Value of m_clock when the entry was last used
+                uint64_t last_use;
+            };
+
+            struct Shard
+            {
+                std::mutex mutex;
+                std::list<CacheKey> lru;
+                std::unordered_map<CacheKey, Slot, CacheKeyHash> map;
+                size_t bytes = 0;
+            };
+
+            Shard& get_shard(const CacheKey& key);
+
+            /// \brief Evict the least recently used entry of all shards other than keep.
+            /// \returns false if there was no entry to evict
+            bool evict_one(const CacheKey& keep);
+
+            size_t m_max_entries;
+            size_t m_max_bytes;
+            std::vector<std::unique_ptr<Shard>> m_shards;
+            std::atomic<uint64_t> m_clock{0};
+            std::atomic<size_t> m_entries{0};
+            std::atomic<size_t> m_bytes{0};
+            std::atomic<size_t> m_hits{0};
+            std::atomic<size_t> m_misses{0};
+            std::atomic<size_t> m_evictions{0};
         };
     }
 }
@@ -14,14 +14,18 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "chrome_trace.hpp"
 #include "ngraph/env_util.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/util.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -56,35 +60,20 @@ void runtime::event::Duration::stop()
     }
 }
 
+void runtime::event::Duration::set_args(const string& args)
+{
+    if (Manager::is_tracing_enabled())
+    {
+        m_args = args;
+    }
+}
+
 void runtime::event::Duration::write()
 {
     if (Manager::is_tracing_enabled())
     {
         size_t stop_time = (m_stop != 0 ? m_stop : Manager::get_current_microseconds());
-
-        lock_guard<mutex> lock(Manager::get_mutex());
-
-        ofstream& out = runtime::event::Manager::get_output_stream();
-        if (out.is_open() == false)
-        {
-            runtime::event::Manager::open();
-        }
-        else
-        {
-            Manager::get_output_stream() << ",\n";
-        }
-
-        Manager::get_output_stream() <<
-            R"({"name":")" << m_name << R"(","cat":")" << m_category << R"(","ph":"X","pid":)"
-                                     << Manager::get_process_id() << R"(,"tid":)"
-                                     << Manager::get_thread_id() <<
-            R"(,"ts":)" << m_start << R"(,"dur":)" << (stop_time - m_start);
-        if (!m_args.empty())
-        {
-            out <<
-                R"(,"args":)" << m_args;
-        }
-        out << "}";
+        Recorder::get_default().record(m_name, m_category, m_args, m_start, stop_time - m_start);
     }
 }
 
@@ -185,6 +174,7 @@ void runtime::event::Manager::open(const string& path)
 
 void runtime::event::Manager::close()
 {
+    Recorder::flush_default();
     ofstream& out = get_output_stream();
     if (out.is_open())
     {
@@ -239,3 +229,304 @@ string runtime::event::Manager::get_thread_id()
     }
     return rc;
 }
+
+static atomic<bool> s_default_recorder_created{false};
+static atomic<uint64_t> s_next_recorder_id{0};
+
+struct runtime::event::Recorder::Record
+{
+    uint64_t start;
+    uint64_t duration;
+    bool quote_args;
+    uint8_t name_size;
+    uint8_t category_size;
+    uint8_t args_size;
+    char name[64];
+    char category[32];
+    char args[152];
+};
+
+struct runtime::event::Recorder::ThreadBuffer
+{
+    explicit ThreadBuffer(size_t capacity)
+        : records(new Record[capacity])
+    {
+    }
+
+    unique_ptr<Record[]> records;
+    string thread_id;
+    // Written by the recording thread only
+    alignas(64) atomic<size_t> head{0};
+    atomic<size_t> recorded{0};
+    atomic<size_t> dropped{0};
+    // Written by the background thread only
+    alignas(64) atomic<size_t> tail{0};
+    atomic<bool> exited{false};
+    atomic<bool> closed{false};
+};
+
+template <size_t N>
+static uint8_t copy_field(char (&field)[N], const string& value)
+{
+    size_t size = min(value.size(), N);
+    // Cut before the code point that does not fit, whose continuation bytes are 10xxxxxx
+    while (size > 0 && size < value.size() && (static_cast<uint8_t>(value[size]) & 0xC0) == 0x80)
+    {
+        size--;
+    }
+    memcpy(field, value.data(), size);
+    return static_cast<uint8_t>(size);
+}
+
+runtime::event::Recorder::Recorder(const function<void(const string& events)>& writer,
+                                   size_t records_per_thread,
+                                   chrono::milliseconds flush_period)
+    : m_writer(writer)
+    , m_capacity(max<size_t>(1, records_per_thread))
+    , m_flush_period(flush_period)
+    , m_id(s_next_recorder_id++)
+{
+    m_thread = thread([this]() { run(); });
+}
+
+runtime::event::Recorder::~Recorder()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+    drain();
+    for (auto& buffer : m_buffers)
+    {
+        buffer->closed = true;
+    }
+}
+
+void runtime::event::Recorder::record(const string& name,
+                                      const string& category,
+                                      const string& args,
+                                      uint64_t start_microseconds,
+                                      uint64_t duration_microseconds,
+                                      bool quote_args)
+{
+    ThreadBuffer& buffer = get_thread_buffer();
+    size_t head = buffer.head.load(memory_order_relaxed);
+    if (head - buffer.tail.load(memory_order_acquire) >= m_capacity)
+    {
+        buffer.dropped.store(buffer.dropped.load(memory_order_relaxed) + 1,
+                             memory_order_relaxed);
+        return;
+    }
+    Record& record = buffer.records[head % m_capacity];
+    record.start = start_microseconds;
+    record.duration = duration_microseconds;
+    record.quote_args = quote_args;
+    record.name_size = copy_field(record.name, name);
+    record.category_size = copy_field(record.category, category);
+    record.args_size = 0;
+    if (args.size() <= sizeof(record.args))
+    {
+        record.args_size = copy_field(record.args, args);
+    }
+    else
+    {
+        // Truncated args would not be valid JSON
+        m_dropped_args++;
+    }
+    buffer.head.store(head + 1, memory_order_release);
+    buffer.recorded.store(buffer.recorded.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+void runtime::event::Recorder::flush()
+{
+    unique_lock<mutex> lock(m_mutex);
+    uint64_t request = ++m_flush_requests;
+    m_cv.notify_all();
+    m_cv.wait(lock, [this, request]() { return m_flushes >= request; });
+}
+
+runtime::event::Recorder::Statistics runtime::event::Recorder::get_statistics() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    Statistics statistics;
+    statistics.recorded = m_recorded;
+    statistics.dropped = m_dropped;
+    for (auto& buffer : m_buffers)
+    {
+        statistics.recorded += buffer->recorded.load(memory_order_relaxed);
+        statistics.dropped += buffer->dropped.load(memory_order_relaxed);
+    }
+    statistics.dropped_args = m_dropped_args;
+    statistics.threads = m_num_threads;
+    return statistics;
+}
+
+runtime::event::Recorder& runtime::event::Recorder::get_default()
+{
+    // Constructed before the recorder so that they outlive it, since it writes on exit
+    Manager::get_output_stream();
+    Manager::get_process_id();
+    static Recorder recorder(
+        [](const string& events) {
+            lock_guard<mutex> lock(Manager::get_mutex());
+            ofstream& out = Manager::get_output_stream();
+            if (out.is_open() == false)
+            {
+                Manager::open();
+            }
+            else
+            {
+                out << ",\n";
+            }
+            out << events;
+        },
+        getenv_size("NGRAPH_TRACE_BUFFER_RECORDS", 8192),
+        chrono::milliseconds(getenv_size("NGRAPH_TRACE_FLUSH_MS", 100)));
+    s_default_recorder_created = true;
+    return recorder;
+}
+
+void runtime::event::Recorder::flush_default()
+{
+    if (s_default_recorder_created)
+    {
+        get_default().flush();
+    }
+}
+
+runtime::event::Recorder::ThreadBuffer& runtime::event::Recorder::get_thread_buffer()
+{
+    struct ThreadBuffers
+    {
+        ~ThreadBuffers()
+        {
+            for (auto& entry : entries)
+            {
+                entry.second->exited.store(true, memory_order_release);
+            }
+        }
+        vector<pair<uint64_t, shared_ptr<ThreadBuffer>>> entries;
+    };
+    static thread_local ThreadBuffers buffers;
+
+    for (auto it = buffers.entries.begin(); it != buffers.entries.end();)
+    {
+        if (it->first == m_id)
+        {
+            return *it->second;
+        }
+        // The recorder that owns the buffer has been destroyed
+        it = it->second->closed ? buffers.entries.erase(it) : it + 1;
+    }
+
+    auto buffer = make_shared<ThreadBuffer>(m_capacity);
+    stringstream thread_id;
+    thread_id << this_thread::get_id();
+    buffer->thread_id = thread_id.str();
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_buffers.push_back(buffer);
+        m_num_threads++;
+    }
+    buffers.entries.emplace_back(m_id, buffer);
+    return *buffer;
+}
+
+void runtime::event::Recorder::drain()
+{
+    vector<shared_ptr<ThreadBuffer>> buffers;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        buffers.assign(m_buffers.begin(), m_buffers.end());
+    }
+
+    const string& pid = Manager::get_process_id();
+    string events;
+    size_t dropped = 0;
+    for (auto& buffer : buffers)
+    {
+        // Read before the head, so that an exited buffer is only freed once it has been drained
+        bool exited = buffer->exited.load(memory_order_acquire);
+        size_t head = buffer->head.load(memory_order_acquire);
+        for (size_t tail = buffer->tail.load(memory_order_relaxed); tail != head; tail++)
+        {
+            const Record& record = buffer->records[tail % m_capacity];
+            if (!events.empty())
+            {
+                events += ",\n";
+            }
+            events += R"({"name":")";
+            append_json_escaped(events, record.name, record.name_size);
+            events += R"(","cat":")";
+            append_json_escaped(events, record.category, record.category_size);
+            events += R"(","ph":"X","pid":)" + pid + R"(,"tid":")" + buffer->thread_id +
+                      R"(","ts":)" + to_string(record.start) + R"(,"dur":)" +
+                      to_string(record.duration);
+            if (record.args_size > 0)
+            {
+                events += R"(,"args":)";
+                if (record.quote_args)
+                {
+                    events += '"';
+                    append_json_escaped(events, record.args, record.args_size);
+                    events += '"';
+                }
+                else
+                {
+                    events.append(record.args, record.args_size);
+                }
+            }
+            events += "}";
+            buffer->tail.store(tail + 1, memory_order_release);
+        }
+        if (exited)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_recorded += buffer->recorded.load(memory_order_relaxed);
+            m_dropped += buffer->dropped.load(memory_order_relaxed);
+            m_buffers.remove(buffer);
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        dropped = m_dropped;
+        for (auto& buffer : m_buffers)
+        {
+            dropped += buffer->dropped.load(memory_order_relaxed);
+        }
+    }
+    if (dropped > m_reported_dropped)
+    {
+        if (!events.empty())
+        {
+            events += ",\n";
+        }
+        events += R"({"name":"dropped_events","ph":"C","pid":)" + pid + R"(,"ts":)" +
+                  to_string(Manager::get_current_microseconds()) + R"(,"args":{"dropped":)" +
+                  to_string(dropped) + "}}";
+        m_reported_dropped = dropped;
+    }
+    if (!events.empty())
+    {
+        m_writer(events);
+    }
+}
+
+void runtime::event::Recorder::run()
+{
+    unique_lock<mutex> lock(m_mutex);
+    while (!m_stop)
+    {
+        m_cv.wait_for(
+            lock, m_flush_period, [this]() { return m_stop || m_flush_requests > m_flushes; });
+        uint64_t requests = m_flush_requests;
+        lock.unlock();
+        drain();
+        lock.lock();
+        m_flushes = requests;
+        m_cv.notify_all();
+    }
+}
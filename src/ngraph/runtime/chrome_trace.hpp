@@ -16,9 +16,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -31,6 +37,8 @@
 #include <unistd.h>
 #endif
 
+#include "ngraph/ngraph_visibility.hpp"
+
 namespace ngraph
 {
     namespace runtime
@@ -40,6 +48,7 @@ namespace ngraph
             class Duration;
             class Object;
             class Manager;
+            class Recorder;
         }
     }
 }
@@ -79,9 +88,11 @@ class ngraph::runtime::event::Manager
 {
     friend class Duration;
     friend class Object;
+    friend class Recorder;
 
 public:
     static void open(const std::string& path = "runtime_event_trace.json");
+    /// \brief Write the buffered events and close the output file
     static void close();
     static bool is_tracing_enabled() { return s_tracing_enabled; }
     static void enable_event_tracing();
@@ -118,6 +129,9 @@ public:
     /// This funtion has an implicit stop() if stop() has not been previously called
     void write();
 
+    /// \brief replace the args of the event, for values only known once the event is over
+    void set_args(const std::string& args);
+
     Duration(const Duration&) = delete;
     Duration& operator=(Duration const&) = delete;
 
@@ -142,3 +156,89 @@ private:
     const std::string m_name;
     size_t m_id{0};
 };
+
+/// \brief Buffers trace events in per-thread rings and writes them from a background thread.
+///
+/// Recording an event copies it into a fixed-size binary record in a single-producer,
+/// single-consumer ring owned by the calling thread, with no locks and no allocation. A
+/// background thread drains the rings every flush period, formats the records as Chrome trace
+/// events and passes them to the writer. When a ring is full the event is dropped and counted;
+/// the drop count is also written to the trace as a counter event. Names and categories longer
+/// than a record holds are truncated on a UTF-8 code point boundary, and args that do not fit
+/// are dropped and counted.
+///
+/// Each thread's ring holds NGRAPH_TRACE_BUFFER_RECORDS records (8192 by default) and the
+/// rings are drained every NGRAPH_TRACE_FLUSH_MS milliseconds (100 by default). The ring of a
+/// thread is freed once the thread has exited and its records have been written.
+class NGRAPH_API ngraph::runtime::event::Recorder
+{
+public:
+    /// \brief Counters over the lifetime of the recorder
+    struct Statistics
+    {
+        size_t recorded = 0;
+        size_t dropped = 0;
+        size_t dropped_args = 0;
+        size_t threads = 0;
+    };
+
+    /// \param writer Called on the background thread with one or more events separated by
+    ///        ",\n", without a leading or trailing separator.
+    /// \param records_per_thread Capacity of each thread's ring
+    /// \param flush_period Time between two drains of the rings
+    Recorder(const std::function<void(const std::string& events)>& writer,
+             size_t records_per_thread,
+             std::chrono::milliseconds flush_period);
+    /// \brief Writes the remaining records
+    ~Recorder();
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /// \brief Record a complete event ("ph":"X")
+    /// \param args JSON value for "args", or empty for none
+    /// \param quote_args Write args as a JSON string instead of a JSON value
+    void record(const std::string& name,
+                const std::string& category,
+                const std::string& args,
+                uint64_t start_microseconds,
+                uint64_t duration_microseconds,
+                bool quote_args = false);
+    /// \brief Wait until every event recorded before the call has been written
+    void flush();
+    Statistics get_statistics() const;
+
+    /// \brief The recorder writing to the file of Manager, created on first use
+    static Recorder& get_default();
+    /// \brief Flush the default recorder if it has been created
+    static void flush_default();
+
+private:
+    struct Record;
+    struct ThreadBuffer;
+
+    ThreadBuffer& get_thread_buffer();
+    /// \brief Write the records of every ring, freeing the rings of exited threads
+    void drain();
+    void run();
+
+    std::function<void(const std::string&)> m_writer;
+    size_t m_capacity;
+    std::chrono::milliseconds m_flush_period;
+    /// \brief Distinguishes this recorder from earlier ones at the same address
+    uint64_t m_id;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::list<std::shared_ptr<ThreadBuffer>> m_buffers;
+    uint64_t m_flush_requests = 0;
+    uint64_t m_flushes = 0;
+    bool m_stop = false;
+
+    std::atomic<size_t> m_dropped_args{0};
+    size_t m_recorded = 0;
+    size_t m_dropped = 0;
+    size_t m_reported_dropped = 0;
+    size_t m_num_threads = 0;
+    std::thread m_thread;
+};
@@ -0,0 +1,232 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <limits>
+
+#include "ngraph/runtime/cpu/cpu_arena_pool.hpp"
+#include "ngraph/env_util.hpp"
+#include "ngraph/log.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::cpu::ArenaPool& runtime::cpu::ArenaPool::get()
+{
+    static ArenaPool pool;
+    return pool;
+}
+
+// The pool is created on first use by a call, so an invalid value is reported and ignored
+// rather than thrown from there
+static size_t getenv_size_or_zero(const char* env_var)
+{
+    try
+    {
+        return getenv_size(env_var, 0);
+    }
+    catch (const exception& e)
+    {
+        NGRAPH_WARN << e.what() << "Using 0 instead.";
+        return 0;
+    }
+}
+
+// Negative periods are treated as 0. The upper bound keeps the sweep thread's wait, half the
+// period in microseconds, from overflowing.
+static int64_t clamp_idle_period_ms(int64_t idle_period_ms)
+{
+    return min(max<int64_t>(idle_period_ms, 0), numeric_limits<int64_t>::max() / 1000);
+}
+
+runtime::cpu::ArenaPool::ArenaPool()
+{
+    m_max_bytes = getenv_size_or_zero("NGRAPH_CPU_ARENA_POOL_BYTES");
+    size_t idle_period_ms = getenv_size_or_zero("NGRAPH_CPU_ARENA_IDLE_MS");
+    m_idle_period_ms = clamp_idle_period_ms(static_cast<int64_t>(
+        min<size_t>(idle_period_ms, static_cast<size_t>(numeric_limits<int64_t>::max()))));
+}
+
+runtime::cpu::ArenaPool::~ArenaPool()
+{
+    {
+        lock_guard<mutex> lock(m_timer_mutex);
+        m_stop_sweeping = true;
+    }
+    m_timer_cv.notify_all();
+    if (m_sweep_thread.joinable())
+    {
+        m_sweep_thread.join();
+    }
+    trim(0);
+}
+
+runtime::AlignedBuffer*
+    runtime::cpu::ArenaPool::acquire(size_t size, size_t alignment, Allocator* allocator)
+{
+    // Only buffers from the default allocator are pooled, since a custom allocator might not
+    // outlive the pool
+    if (allocator == get_default_allocator())
+    {
+        lock_guard<mutex> lock(m_mutex);
+        auto it = m_free_buffers.lower_bound(make_pair(alignment, size));
+        if (it != m_free_buffers.end() && it->first.first == alignment &&
+            it->first.second <= 2 * size)
+        {
+            AlignedBuffer* buffer = it->second;
+            m_pooled_bytes -= it->first.second;
+            m_free_buffers.erase(it);
+            return buffer;
+        }
+    }
+    return new AlignedBuffer(size, alignment, allocator);
+}
+
+void runtime::cpu::ArenaPool::release(AlignedBuffer* buffer,
+                                      size_t alignment,
+                                      Allocator* allocator)
+{
+    if (buffer == nullptr)
+    {
+        return;
+    }
+    if (allocator == get_default_allocator())
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_pooled_bytes + buffer->size() <= m_max_bytes)
+        {
+            m_pooled_bytes += buffer->size();
+            m_free_buffers.emplace(make_pair(alignment, buffer->size()), buffer);
+            return;
+        }
+    }
+    delete buffer;
+}
+
+chrono::milliseconds runtime::cpu::ArenaPool::get_idle_period() const
+{
+    return chrono::milliseconds(m_idle_period_ms);
+}
+
+void runtime::cpu::ArenaPool::set_idle_period(chrono::milliseconds idle_period)
+{
+    {
+        lock_guard<mutex> lock(m_timer_mutex);
+        m_idle_period_ms = clamp_idle_period_ms(idle_period.count());
+    }
+    m_timer_cv.notify_all();
+}
+
+size_t runtime::cpu::ArenaPool::get_max_bytes() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_max_bytes;
+}
+
+void runtime::cpu::ArenaPool::set_max_bytes(size_t max_bytes)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_max_bytes = max_bytes;
+    }
+    trim(max_bytes);
+}
+
+size_t runtime::cpu::ArenaPool::get_pooled_bytes() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_pooled_bytes;
+}
+
+void runtime::cpu::ArenaPool::trim(size_t max_bytes)
+{
+    vector<AlignedBuffer*> freed;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        // Free the buffers with the largest alignment and size first
+        while (m_pooled_bytes > max_bytes)
+        {
+            auto it = prev(m_free_buffers.end());
+            m_pooled_bytes -= it->first.second;
+            freed.push_back(it->second);
+            m_free_buffers.erase(it);
+        }
+    }
+    for (auto buffer : freed)
+    {
+        delete buffer;
+    }
+}
+
+size_t runtime::cpu::ArenaPool::add_sweeper(const Sweeper& sweeper)
+{
+    size_t id;
+    {
+        lock_guard<mutex> lock(m_sweep_mutex);
+        id = m_next_sweeper_id++;
+        m_sweepers.emplace(id, sweeper);
+    }
+    lock_guard<mutex> lock(m_timer_mutex);
+    if (!m_sweep_thread.joinable())
+    {
+        m_sweep_thread = thread([this]() { run_sweeps(); });
+    }
+    return id;
+}
+
+void runtime::cpu::ArenaPool::remove_sweeper(size_t id)
+{
+    lock_guard<mutex> lock(m_sweep_mutex);
+    m_sweepers.erase(id);
+}
+
+void runtime::cpu::ArenaPool::sweep()
+{
+    auto idle_period = get_idle_period();
+    if (idle_period.count() == 0)
+    {
+        return;
+    }
+    auto idle_since = chrono::steady_clock::now() - idle_period;
+    lock_guard<mutex> lock(m_sweep_mutex);
+    for (auto& sweeper : m_sweepers)
+    {
+        sweeper.second(idle_since);
+    }
+}
+
+void runtime::cpu::ArenaPool::run_sweeps()
+{
+    unique_lock<mutex> lock(m_timer_mutex);
+    while (!m_stop_sweeping)
+    {
+        int64_t idle_period_ms = m_idle_period_ms;
+        if (idle_period_ms == 0)
+        {
+            m_timer_cv.wait(lock);
+            continue;
+        }
+        // Any change of the idle period wakes the thread, which then waits for the new one
+        if (m_timer_cv.wait_for(lock, chrono::microseconds(idle_period_ms * 500)) ==
+                cv_status::timeout &&
+            !m_stop_sweeping)
+        {
+            lock.unlock();
+            sweep();
+            lock.lock();
+        }
+    }
+}
@@ -0,0 +1,111 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/allocator.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Process-wide pool of activation arenas for CPU runtime contexts.
+            ///
+            /// Runtime contexts allocate their activation buffers and scratchpad on first use
+            /// and give them back when they have been idle for longer than the idle period
+            /// (NGRAPH_CPU_ARENA_IDLE_MS, 0 by default, which keeps them until the executable
+            /// is destroyed). Returned buffers are kept for reuse by any executable while the
+            /// pool holds less than NGRAPH_CPU_ARENA_POOL_BYTES (0 by default, which frees them
+            /// immediately).
+            ///
+            /// Idle arenas are released by sweeps, which run every half idle period on a
+            /// background thread owned by the pool, or on an explicit call to sweep. The thread
+            /// is started when the first sweeper is added, so calls never pay for a sweep.
+            class CPU_BACKEND_API ArenaPool
+            {
+            public:
+                using Sweeper = std::function<void(std::chrono::steady_clock::time_point)>;
+
+                static ArenaPool& get();
+
+                /// \brief Return a buffer of at least size bytes, reusing a pooled one of at
+                ///        most twice that size if there is one.
+                AlignedBuffer* acquire(size_t size, size_t alignment, Allocator* allocator);
+                /// \brief Give back a buffer returned by acquire with the same alignment and
+                ///        allocator.
+                void release(AlignedBuffer* buffer, size_t alignment, Allocator* allocator);
+
+                std::chrono::milliseconds get_idle_period() const;
+                /// \brief Set the idle period. A negative period is treated as 0.
+                void set_idle_period(std::chrono::milliseconds idle_period);
+                size_t get_max_bytes() const;
+                /// \brief Limit the size of the buffers kept for reuse, freeing the excess
+                void set_max_bytes(size_t max_bytes);
+                /// \brief Total size of the buffers kept for reuse
+                size_t get_pooled_bytes() const;
+
+                /// \brief Register a function that releases the arenas its owner has not used
+                ///        since the time point it is given. It is called on the sweep thread.
+                /// \returns An id for remove_sweeper
+                size_t add_sweeper(const Sweeper& sweeper);
+                /// \brief Unregister a sweeper. Waits for a running sweep to finish.
+                void remove_sweeper(size_t id);
+                /// \brief Release all arenas idle for longer than the idle period
+                void sweep();
+
+            private:
+                ArenaPool();
+                ~ArenaPool();
+
+                void trim(size_t max_bytes);
+                /// \brief Body of the sweep thread
+                void run_sweeps();
+
+                mutable std::mutex m_mutex;
+                /// \brief Free buffers by alignment and size
+                std::multimap<std::pair<size_t, size_t>, AlignedBuffer*> m_free_buffers;
+                size_t m_pooled_bytes = 0;
+                size_t m_max_bytes;
+                std::atomic<int64_t> m_idle_period_ms;
+
+                std::mutex m_sweep_mutex;
+                std::map<size_t, Sweeper> m_sweepers;
+                size_t m_next_sweeper_id = 0;
+
+                // The sweep thread waits on m_timer_cv for half an idle period, or until the
+                // idle period is changed or the pool is destroyed
+                std::mutex m_timer_mutex;
+                std::condition_variable m_timer_cv;
+                std::thread m_sweep_thread;
+                bool m_stop_sweeping = false;
+            };
+        }
+    }
+}
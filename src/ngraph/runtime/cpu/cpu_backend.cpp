@@ -18,9 +18,13 @@
 #include <tbb/tbb_stddef.h>
 #endif
 
+#include <mkldnn.hpp>
+#include <sstream>
+
 #include "cpu_backend_visibility.h"
 
 #include "ngraph/component_manager.hpp"
+#include "ngraph/cpio.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
@@ -29,6 +33,7 @@
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/static_initialize.hpp"
+#include "ngraph/runtime/persistent_cache.hpp"
 #include "ngraph/util.hpp"
 
 #ifdef NGRAPH_MLIR_ENABLE
@@ -39,6 +44,19 @@
 using namespace ngraph;
 using namespace std;
 
+static const string s_save_info = "CPU Save File 1.0";
+
+// Saved executables hold raw MKLDNN memory descriptors, which only the MKLDNN build that wrote
+// them can read
+static string get_build_info()
+{
+    const mkldnn_version_t* version = mkldnn_version();
+    stringstream ss;
+    ss << "MKLDNN " << version->major << "." << version->minor << "." << version->patch << " "
+       << version->hash;
+    return ss.str();
+}
+
 extern "C" CPU_BACKEND_API void ngraph_register_cpu_backend()
 {
     runtime::BackendManager::register_backend("CPU", [](const std::string& /* config */) {
@@ -115,8 +133,23 @@ shared_ptr<runtime::Executable>
             return rc;
         }
     }
-    rc = make_shared<CPU_Executable>(
-        func, pass_config, get_host_memory_allocator(), performance_counters_enabled);
+    // Only executables built for DEX without performance data can be saved
+    shared_ptr<runtime::PersistentCache> cache =
+        !performance_counters_enabled && CPU_ExternalFunction::uses_direct_execution(pass_config)
+            ? get_persistent_cache()
+            : nullptr;
+    if (cache)
+    {
+        rc = cache->compile(*this, func, pass_config, performance_counters_enabled, [&]() {
+            return make_shared<CPU_Executable>(
+                func, pass_config, get_host_memory_allocator(), performance_counters_enabled);
+        });
+    }
+    else
+    {
+        rc = make_shared<CPU_Executable>(
+            func, pass_config, get_host_memory_allocator(), performance_counters_enabled);
+    }
     {
         std::lock_guard<std::mutex> guard(m_exec_map_mutex);
         m_exec_map.insert({func, rc});
@@ -132,7 +165,8 @@ runtime::cpu::CPU_Executable::CPU_Executable(shared_ptr<Function> func,
     FunctionInstance& instance = m_function_instance;
     if (instance.m_external_function == nullptr)
     {
-        instance.m_external_function = make_shared<CPU_ExternalFunction>(func);
+        // Keep the function after it is built so that the executable can be saved
+        instance.m_external_function = make_shared<CPU_ExternalFunction>(func, false);
         instance.m_external_function->m_emit_timing = performance_counters_enabled;
         auto cf = instance.m_external_function->make_call_frame(pass_config, allocator);
         instance.m_call_frame = dynamic_pointer_cast<CPU_CallFrame>(cf);
@@ -140,6 +174,32 @@ runtime::cpu::CPU_Executable::CPU_Executable(shared_ptr<Function> func,
     set_parameters_and_results(*func);
 }
 
+runtime::cpu::CPU_Executable::CPU_Executable(
+    const shared_ptr<CPU_ExternalFunction>& external_function,
+    ngraph::pass::PassConfig& pass_config,
+    Allocator* allocator)
+{
+    FunctionInstance& instance = m_function_instance;
+    instance.m_external_function = external_function;
+    instance.m_call_frame = external_function->make_call_frame(pass_config, allocator);
+    set_parameters_and_results(*external_function->get_function());
+}
+
+void runtime::cpu::CPU_Executable::save(ostream& out)
+{
+    NGRAPH_CHECK(!m_function_instance.m_external_function->m_emit_timing,
+                 "Executables collecting performance data cannot be saved");
+    stringstream model;
+    m_function_instance.m_external_function->save(model);
+    string model_string = model.str();
+
+    cpio::Writer writer(out);
+    writer.write("save_info", s_save_info.data(), s_save_info.size());
+    string build_info = get_build_info();
+    writer.write("build_info", build_info.data(), build_info.size());
+    writer.write("model", model_string.data(), model_string.size());
+}
+
 std::shared_ptr<ngraph::runtime::cpu::CPU_CallFrame> runtime::cpu::CPU_Executable::get_call_frame()
 {
     FunctionInstance& instance = m_function_instance;
@@ -163,6 +223,19 @@ bool runtime::cpu::CPU_Executable::call(const vector<shared_ptr<runtime::Tensor>
     return rc;
 }
 
+void runtime::cpu::CPU_Executable::call_async(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                              const vector<shared_ptr<runtime::Tensor>>& inputs,
+                                              const CallCallback& callback)
+{
+    FunctionInstance& instance = m_function_instance;
+    if (instance.m_external_function == nullptr)
+    {
+        throw runtime_error("compile() must be called before call_async().");
+    }
+
+    instance.m_call_frame->call_async(outputs, inputs, callback);
+}
+
 void runtime::cpu::CPU_Backend::remove_compiled_function(shared_ptr<Executable> exec)
 {
     std::lock_guard<std::mutex> guard(m_exec_map_mutex);
@@ -210,6 +283,16 @@ vector<runtime::PerformanceCounter> runtime::cpu::CPU_Executable::get_performanc
     return rc;
 }
 
+runtime::MemoryReport runtime::cpu::CPU_Executable::get_memory_report() const
+{
+    const FunctionInstance& instance = m_function_instance;
+    if (instance.m_call_frame != nullptr)
+    {
+        return instance.m_call_frame->get_memory_report();
+    }
+    return MemoryReport();
+}
+
 shared_ptr<ngraph::op::Parameter> runtime::cpu::CPU_Executable::get_parameter(size_t index) const
 {
     const ParameterVector& parameters = get_parameters();
@@ -280,6 +363,28 @@ vector<shared_ptr<runtime::Tensor>>
     return result_tensors;
 }
 
+shared_ptr<runtime::Executable> runtime::cpu::CPU_Backend::load(istream& in)
+{
+    cpio::Reader reader(in);
+    map<string, string> records;
+    for (const cpio::FileInfo& info : reader.get_file_info())
+    {
+        vector<char> buffer = reader.read(info);
+        records[info.get_name()] = string(buffer.data(), buffer.size());
+    }
+    if (records["save_info"] != s_save_info || records["build_info"] != get_build_info() ||
+        records.count("model") == 0)
+    {
+        return nullptr;
+    }
+
+    stringstream model(records["model"]);
+    auto external_function = CPU_ExternalFunction::load(model);
+    ngraph::pass::PassConfig pass_config;
+    return make_shared<CPU_Executable>(
+        external_function, pass_config, get_host_memory_allocator());
+}
+
 bool runtime::cpu::CPU_Backend::is_supported(const Node& /* op */) const
 {
     return true;
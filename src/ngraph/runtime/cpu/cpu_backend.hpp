@@ -71,6 +71,11 @@ namespace ngraph
                 bool is_supported(const Node& node) const override;
                 bool is_supported_property(const Property prop) const override;
 
+                /// \brief Loads an executable written by CPU_Executable::save
+                /// \returns nullptr if the executable was saved by a different version of the
+                ///          backend or of MKLDNN
+                std::shared_ptr<Executable> load(std::istream& input_stream) override;
+
             private:
                 // this mutex will be used to protect the addition and deletion
                 // of function to m_exec_map across multiple threads
@@ -87,13 +92,25 @@ namespace ngraph
                                ngraph::pass::PassConfig& pass_config,
                                Allocator* allocator,
                                bool performance_counters_enabled);
+                CPU_Executable(const std::shared_ptr<CPU_ExternalFunction>& external_function,
+                               ngraph::pass::PassConfig& pass_config,
+                               Allocator* allocator);
                 bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                           const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
 
+                using Executable::call_async;
+                /// \brief Queues the call for the worker threads of the call frame, one per
+                ///        runtime context.
+                void call_async(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                                const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                                const CallCallback& callback) override;
+
                 std::shared_ptr<CPU_CallFrame> get_call_frame();
 
                 std::vector<PerformanceCounter> get_performance_data() const override;
 
+                MemoryReport get_memory_report() const override;
+
                 std::shared_ptr<runtime::Tensor> create_input_tensor(size_t input_index) override;
 
                 std::shared_ptr<runtime::Tensor> create_output_tensor(size_t output_index) override;
@@ -104,6 +121,9 @@ namespace ngraph
                 std::vector<std::shared_ptr<runtime::Tensor>>
                     create_output_tensor(size_t output_index, size_t pipeline_depth) override;
 
+                /// \brief Writes the compiled function, which must have been built for DEX
+                void save(std::ostream& output_stream) override;
+
             private:
                 std::shared_ptr<ngraph::op::Parameter> get_parameter(size_t index) const;
                 std::shared_ptr<ngraph::op::Result> get_result(size_t index) const;
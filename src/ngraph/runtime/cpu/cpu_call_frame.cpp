@@ -18,7 +18,9 @@
 #include <thread>
 
 #include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/cpu/cpu_arena_pool.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
@@ -55,10 +57,30 @@ runtime::cpu::CPU_CallFrame::CPU_CallFrame(std::shared_ptr<CPU_ExternalFunction>
         NGRAPH_CHECK(m_compiled_init_ctx_func, "compiled_init_ctx_func cannot be null.");
         cg_ctx = m_compiled_init_ctx_func();
     }
+    else
+    {
+        m_sweeper_id = ArenaPool::get().add_sweeper(
+            [this](std::chrono::steady_clock::time_point idle_since) {
+                release_idle_arenas(idle_since);
+            });
+    }
 }
 
 runtime::cpu::CPU_CallFrame::~CPU_CallFrame()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_async_mutex);
+        m_stop_async_workers = true;
+    }
+    m_async_cv.notify_all();
+    for (auto& worker : m_async_workers)
+    {
+        worker.join();
+    }
+    if (m_external_function->is_direct_execution())
+    {
+        ArenaPool::get().remove_sweeper(m_sweeper_id);
+    }
     cleanup_runtime_context();
     if (!m_external_function->is_direct_execution())
     {
@@ -75,6 +97,11 @@ void runtime::cpu::CPU_CallFrame::inner_call(
     vector<void*> inputs;
     vector<void*> outputs;
 
+    if (!m_ctx_vec[id]->has_arena)
+    {
+        acquire_arena(m_ctx_vec[id]);
+    }
+
     for (size_t i = 0; i < input_tvs.size(); i++)
     {
         shared_ptr<runtime::cpu::CPUTensorView> tv =
@@ -119,44 +146,142 @@ void runtime::cpu::CPU_CallFrame::call(
     const std::vector<std::shared_ptr<runtime::Tensor>>& output_tvs,
     const std::vector<std::shared_ptr<runtime::Tensor>>& input_tvs)
 {
-    size_t id = 0;
-    auto disable_caching = false;
+    // The context goes back to the pool even if the call throws
+    struct ContextGuard
     {
-        std::unique_lock<std::mutex> lck(m_mutex);
-        while (m_num_ctx_available == 0)
+        CPU_CallFrame& call_frame;
+        size_t id;
+        bool completed;
+        ~ContextGuard()
         {
-            m_cv.wait(lck);
+            if (!completed)
+            {
+                // Values cached in the context by the failed call cannot be trusted
+                call_frame.m_prev_ctx = call_frame.m_num_ctx;
+            }
+            call_frame.m_ctx_last_use[id] = std::chrono::steady_clock::now();
+            call_frame.m_num_running--;
+            call_frame.release_context(id);
         }
+    } guard{*this, acquire_context(), false};
+    size_t id = guard.id;
+    size_t running = ++m_num_running;
+    size_t peak = m_peak_running;
+    while (running > peak && !m_peak_running.compare_exchange_weak(peak, running))
+    {
+    }
+    // Staleness hints are only applicable to the context of the previous call
+    auto disable_caching = m_prev_ctx.exchange(id) != id;
 
-        for (size_t i = 0; i < m_num_ctx; i++)
+    m_ctx_vec[id]->pc = 0;
+    propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
+    inner_call(output_tvs, input_tvs, id, disable_caching);
+    guard.completed = true;
+}
+
+void runtime::cpu::CPU_CallFrame::call_async(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& output_tvs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& input_tvs,
+    const Executable::CallCallback& callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_async_mutex);
+        if (m_async_workers.empty())
         {
-            if (m_id_pool[i])
+            for (size_t i = 0; i < m_num_ctx; i++)
             {
-                id = i;
-                break;
+                m_async_workers.emplace_back([this]() { run_async_calls(); });
             }
         }
-        NGRAPH_CHECK(id != m_num_ctx);
-        m_id_pool[id] = false;
-        if (id != m_prev_ctx)
+        m_async_calls.emplace_back([this, output_tvs, input_tvs, callback]() {
+            std::exception_ptr error;
+            try
+            {
+                call(output_tvs, input_tvs);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            callback(error == nullptr, error);
+        });
+    }
+    m_async_cv.notify_one();
+}
+
+void runtime::cpu::CPU_CallFrame::run_async_calls()
+{
+    while (true)
+    {
+        std::function<void()> async_call;
         {
-            // Disable caching since staleness hints are no longer
-            // applicable to this context
-            disable_caching = true;
+            std::unique_lock<std::mutex> lock(m_async_mutex);
+            m_async_cv.wait(lock,
+                            [this]() { return m_stop_async_workers || !m_async_calls.empty(); });
+            if (m_async_calls.empty())
+            {
+                return;
+            }
+            async_call = std::move(m_async_calls.front());
+            m_async_calls.pop_front();
         }
-        m_prev_ctx = id;
-        m_num_ctx_available--;
+        async_call();
     }
+}
 
-    m_ctx_vec[id]->pc = 0;
-    propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
-    inner_call(output_tvs, input_tvs, id, disable_caching);
+size_t runtime::cpu::CPU_CallFrame::acquire_context()
+{
+    size_t id;
+    if (try_acquire_context(id))
+    {
+        return id;
+    }
+    // Slow path. A context released after m_num_waiters is incremented is either seen by
+    // the predicate or its release notifies m_cv while this thread waits.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_num_waiters++;
+    m_cv.wait(lock, [this, &id]() { return try_acquire_context(id); });
+    m_num_waiters--;
+    return id;
+}
 
-    m_mutex.lock();
-    m_id_pool[id] = true;
-    m_num_ctx_available++;
-    m_mutex.unlock();
-    m_cv.notify_one();
+bool runtime::cpu::CPU_CallFrame::try_acquire_context(size_t& id)
+{
+    uint64_t head = m_free_ctx.load(std::memory_order_acquire);
+    while (true)
+    {
+        uint32_t top = static_cast<uint32_t>(head);
+        if (top == 0)
+        {
+            return false;
+        }
+        uint64_t next = m_next_free_ctx[top - 1].load(std::memory_order_relaxed);
+        uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+        if (m_free_ctx.compare_exchange_weak(
+                head, new_head, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            id = top - 1;
+            return true;
+        }
+    }
+}
+
+void runtime::cpu::CPU_CallFrame::release_context(size_t id)
+{
+    uint64_t head = m_free_ctx.load(std::memory_order_relaxed);
+    uint64_t new_head;
+    do
+    {
+        m_next_free_ctx[id].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        new_head = (((head >> 32) + 1) << 32) | (id + 1);
+    } while (!m_free_ctx.compare_exchange_weak(
+        head, new_head, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    if (m_num_waiters.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cv.notify_one();
+    }
 }
 
 void runtime::cpu::CPU_CallFrame::propagate_layouts(
@@ -181,9 +306,11 @@ void runtime::cpu::CPU_CallFrame::propagate_layouts(
 
 void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
 {
+    m_allocator = allocator;
+    m_ctx_last_use.resize(m_num_ctx);
+    m_next_free_ctx.reset(new std::atomic<uint32_t>[m_num_ctx]);
     for (size_t i = 0; i < m_num_ctx; i++)
     {
-        m_id_pool[i] = true;
         auto ctx = new CPURuntimeContext;
         m_ctx_vec.push_back(ctx);
 
@@ -199,16 +326,11 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
 
         ctx->buffer_data = std::vector<void*>(m_external_function->get_buffer_size());
 
-        // Create temporary buffer pools
-        size_t alignment = runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment;
-        for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
-        {
-            auto buffer = new AlignedBuffer(buffer_size, alignment, allocator);
-            ctx->memory_buffers.push_back(buffer);
-        }
+        ctx->scratchpad_buffer = nullptr;
+        ctx->has_arena = false;
+        ctx->new_arena = false;
+        ctx->thread_pool = executor::GetCPUExecutor().get_context_thread_pool(i);
         const auto& mkldnn_emitter = m_external_function->get_mkldnn_emitter();
-        // Create scratchpad
-        auto scratchpad_size = mkldnn_emitter->get_max_scratchpad_size();
         if (m_external_function->is_direct_execution())
         {
             ctx->mkldnn_primitives =
@@ -217,19 +339,14 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
                 std::vector<mkldnn::memory*>(mkldnn_emitter->get_mkldnn_memories().size());
             ctx->mkldnn_scratchpad_mds = std::vector<mkldnn::memory::desc*>(
                 mkldnn_emitter->get_mkldnn_scratchpad_mds().size());
-            if (scratchpad_size > 0)
-            {
-                ctx->scratchpad_buffer = new AlignedBuffer(scratchpad_size, alignment, allocator);
-            }
-            else
-            {
-                ctx->scratchpad_buffer = nullptr;
-            }
         }
         else
         {
             // single thread for codegen
             NGRAPH_CHECK(m_num_ctx == 1);
+            // Generated code caches results across calls in the arena, so it is allocated up
+            // front and kept
+            acquire_arena(ctx);
         }
 
         ctx->states = m_external_function->m_states.data();
@@ -247,7 +364,10 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
         }
 #endif
     }
-    m_num_ctx_available = m_num_ctx;
+    for (size_t i = m_num_ctx; i > 0; i--)
+    {
+        release_context(i - 1);
+    }
 }
 
 void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
@@ -267,18 +387,11 @@ void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
         {
             delete m;
         }
-        for (auto buffer : ctx->memory_buffers)
-        {
-            delete buffer;
-        }
+        release_arena(ctx);
         for (auto s : ctx->mkldnn_scratchpad_mds)
         {
             delete s;
         }
-        if (m_external_function->is_direct_execution())
-        {
-            delete ctx->scratchpad_buffer;
-        }
 
 #if defined(NGRAPH_TBB_ENABLE)
         if (m_external_function->is_direct_execution() &&
@@ -304,5 +417,85 @@ void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
 #endif
         delete ctx;
     }
-    m_num_ctx_available = 0;
+    m_free_ctx = 0;
+}
+
+void runtime::cpu::CPU_CallFrame::acquire_arena(CPURuntimeContext* ctx)
+{
+    auto& pool = ArenaPool::get();
+    size_t alignment = runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment;
+    auto& cpu_executor = executor::GetCPUExecutor();
+    for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
+    {
+        ctx->memory_buffers.push_back(pool.acquire(buffer_size, alignment, m_allocator));
+        cpu_executor.place_memory(
+            ctx->memory_buffers.back()->get_ptr(), buffer_size, ctx->thread_pool);
+    }
+    // Codegen keeps its scratchpad in the generated context
+    auto scratchpad_size = m_external_function->get_mkldnn_emitter()->get_max_scratchpad_size();
+    if (m_external_function->is_direct_execution() && scratchpad_size > 0)
+    {
+        ctx->scratchpad_buffer = pool.acquire(scratchpad_size, alignment, m_allocator);
+        cpu_executor.place_memory(
+            ctx->scratchpad_buffer->get_ptr(), scratchpad_size, ctx->thread_pool);
+    }
+    ctx->has_arena = true;
+    ctx->new_arena = true;
+    m_num_arenas++;
+}
+
+void runtime::cpu::CPU_CallFrame::release_arena(CPURuntimeContext* ctx)
+{
+    if (ctx->has_arena)
+    {
+        m_num_arenas--;
+    }
+    auto& pool = ArenaPool::get();
+    size_t alignment = runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment;
+    for (auto buffer : ctx->memory_buffers)
+    {
+        pool.release(buffer, alignment, m_allocator);
+    }
+    ctx->memory_buffers.clear();
+    pool.release(ctx->scratchpad_buffer, alignment, m_allocator);
+    ctx->scratchpad_buffer = nullptr;
+    ctx->has_arena = false;
+}
+
+void runtime::cpu::CPU_CallFrame::release_idle_arenas(
+    std::chrono::steady_clock::time_point idle_since)
+{
+    // Take every available context so that none of them is used while its arena is released
+    std::vector<size_t> ids;
+    size_t id;
+    while (try_acquire_context(id))
+    {
+        ids.push_back(id);
+    }
+    for (auto i : ids)
+    {
+        if (m_ctx_vec[i]->has_arena && m_ctx_last_use[i] < idle_since)
+        {
+            release_arena(m_ctx_vec[i]);
+        }
+    }
+    for (auto i : ids)
+    {
+        release_context(i);
+    }
+}
+
+runtime::MemoryReport runtime::cpu::CPU_CallFrame::get_memory_report() const
+{
+    MemoryReport report;
+    for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
+    {
+        report.activation_bytes += buffer_size;
+    }
+    report.constant_bytes = m_external_function->get_constant_bytes();
+    report.scratchpad_bytes = m_external_function->get_mkldnn_emitter()->get_max_scratchpad_size();
+    report.contexts = m_num_ctx;
+    report.allocated_contexts = m_num_arenas;
+    report.peak_call_bytes = m_peak_running * report.context_bytes();
+    return report;
 }
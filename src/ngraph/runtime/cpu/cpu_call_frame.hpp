@@ -16,17 +16,22 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ngraph/function.hpp"
 #include "ngraph/runtime/allocator.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
 #include "ngraph/runtime/cpu/cpu_runtime_context.hpp"
+#include "ngraph/runtime/executable.hpp"
 #include "ngraph/runtime/tensor.hpp"
 
 class CPURuntimeContextCG;
@@ -70,6 +75,13 @@ namespace ngraph
                 void call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                           const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
 
+                /// \brief Queue a call for one of NGRAPH_CPU_CONCURRENCY worker threads, which
+                ///        are started on the first asynchronous call, and invoke callback on that
+                ///        thread when it finishes. The destructor waits for queued calls.
+                void call_async(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                                const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                                const Executable::CallCallback& callback);
+
                 void propagate_layouts(const std::vector<std::shared_ptr<runtime::Tensor>>& tvs,
                                        const LayoutDescriptorPtrs& layouts) const;
 
@@ -77,6 +89,19 @@ namespace ngraph
                 void setup_cg_runtime_context();
                 void cleanup_runtime_context();
 
+                /// \brief Allocate the activation buffers and scratchpad of a context. In direct
+                ///        execution mode this happens on the first call that uses the context.
+                void acquire_arena(CPURuntimeContext* ctx);
+                /// \brief Give the activation buffers and scratchpad of a context back to the
+                ///        ArenaPool.
+                void release_arena(CPURuntimeContext* ctx);
+                /// \brief Release the arenas of available contexts last used before idle_since
+                void release_idle_arenas(std::chrono::steady_clock::time_point idle_since);
+
+                /// \brief Report the buffer plan, constant and scratchpad sizes and how many
+                ///        contexts hold an arena
+                MemoryReport get_memory_report() const;
+
             protected:
                 CPU_CallFrame(const CPU_CallFrame&) = delete;
                 CPU_CallFrame(CPU_CallFrame&&) = delete;
@@ -87,15 +112,43 @@ namespace ngraph
                                 const size_t id,
                                 const bool disable_caching = true);
 
+                /// \brief Take an available context, waiting for one if there are none
+                size_t acquire_context();
+                /// \brief Take an available context without waiting
+                /// \returns false if there are none
+                bool try_acquire_context(size_t& id);
+                void release_context(size_t id);
+
+                void run_async_calls();
+
                 std::shared_ptr<CPU_ExternalFunction> m_external_function;
 
+                // Available contexts form a lock-free stack. m_free_ctx holds the index + 1 of
+                // the top context in its low 32 bits, 0 if the stack is empty, and a counter
+                // that changes on every update in its high 32 bits to detect ABA races.
+                // m_next_free_ctx links each context to the one below it.
+                std::atomic<uint64_t> m_free_ctx{0};
+                std::unique_ptr<std::atomic<uint32_t>[]> m_next_free_ctx;
+                // Callers that found no available context wait on m_cv
                 std::mutex m_mutex;
                 std::condition_variable m_cv;
-                volatile size_t m_num_ctx_available = 0;
-                size_t m_prev_ctx = 0;
+                std::atomic<size_t> m_num_waiters{0};
+                std::atomic<size_t> m_prev_ctx{0};
+                // Contexts holding an arena, calls running now and the most that ran at once
+                std::atomic<size_t> m_num_arenas{0};
+                std::atomic<size_t> m_num_running{0};
+                std::atomic<size_t> m_peak_running{0};
                 size_t m_num_ctx = 1;
-                std::unordered_map<size_t, bool> m_id_pool;
                 std::vector<CPURuntimeContext*> m_ctx_vec;
+                std::vector<std::chrono::steady_clock::time_point> m_ctx_last_use;
+                runtime::Allocator* m_allocator = nullptr;
+                size_t m_sweeper_id;
+
+                std::mutex m_async_mutex;
+                std::condition_variable m_async_cv;
+                std::deque<std::function<void()>> m_async_calls;
+                std::vector<std::thread> m_async_workers;
+                bool m_stop_async_workers = false;
 
                 // Codegen specific
 
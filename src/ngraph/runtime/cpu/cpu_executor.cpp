@@ -14,11 +14,13 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <thread>
 
 #include "cpu_executor.hpp"
 
 #include "ngraph/except.hpp"
+#include "ngraph/runtime/cpu/cpu_numa.hpp"
 
 #define MAX_PARALLELISM_THRESHOLD 2
 
@@ -54,6 +56,32 @@ static int GetNumCores()
     return count < 1 ? 1 : count;
 }
 
+enum class NumaMode
+{
+    NONE,
+    PIN,
+    SOCKET
+};
+
+static NumaMode GetNumaMode()
+{
+    const auto ngraph_cpu_numa = std::getenv("NGRAPH_CPU_NUMA");
+    if (ngraph_cpu_numa == nullptr || std::string(ngraph_cpu_numa) == "0")
+    {
+        return NumaMode::NONE;
+    }
+    if (std::string(ngraph_cpu_numa) == "socket")
+    {
+        return NumaMode::SOCKET;
+    }
+    if (std::string(ngraph_cpu_numa) == "1")
+    {
+        return NumaMode::PIN;
+    }
+    throw ngraph::ngraph_error("Unexpected value specified for NGRAPH_CPU_NUMA (" +
+                               std::string(ngraph_cpu_numa) + "). Please specify 0, 1 or socket");
+}
+
 static int GetNumThreadPools()
 {
     const auto ngraph_inter_op_parallelism = std::getenv("NGRAPH_INTER_OP_PARALLELISM");
@@ -63,10 +91,37 @@ static int GetNumThreadPools()
     {
         count = std::atoi(ngraph_inter_op_parallelism);
     }
+    else if (GetNumaMode() == NumaMode::SOCKET)
+    {
+        count = static_cast<int>(ngraph::runtime::cpu::numa::get_num_nodes());
+    }
 
     return count < 1 ? 1 : count;
 }
 
+// Eigen thread environment whose threads run on the CPUs of one NUMA node
+struct NumaThreadEnvironment : Eigen::StlThreadEnvironment
+{
+    explicit NumaThreadEnvironment(int node = -1)
+        : m_node(node)
+    {
+    }
+
+    EnvThread* CreateThread(std::function<void()> f)
+    {
+        int node = m_node;
+        return new EnvThread([node, f]() {
+            if (node >= 0)
+            {
+                ngraph::runtime::cpu::numa::bind_current_thread(node);
+            }
+            f();
+        });
+    }
+
+    int m_node;
+};
+
 namespace ngraph
 {
     namespace runtime
@@ -79,13 +134,23 @@ namespace ngraph
                     : m_num_thread_pools(num_thread_pools)
                 {
                     m_num_cores = GetNumCores();
+                    const auto numa_mode = GetNumaMode();
+                    const int num_numa_nodes = static_cast<int>(numa::get_num_nodes());
                     for (int i = 0; i < num_thread_pools; i++)
                     {
                         int num_threads_per_pool;
+                        int numa_node = numa_mode == NumaMode::NONE ? -1 : i % num_numa_nodes;
+                        m_pool_numa_nodes.push_back(numa_node);
 
                         // Eigen threadpool will still be used for reductions
                         // and other tensor operations that dont use a parallelFor
                         num_threads_per_pool = GetNumCores();
+                        if (numa_node >= 0)
+                        {
+                            // A pinned pool cannot use more CPUs than its node has
+                            num_threads_per_pool = std::max(
+                                1, static_cast<int>(numa::get_node_cpus(numa_node).size()));
+                        }
 
                         // User override
                         char* eigen_tp_count = std::getenv("NGRAPH_CPU_EIGEN_THREAD_COUNT");
@@ -104,8 +169,9 @@ namespace ngraph
                             num_threads_per_pool = tp_count;
                         }
 
-                        m_thread_pools.push_back(std::unique_ptr<Eigen::ThreadPool>(
-                            new Eigen::ThreadPool(num_threads_per_pool)));
+                        m_thread_pools.push_back(std::unique_ptr<Eigen::ThreadPoolInterface>(
+                            new Eigen::ThreadPoolTempl<NumaThreadEnvironment>(
+                                num_threads_per_pool, NumaThreadEnvironment(numa_node))));
                         m_thread_pool_devices.push_back(
                             std::unique_ptr<Eigen::ThreadPoolDevice>(new Eigen::ThreadPoolDevice(
                                 m_thread_pools[i].get(), num_threads_per_pool)));
@@ -140,6 +206,26 @@ namespace ngraph
                 }
 #endif
 
+                int CPUExecutor::get_context_thread_pool(size_t ctx_id) const
+                {
+                    // Without placement every context shares pool 0, as before, so that the
+                    // other pools stay free for concurrent ops
+                    if (m_pool_numa_nodes[0] < 0)
+                    {
+                        return 0;
+                    }
+                    return static_cast<int>(ctx_id % m_num_thread_pools);
+                }
+
+                void CPUExecutor::place_memory(void* ptr, size_t size, int thread_pool_id) const
+                {
+                    int numa_node = m_pool_numa_nodes[thread_pool_id];
+                    if (numa_node >= 0)
+                    {
+                        numa::bind_memory(ptr, size, numa_node);
+                    }
+                }
+
                 CPUExecutor& GetCPUExecutor()
                 {
                     static int num_thread_pools = GetNumThreadPools();
@@ -41,6 +41,14 @@ namespace ngraph
                 extern mkldnn::engine global_cpu_engine;
 
                 // CPUExecutor owns the resources for executing a graph.
+                //
+                // NGRAPH_CPU_NUMA selects the NUMA placement:
+                //   unset or 0 - no placement
+                //   1          - the threads of pool i run on NUMA node i % num_nodes and the
+                //                pool is sized to that node's CPUs, each runtime context runs
+                //                on one pool and its arena is placed on that pool's node
+                //   socket     - as 1, with one pool per node unless
+                //                NGRAPH_INTER_OP_PARALLELISM is set
                 class CPUExecutor
                 {
                 public:
@@ -63,14 +71,22 @@ namespace ngraph
 #endif
                     int get_num_thread_pools() { return m_num_thread_pools; }
                     int get_num_cores() { return m_num_cores; }
+                    // NUMA node the threads of a pool run on, -1 without NUMA placement
+                    int get_thread_pool_numa_node(int id) const { return m_pool_numa_nodes[id]; }
+                    // Pool that runs the ops of runtime context ctx_id of an executable
+                    int get_context_thread_pool(size_t ctx_id) const;
+                    // Place memory used by a pool on that pool's node if NUMA placement is on
+                    void place_memory(void* ptr, size_t size, int thread_pool_id) const;
+
                 private:
-                    std::vector<std::unique_ptr<Eigen::ThreadPool>> m_thread_pools;
+                    std::vector<std::unique_ptr<Eigen::ThreadPoolInterface>> m_thread_pools;
                     std::vector<std::unique_ptr<Eigen::ThreadPoolDevice>> m_thread_pool_devices;
 #if defined(NGRAPH_TBB_ENABLE)
                     std::vector<tbb::task_arena> m_tbb_arenas;
 #endif
                     int m_num_thread_pools;
                     int m_num_cores;
+                    std::vector<int> m_pool_numa_nodes;
                 };
 
                 extern CPUExecutor& GetCPUExecutor();
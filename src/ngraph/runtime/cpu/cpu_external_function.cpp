@@ -22,6 +22,7 @@
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 
 #if defined(NGRAPH_TBB_ENABLE)
 #define TBB_PREVIEW_FLOW_GRAPH_TRACE 1
@@ -205,7 +206,13 @@
 #include "ngraph/runtime/cpu/pass/cpu_mkldnn_primitive_build.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_post_layout_optimizations.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_rnn_fusion.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_shared_constants.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_workspace_insertion.hpp"
+#include "ngraph/serializer.hpp"
+
+#ifndef NGRAPH_JSON_DISABLE
+#include "ngraph/runtime/cpu/cpu_serializer_extension.hpp"
+#endif
 
 using namespace std;
 using namespace ngraph;
@@ -730,6 +737,8 @@ using namespace ngraph::runtime;
         }
     }
 
+    count_constant_bytes();
+
     bool temporaries_used = false;
     for (shared_ptr<Node> node : ordered_ops)
     {
@@ -1318,6 +1327,7 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
         CommonSubexpressionElimination, true, ngraph::pass, runtime::cpu::get_cse_handlers_map())
     REGISTER_KNOBBED_PASS(CPUPostLayoutOptimizations, true, runtime::cpu::pass)
     REGISTER_KNOBBED_PASS(CPUConvertLayoutConstantFolding, true, runtime::cpu::pass)
+    REGISTER_KNOBBED_PASS(CPUSharedConstants, true, runtime::cpu::pass)
     REGISTER_KNOBBED_PASS(CPUMemoryOptimization, true, runtime::cpu::pass)
     REGISTER_KNOBBED_PASS(GetOutputElementElimination, false, ngraph::pass)
     REGISTER_KNOBBED_PASS_WITH_ARGS(
@@ -1455,14 +1465,18 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     static const string s_debug_dir = "cpu_codegen";
     static StaticInitializers s_static_initializers(s_debug_dir);
     m_mkldnn_emitter.reset(new MKLDNNEmitter());
-    ngraph::pass::Manager pass_manager;
-    if (std::getenv("NGRAPH_ENABLE_VISUALIZE_TRACING"))
+    // A loaded function carries the layouts, annotations and memory plan the passes produced
+    if (!m_is_loaded)
     {
-        // Enable per_pass_validation if required for debug purpose
-        pass_manager.set_per_pass_validation(false);
+        ngraph::pass::Manager pass_manager;
+        if (std::getenv("NGRAPH_ENABLE_VISUALIZE_TRACING"))
+        {
+            // Enable per_pass_validation if required for debug purpose
+            pass_manager.set_per_pass_validation(false);
+        }
+        register_common_passes(pass_manager, pass_config);
+        pass_manager.run_passes(m_function, false);
     }
-    register_common_passes(pass_manager, pass_config);
-    pass_manager.run_passes(m_function, false);
 
     static runtime::cpu::CPU_DebugTracer debug_tracer;
     if (std::getenv("NGRAPH_CPU_DEBUG_TRACER") != nullptr)
@@ -1506,6 +1520,8 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         }
     }
 
+    count_constant_bytes();
+
     // Build executor
     size_t buffer_index = 0;
     // Temporaries
@@ -1781,11 +1797,17 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     // This check ensures we have exactly one functor for Op.
     NGRAPH_CHECK(m_op_attrs.size() == functors.size());
 
+    if (std::getenv("NGRAPH_CPU_USE_WORK_STEALING") != nullptr &&
+        executor::GetCPUExecutor().get_num_thread_pools() > 1)
+    {
+        build_scheduler();
+    }
+
     executor = [&](CPURuntimeContext* ctx, vector<void*>& inputs, vector<void*>& outputs) {
         cpu::Timestamp start_ts, end_ts;
         uint64_t profiler_count = 0;
 
-        if (ctx->first_iteration)
+        if (ctx->first_iteration || ctx->new_arena)
         {
             for (auto& p : intermediates_offsets)
             {
@@ -1830,7 +1852,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                         new tbb::flow::continue_node<tbb::flow::continue_msg>(
                             *(ctx->G),
                             [&, functor, index](const tbb::flow::continue_msg& /* msg */) {
-                                if (p(ctx) || ctx->first_iteration)
+                                if (p(ctx) || ctx->first_iteration || ctx->new_arena)
                                 {
                                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                                     {
@@ -1920,6 +1942,59 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         }
         else
 #endif
+            if (m_scheduler && !ctx->first_iteration && ctx->pc == 0 &&
+                ctx->breakpoints.empty() && !debug_tracer.tracing_is_enabled())
+        {
+            // The first iteration builds the MKLDNN primitives and runs in order. Breakpoints
+            // and the debug tracer need the sequential program counter as well.
+            bool new_arena = ctx->new_arena;
+            m_scheduler->run([&](size_t index, size_t worker) {
+                if (enables[index](ctx) || new_arena)
+                {
+                    cpu::Timestamp op_start_ts;
+                    if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+                    {
+                        op_start_ts = cpu::Clock::now();
+                    }
+                    // Each worker runs its ops on its own thread pool
+                    CPUExecutionContext ectx{static_cast<int>(worker)};
+                    executor::GetCPUExecutor().execute(functors[index], ctx, &ectx);
+                    if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+                    {
+                        auto op_end_ts = cpu::Clock::now();
+                        if (runtime::cpu::IsTracingEnabled())
+                        {
+                            ctx->op_durations[index] =
+                                (std::chrono::duration_cast<cpu::Timescale>(op_end_ts -
+                                                                            op_start_ts))
+                                    .count();
+                        }
+                        if (m_emit_timing)
+                        {
+                            m_perf_counters[index].m_total_microseconds +=
+                                std::chrono::duration_cast<std::chrono::microseconds>(
+                                    op_end_ts - op_start_ts)
+                                    .count();
+                            m_perf_counters[index].m_call_count++;
+                        }
+                    }
+                }
+                else
+                {
+                    if (runtime::cpu::IsTracingEnabled())
+                    {
+                        ctx->op_durations[index] = 0;
+                    }
+                    if (m_emit_timing)
+                    {
+                        m_perf_counters[index].m_call_count++;
+                    }
+                }
+            });
+            ctx->pc = functors.size();
+            profiler_count = functors.size();
+        }
+        else
         {
             static const auto ddebug = std::getenv("NGRAPH_DEX_DEBUG");
             if (ddebug != nullptr)
@@ -1954,7 +2029,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
             for (; ctx->pc < functors.size(); ctx->pc++)
             {
                 auto index = profiler_count++;
-                if ((enables.at(ctx->pc))(ctx) || ctx->first_iteration)
+                if ((enables.at(ctx->pc))(ctx) || ctx->first_iteration || ctx->new_arena)
                 {
                     // Each Op will have exactly one functor, start the clock before the exceution
                     // of functor
@@ -1964,7 +2039,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                         start_ts = cpu::Clock::now();
                     }
 
-                    CPUExecutionContext ectx{0};
+                    CPUExecutionContext ectx{ctx->thread_pool};
 
                     if (debug_tracer.tracing_is_enabled())
                     {
@@ -2018,6 +2093,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
             }
         }
         ctx->first_iteration = false;
+        ctx->new_arena = false;
         if (runtime::cpu::IsTracingEnabled())
         {
             NGRAPH_CHECK(m_op_attrs.size() == profiler_count);
@@ -2037,6 +2113,98 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     }
 }
 
+void runtime::cpu::CPU_ExternalFunction::build_scheduler()
+{
+    // A region is (space, offset, size, is_write). Space 0 is the intermediate pool, then one
+    // space per input and one per output. Constants are never written and are left out.
+    using Region = tuple<size_t, size_t, size_t, bool>;
+    unordered_map<size_t, size_t> buffer_spaces;
+    for (const auto& p : intermediates_offsets)
+    {
+        buffer_spaces[p.first] = 0;
+    }
+    size_t num_args = m_function->get_parameters().size();
+    for (const auto& p : function_input_index_offset)
+    {
+        buffer_spaces[get<0>(p)] = 1 + get<1>(p);
+    }
+    for (const auto& p : function_output_index_offset)
+    {
+        buffer_spaces[get<0>(p)] = 1 + num_args + get<1>(p);
+    }
+    size_t serial_space = 1 + num_args + m_function->get_output_size();
+
+    vector<vector<Region>> op_regions;
+    vector<size_t> costs;
+    for (shared_ptr<Node> node : m_function->get_ordered_ops())
+    {
+        if (node->is_parameter() || node->is_constant())
+        {
+            continue;
+        }
+        vector<Region> regions;
+        auto add_region = [&](const descriptor::Tensor& tensor, bool is_write) {
+            auto it = buffer_spaces.find(get_buffer_index(tensor.get_name()));
+            if (it != buffer_spaces.end())
+            {
+                regions.emplace_back(it->second, tensor.get_pool_offset(), tensor.size(), is_write);
+            }
+        };
+        for (const descriptor::Input& input : node->get_inputs())
+        {
+            add_region(input.get_output().get_tensor(), false);
+        }
+        size_t cost = 0;
+        for (const descriptor::Output& output : node->get_outputs())
+        {
+            add_region(output.get_tensor(), true);
+            cost += output.get_tensor().size();
+        }
+        if (runtime::cpu::mkldnn_utils::use_mkldnn_kernel(node.get()) ||
+            is_type<runtime::cpu::op::ConvertLayout>(node) || node->has_state())
+        {
+            regions.emplace_back(serial_space, 0, 1, true);
+        }
+        op_regions.push_back(move(regions));
+        costs.push_back(cost);
+    }
+    NGRAPH_CHECK(op_regions.size() == functors.size());
+
+    auto conflict = [](const Region& a, const Region& b) {
+        return (get<3>(a) || get<3>(b)) && get<0>(a) == get<0>(b) &&
+               get<1>(a) < get<1>(b) + get<2>(b) && get<1>(b) < get<1>(a) + get<2>(a);
+    };
+    vector<vector<size_t>> dependencies(op_regions.size());
+    for (size_t j = 0; j < op_regions.size(); j++)
+    {
+        for (size_t i = 0; i < j; i++)
+        {
+            bool found = false;
+            for (const auto& a : op_regions[i])
+            {
+                for (const auto& b : op_regions[j])
+                {
+                    if (conflict(a, b))
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                if (found)
+                {
+                    break;
+                }
+            }
+            if (found)
+            {
+                dependencies[j].push_back(i);
+            }
+        }
+    }
+    m_scheduler.reset(new CPUScheduler(
+        dependencies, costs, executor::GetCPUExecutor().get_num_thread_pools()));
+}
+
 size_t runtime::cpu::CPU_ExternalFunction::get_buffer_index(const std::string& name)
 {
     if (tensor_alias.count(name))
@@ -2062,6 +2230,52 @@ bool runtime::cpu::CPU_ExternalFunction::is_codegen(const ngraph::pass::PassConf
     return false;
 }
 
+bool runtime::cpu::CPU_ExternalFunction::uses_direct_execution(
+    const ngraph::pass::PassConfig& pass_config)
+{
+#if defined(NGRAPH_DEX_ONLY)
+    (void)pass_config;
+    return true;
+#else
+    const char* codegen = std::getenv("NGRAPH_CODEGEN");
+    return !is_codegen(pass_config) && (codegen == nullptr || std::string(codegen) == "0");
+#endif
+}
+
+void runtime::cpu::CPU_ExternalFunction::save(ostream& out)
+{
+#ifndef NGRAPH_JSON_DISABLE
+    NGRAPH_CHECK(m_is_built && m_direct_execution,
+                 "Only functions built for direct execution can be saved");
+    NGRAPH_CHECK(m_function, "The function was released after it was built");
+    CPUSerializerExtension extension(bufferID_to_tensorSets, tensor_to_bufferID);
+    serialize_binary(out, m_function, extension);
+#else
+    (void)out;
+    throw ngraph_error("serializer disabled in build");
+#endif
+}
+
+shared_ptr<runtime::cpu::CPU_ExternalFunction>
+    runtime::cpu::CPU_ExternalFunction::load(istream& in)
+{
+#ifndef NGRAPH_JSON_DISABLE
+    CPUSerializerExtension::BufferSets buffer_sets;
+    CPUSerializerExtension::TensorBufferIDs tensor_buffer_ids;
+    CPUSerializerExtension extension(buffer_sets, tensor_buffer_ids);
+    shared_ptr<Function> function = deserialize(in, extension);
+    auto external_function = make_shared<CPU_ExternalFunction>(function, false);
+    external_function->bufferID_to_tensorSets = move(buffer_sets);
+    external_function->tensor_to_bufferID = move(tensor_buffer_ids);
+    external_function->m_direct_execution = true;
+    external_function->m_is_loaded = true;
+    return external_function;
+#else
+    (void)in;
+    throw ngraph_error("serializer disabled in build");
+#endif
+}
+
 shared_ptr<ngraph::runtime::cpu::CPU_CallFrame>
     runtime::cpu::CPU_ExternalFunction::make_call_frame(ngraph::pass::PassConfig& pass_config,
                                                         Allocator* allocator)
@@ -2074,7 +2288,7 @@ shared_ptr<ngraph::runtime::cpu::CPU_CallFrame>
     }
 #else
     // Override DEX if pass_config requests CODEGEN
-    if (is_codegen(pass_config))
+    if (is_codegen(pass_config) && !m_is_loaded)
     {
         m_direct_execution = false;
     }
@@ -2315,3 +2529,19 @@ std::unordered_set<descriptor::Tensor*>&
     NGRAPH_CHECK(output_buffer_it != bufferID_to_tensorSets.end());
     return output_buffer_it->second.second;
 }
+
+void runtime::cpu::CPU_ExternalFunction::count_constant_bytes()
+{
+    // Constants interned by the WeightPool can share their data
+    std::unordered_set<const void*> buffers;
+    m_constant_bytes = 0;
+    for (auto& node : m_function->get_ordered_ops())
+    {
+        auto constant = as_type_ptr<ngraph::op::Constant>(node);
+        if (constant && buffers.insert(constant->get_data_ptr()).second)
+        {
+            m_constant_bytes +=
+                constant->get_element_type().size() * shape_size(constant->get_shape());
+        }
+    }
+}
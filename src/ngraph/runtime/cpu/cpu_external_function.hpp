@@ -17,9 +17,11 @@
 #pragma once
 
 #include <functional>
+#include <istream>
 #include <list>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
@@ -42,6 +44,7 @@
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_debug_tracer.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
+#include "ngraph/runtime/cpu/cpu_scheduler.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view_wrapper.hpp"
 #include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
@@ -127,6 +130,8 @@ namespace ngraph
                 {
                     return m_memory_buffer_sizes;
                 }
+                /// \brief Size of the constant data, each buffer shared by constants counted once
+                size_t get_constant_bytes() const { return m_constant_bytes; }
                 const std::vector<OpAttributes>& get_op_attrs() const { return m_op_attrs; }
                 const std::unique_ptr<MKLDNNEmitter>& get_mkldnn_emitter() const
                 {
@@ -180,6 +185,16 @@ namespace ngraph
 
                 const std::vector<PerformanceCounter>& get_perf_counters();
 
+                /// \brief Writes the function as the passes left it, with its tensor layouts,
+                ///        op annotations and memory plan. Only functions built for DEX can be
+                ///        saved.
+                void save(std::ostream& out);
+                /// \brief Reads a function written by save. It is built for DEX without running
+                ///        the passes again.
+                static std::shared_ptr<CPU_ExternalFunction> load(std::istream& in);
+                /// \brief Whether functions compiled with pass_config are built for DEX
+                static bool uses_direct_execution(const ngraph::pass::PassConfig& pass_config);
+
             protected:
                 void build(ngraph::pass::PassConfig& pass_config);
 
@@ -195,6 +210,11 @@ namespace ngraph
                                      CPURuntimeContext* ctx,
                                      bool is_it_input);
 
+                /// \brief Create m_scheduler with an edge between every pair of ops whose
+                ///        memory accesses conflict. Ops that use MKLDNN or have state are
+                ///        serialized, since they share the scratchpad and the state.
+                void build_scheduler();
+
             private:
                 // Register passes that are common to codegen and DEX
                 void register_common_passes(ngraph::pass::Manager& pass_manager,
@@ -237,6 +257,7 @@ namespace ngraph
                 static bool is_codegen(const ngraph::pass::PassConfig& pc);
                 std::unordered_set<descriptor::Tensor*>&
                     get_tensor_set(descriptor::Tensor* output_tensor);
+                void count_constant_bytes();
 
                 std::shared_ptr<ngraph::Function> m_function;
                 bool m_release_function;
@@ -249,6 +270,8 @@ namespace ngraph
                 bool m_is_compiled;
 #endif
                 bool m_direct_execution;
+                /// The function was read by load and the passes have already run on it
+                bool m_is_loaded = false;
 
                 /// Function that initializes the context used in codegen mode.
                 InitContextFuncCG m_compiled_init_ctx_func;
@@ -268,6 +291,7 @@ namespace ngraph
                 LayoutDescriptorPtrs parameter_layout_descriptors;
                 LayoutDescriptorPtrs result_layout_descriptors;
                 std::vector<size_t> m_memory_buffer_sizes;
+                size_t m_constant_bytes = 0;
                 std::vector<OpAttributes> m_op_attrs;
 
                 std::unique_ptr<MKLDNNEmitter> m_mkldnn_emitter;
@@ -281,6 +305,9 @@ namespace ngraph
                     enable_nodename_list;
                 std::function<void(CPURuntimeContext*, std::vector<void*>&, std::vector<void*>&)>
                     executor;
+                /// Runs independent ops concurrently in DEX mode when NGRAPH_CPU_USE_WORK_STEALING
+                /// is set and there is more than one thread pool, null otherwise.
+                std::unique_ptr<CPUScheduler> m_scheduler;
                 // name of a tensor and index into the cpu_runtime_context's buffer_data vector to
                 // get the tensor
                 std::unordered_map<std::string, size_t> m_buffer_indices;
@@ -0,0 +1,190 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "ngraph/runtime/cpu/cpu_numa.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    struct Topology
+    {
+        /// \brief Kernel ids of the nodes, empty if NUMA is not available
+        vector<int> node_ids;
+        vector<vector<int>> node_cpus;
+    };
+
+    /// \brief Parse a sysfs list such as "0-3,8,10-11"
+    vector<int> parse_list(const string& list)
+    {
+        vector<int> result;
+        stringstream ss(list);
+        string range;
+        while (getline(ss, range, ','))
+        {
+            auto dash = range.find('-');
+            try
+            {
+                int first = stoi(range.substr(0, dash));
+                int last = dash == string::npos ? first : stoi(range.substr(dash + 1));
+                for (int i = first; i <= last; i++)
+                {
+                    result.push_back(i);
+                }
+            }
+            catch (const exception&)
+            {
+                // Trailing newline or malformed entry
+            }
+        }
+        return result;
+    }
+
+    string read_line(const string& path)
+    {
+        ifstream in(path);
+        string line;
+        getline(in, line);
+        return line;
+    }
+
+    Topology read_topology()
+    {
+        Topology topology;
+#if defined(__linux__)
+        const string root = "/sys/devices/system/node/";
+        for (int id : parse_list(read_line(root + "online")))
+        {
+            auto cpus = parse_list(read_line(root + "node" + to_string(id) + "/cpulist"));
+            // Memory-only nodes cannot run pools
+            if (!cpus.empty())
+            {
+                topology.node_ids.push_back(id);
+                topology.node_cpus.push_back(cpus);
+            }
+        }
+#endif
+        if (topology.node_ids.empty())
+        {
+            vector<int> cpus;
+            for (int i = 0; i < static_cast<int>(thread::hardware_concurrency()); i++)
+            {
+                cpus.push_back(i);
+            }
+            topology.node_cpus.push_back(cpus);
+        }
+        return topology;
+    }
+
+    const Topology& get_topology()
+    {
+        static const Topology topology = read_topology();
+        return topology;
+    }
+}
+
+size_t runtime::cpu::numa::get_num_nodes()
+{
+    return get_topology().node_cpus.size();
+}
+
+const vector<int>& runtime::cpu::numa::get_node_cpus(size_t node)
+{
+    const auto& topology = get_topology();
+    return topology.node_cpus.at(node % topology.node_cpus.size());
+}
+
+bool runtime::cpu::numa::bind_current_thread(size_t node)
+{
+#if defined(__linux__)
+    const auto& topology = get_topology();
+    if (topology.node_ids.empty())
+    {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : get_node_cpus(node))
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+bool runtime::cpu::numa::bind_memory(void* ptr, size_t size, size_t node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    const auto& topology = get_topology();
+    if (topology.node_ids.empty() || ptr == nullptr)
+    {
+        return false;
+    }
+    int node_id = topology.node_ids[node % topology.node_ids.size()];
+    constexpr size_t bits_per_word = 8 * sizeof(unsigned long);
+    constexpr size_t max_nodes = 1024;
+    if (node_id < 0 || static_cast<size_t>(node_id) >= max_nodes)
+    {
+        return false;
+    }
+    unsigned long mask[max_nodes / bits_per_word] = {};
+    mask[node_id / bits_per_word] = 1UL << (node_id % bits_per_word);
+
+    // mbind works on whole pages; leave out the partial pages at both ends, which may be
+    // shared with other allocations
+    uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(ptr) + page_size - 1) & ~(page_size - 1);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(page_size - 1);
+    if (end <= begin)
+    {
+        return true;
+    }
+    const int mpol_preferred = 1;
+    const unsigned mpol_mf_move = 1 << 1;
+    // The kernel reads one bit less than maxnode
+    return syscall(SYS_mbind,
+                   begin,
+                   end - begin,
+                   mpol_preferred,
+                   mask,
+                   max_nodes + 1,
+                   mpol_mf_move) == 0;
+#else
+    (void)ptr;
+    (void)size;
+    (void)node;
+    return false;
+#endif
+}
@@ -0,0 +1,50 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief NUMA topology and placement helpers. They read the topology from sysfs and
+            ///        call the kernel directly, so they need no NUMA library. Where NUMA is not
+            ///        available the machine is reported as a single node holding every CPU and
+            ///        the binding functions do nothing.
+            namespace numa
+            {
+                /// \brief Number of NUMA nodes, at least 1
+                CPU_BACKEND_API size_t get_num_nodes();
+                /// \brief CPUs of a node
+                CPU_BACKEND_API const std::vector<int>& get_node_cpus(size_t node);
+                /// \brief Restrict the calling thread to the CPUs of a node
+                /// \returns false if the affinity could not be set
+                CPU_BACKEND_API bool bind_current_thread(size_t node);
+                /// \brief Prefer a node for the pages fully inside [ptr, ptr + size), moving the
+                ///        pages that are already placed elsewhere.
+                /// \returns false if the policy could not be set
+                CPU_BACKEND_API bool bind_memory(void* ptr, size_t size, size_t node);
+            }
+        }
+    }
+}
@@ -71,6 +71,13 @@ namespace ngraph
                 std::vector<AlignedBuffer*> memory_buffers;
                 std::vector<mkldnn::memory::desc*> mkldnn_scratchpad_mds;
                 AlignedBuffer* scratchpad_buffer;
+                // memory_buffers and scratchpad_buffer are allocated
+                bool has_arena;
+                // the arena was allocated since the last call, so intermediates must be rebound
+                // and cached results recomputed
+                bool new_arena;
+                // Eigen thread pool that runs the ops when they are executed in order
+                int thread_pool;
                 std::vector<char*> mkldnn_workspaces;
 #if defined(NGRAPH_TBB_ENABLE)
                 tbb::flow::graph* G;
@@ -0,0 +1,274 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+
+#include "ngraph/check.hpp"
+#include "ngraph/runtime/cpu/cpu_scheduler.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::cpu::CPUScheduler::CPUScheduler(const vector<vector<size_t>>& dependencies,
+                                         const vector<size_t>& costs,
+                                         size_t num_workers)
+    : m_dependents(dependencies.size())
+    , m_num_dependencies(dependencies.size())
+    , m_priorities(costs)
+    , m_num_workers(max<size_t>(1, num_workers))
+{
+    NGRAPH_CHECK(costs.size() == dependencies.size(), "Expected one cost per op");
+    for (size_t op = 0; op < dependencies.size(); op++)
+    {
+        vector<size_t> op_dependencies = dependencies[op];
+        sort(op_dependencies.begin(), op_dependencies.end());
+        op_dependencies.erase(unique(op_dependencies.begin(), op_dependencies.end()),
+                              op_dependencies.end());
+        for (size_t dependency : op_dependencies)
+        {
+            NGRAPH_CHECK(dependency < op, "Op ", op, " depends on the later op ", dependency);
+            m_dependents[dependency].push_back(op);
+        }
+        m_num_dependencies[op] = op_dependencies.size();
+        if (op_dependencies.empty())
+        {
+            m_roots.push_back(op);
+        }
+    }
+    // Dependents have larger indices, so their priorities are final when an op is visited
+    for (size_t op = dependencies.size(); op-- > 0;)
+    {
+        size_t max_priority = 0;
+        for (size_t dependent : m_dependents[op])
+        {
+            max_priority = max(max_priority, m_priorities[dependent]);
+        }
+        m_priorities[op] += max_priority;
+    }
+
+    for (size_t worker = 1; worker < m_num_workers; worker++)
+    {
+        m_workers.emplace_back([this, worker]() { run_worker(worker); });
+    }
+}
+
+runtime::cpu::CPUScheduler::~CPUScheduler()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+vector<size_t> runtime::cpu::CPUScheduler::get_priority_order() const
+{
+    vector<size_t> order(m_priorities.size());
+    for (size_t op = 0; op < order.size(); op++)
+    {
+        order[op] = op;
+    }
+    stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return m_priorities[a] > m_priorities[b];
+    });
+    return order;
+}
+
+void runtime::cpu::CPUScheduler::run(const function<void(size_t op, size_t worker)>& run_op)
+{
+    size_t num_ops = m_num_dependencies.size();
+    if (num_ops == 0)
+    {
+        return;
+    }
+    auto run = make_shared<Run>();
+    run->run_op = &run_op;
+    run->num_waiting.reset(new atomic<size_t>[num_ops]);
+    for (size_t op = 0; op < num_ops; op++)
+    {
+        run->num_waiting[op] = m_num_dependencies[op];
+    }
+    run->queues.reset(new Queue[m_num_workers]);
+    run->num_unfinished = num_ops;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_runs.push_back(run);
+    }
+    vector<size_t> roots = m_roots;
+    push(*run, 0, roots);
+    notify();
+
+    while (run->num_unfinished > 0)
+    {
+        size_t op;
+        if (take(*run, 0, op))
+        {
+            execute(*run, op, 0);
+            continue;
+        }
+        // The remaining ops are running on other workers or wait for them
+        unique_lock<mutex> lock(m_mutex);
+        m_cv.wait(lock, [&run]() { return run->num_unfinished == 0 || run->num_ready > 0; });
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_runs.remove(run);
+    }
+    if (run->error)
+    {
+        rethrow_exception(run->error);
+    }
+}
+
+bool runtime::cpu::CPUScheduler::take(Run& run, size_t worker, size_t& op)
+{
+    bool found = false;
+    {
+        Queue& queue = run.queues[worker];
+        lock_guard<mutex> lock(queue.mutex);
+        if (!queue.ops.empty())
+        {
+            op = queue.ops.back();
+            queue.ops.pop_back();
+            found = true;
+        }
+    }
+    for (size_t i = 1; i < m_num_workers && !found; i++)
+    {
+        Queue& queue = run.queues[(worker + i) % m_num_workers];
+        lock_guard<mutex> lock(queue.mutex);
+        if (!queue.ops.empty())
+        {
+            op = queue.ops.front();
+            queue.ops.pop_front();
+            found = true;
+        }
+    }
+    if (found)
+    {
+        run.num_ready--;
+        m_num_ready--;
+    }
+    return found;
+}
+
+void runtime::cpu::CPUScheduler::execute(Run& run, size_t op, size_t worker)
+{
+    if (!run.failed)
+    {
+        try
+        {
+            (*run.run_op)(op, worker);
+        }
+        catch (...)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (!run.error)
+            {
+                run.error = current_exception();
+            }
+            run.failed = true;
+        }
+    }
+
+    vector<size_t> ready;
+    for (size_t dependent : m_dependents[op])
+    {
+        if (run.num_waiting[dependent].fetch_sub(1) == 1)
+        {
+            ready.push_back(dependent);
+        }
+    }
+    if (!ready.empty())
+    {
+        push(run, worker, ready);
+    }
+    if (run.num_unfinished.fetch_sub(1) == 1)
+    {
+        notify();
+    }
+}
+
+void runtime::cpu::CPUScheduler::push(Run& run, size_t worker, vector<size_t>& ops)
+{
+    sort(ops.begin(), ops.end(), [this](size_t a, size_t b) {
+        return m_priorities[a] < m_priorities[b];
+    });
+    // The counters are raised before the ops can be taken, so that take never lowers them
+    // below zero
+    run.num_ready += ops.size();
+    m_num_ready += ops.size();
+    {
+        Queue& queue = run.queues[worker];
+        lock_guard<mutex> lock(queue.mutex);
+        queue.ops.insert(queue.ops.end(), ops.begin(), ops.end());
+    }
+    // The pushing worker takes one of the ops itself
+    if (ops.size() > 1)
+    {
+        notify();
+    }
+}
+
+void runtime::cpu::CPUScheduler::notify()
+{
+    {
+        // Waiters check their condition under the lock, so taking it here ensures that none
+        // of them misses the change made before this call
+        lock_guard<mutex> lock(m_mutex);
+    }
+    m_cv.notify_all();
+}
+
+void runtime::cpu::CPUScheduler::run_worker(size_t worker)
+{
+    while (true)
+    {
+        shared_ptr<Run> run;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || m_num_ready > 0; });
+            if (m_stop)
+            {
+                return;
+            }
+            for (auto& candidate : m_runs)
+            {
+                if (candidate->num_ready > 0)
+                {
+                    run = candidate;
+                    break;
+                }
+            }
+        }
+        size_t op;
+        if (!run || !take(*run, worker, op))
+        {
+            // The counters are raised just before the ops are added to the queues
+            this_thread::yield();
+            continue;
+        }
+        do
+        {
+            execute(*run, op, worker);
+        } while (take(*run, worker, op));
+    }
+}
@@ -0,0 +1,115 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Work-stealing scheduler that runs the ops of a function concurrently in
+            ///        dependency order.
+            ///
+            /// Every worker has its own queue of ready ops. When an op finishes, the ops that
+            /// only waited for it are pushed onto the queue of the worker that ran it, which
+            /// continues with the one with the highest priority. Idle workers steal the
+            /// lowest-priority op from the other queues. The priority of an op is its cost
+            /// plus the largest priority of the ops that depend on it, so the most expensive
+            /// chain of ops is started first.
+            ///
+            /// Worker 0 is the thread that calls run. The other workers are threads owned by
+            /// the scheduler, which serve all runs in progress.
+            class CPU_BACKEND_API CPUScheduler
+            {
+            public:
+                /// \param dependencies For each op, the ops it must wait for, all of which have
+                ///        smaller indices
+                /// \param costs Estimated cost of each op
+                /// \param num_workers Number of ops that may run at once
+                CPUScheduler(const std::vector<std::vector<size_t>>& dependencies,
+                             const std::vector<size_t>& costs,
+                             size_t num_workers);
+                ~CPUScheduler();
+
+                /// \brief Call run_op(op, worker) for every op and wait for all of them.
+                ///
+                /// If run_op throws, the ops that have not started are skipped and the first
+                /// exception is rethrown.
+                void run(const std::function<void(size_t op, size_t worker)>& run_op);
+
+                size_t get_num_workers() const { return m_num_workers; }
+                /// \brief Ops in the order of their priority, highest first
+                std::vector<size_t> get_priority_order() const;
+
+            private:
+                struct Queue
+                {
+                    std::mutex mutex;
+                    std::deque<size_t> ops;
+                };
+
+                struct Run
+                {
+                    const std::function<void(size_t, size_t)>* run_op;
+                    std::unique_ptr<std::atomic<size_t>[]> num_waiting;
+                    std::unique_ptr<Queue[]> queues;
+                    std::atomic<size_t> num_ready{0};
+                    std::atomic<size_t> num_unfinished{0};
+                    std::atomic<bool> failed{false};
+                    std::exception_ptr error;
+                };
+
+                /// \brief Take an op from the queue of worker, or steal one from another queue
+                bool take(Run& run, size_t worker, size_t& op);
+                /// \brief Run op and make the ops waiting only for it ready
+                void execute(Run& run, size_t op, size_t worker);
+                /// \brief Push ready ops onto the queue of worker, highest priority last
+                void push(Run& run, size_t worker, std::vector<size_t>& ops);
+                void notify();
+                void run_worker(size_t worker);
+
+                std::vector<std::vector<size_t>> m_dependents;
+                std::vector<size_t> m_num_dependencies;
+                std::vector<size_t> m_priorities;
+                std::vector<size_t> m_roots;
+                size_t m_num_workers;
+
+                std::mutex m_mutex;
+                std::condition_variable m_cv;
+                std::list<std::shared_ptr<Run>> m_runs;
+                std::atomic<size_t> m_num_ready{0};
+                bool m_stop = false;
+                std::vector<std::thread> m_workers;
+            };
+        }
+    }
+}
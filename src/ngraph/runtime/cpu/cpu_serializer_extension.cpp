@@ -0,0 +1,574 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <array>
+
+#include "ngraph/check.hpp"
+#include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
+#include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
+#include "ngraph/runtime/cpu/cpu_serializer_extension.hpp"
+#include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
+#include "ngraph/runtime/cpu/op/bounded_relu.hpp"
+#include "ngraph/runtime/cpu/op/conv_add.hpp"
+#include "ngraph/runtime/cpu/op/conv_relu.hpp"
+#include "ngraph/runtime/cpu/op/convert_layout.hpp"
+#include "ngraph/runtime/cpu/op/deconv.hpp"
+#include "ngraph/runtime/cpu/op/dropout.hpp"
+#include "ngraph/runtime/cpu/op/gelu_backprop.hpp"
+#include "ngraph/runtime/cpu/op/group_conv_bias.hpp"
+#include "ngraph/runtime/cpu/op/leaky_relu.hpp"
+#include "ngraph/runtime/cpu/op/lstm.hpp"
+#include "ngraph/runtime/cpu/op/matmul_bias.hpp"
+#include "ngraph/runtime/cpu/op/max_pool_with_indices.hpp"
+#include "ngraph/runtime/cpu/op/quantized_matmul.hpp"
+#include "ngraph/runtime/cpu/op/rnn.hpp"
+#include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
+#include "ngraph/runtime/cpu/op/update_slice.hpp"
+
+using namespace ngraph;
+using namespace std;
+using json = nlohmann::json;
+
+// MKLDNN memory descriptors are plain structs and are stored as their bytes, which is only valid
+// for the MKLDNN version that wrote them. CPU_Backend::load checks the version.
+static string to_hex(const void* data, size_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    string hex;
+    hex.reserve(size * 2);
+    for (size_t i = 0; i < size; i++)
+    {
+        hex.push_back(digits[bytes[i] >> 4]);
+        hex.push_back(digits[bytes[i] & 0xf]);
+    }
+    return hex;
+}
+
+static void from_hex(const string& hex, void* data, size_t size)
+{
+    NGRAPH_CHECK(hex.size() == size * 2,
+                 "Expected ",
+                 size * 2,
+                 " hexadecimal digits but found ",
+                 hex.size());
+    auto digit = [&](char c) -> unsigned char {
+        if (c >= '0' && c <= '9')
+        {
+            return static_cast<unsigned char>(c - '0');
+        }
+        NGRAPH_CHECK(c >= 'a' && c <= 'f', "Invalid hexadecimal digit '", c, "'");
+        return static_cast<unsigned char>(c - 'a' + 10);
+    };
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        bytes[i] = static_cast<unsigned char>(digit(hex[2 * i]) << 4 | digit(hex[2 * i + 1]));
+    }
+}
+
+static json write_layout(const runtime::cpu::LayoutDescriptor& layout)
+{
+    json layout_js;
+    layout_js["strides"] = layout.get_strides();
+    if (layout.is_mkldnn_layout())
+    {
+        const auto& md = layout.get_mkldnn_md().data;
+        layout_js["mkldnn_md"] = to_hex(&md, sizeof(md));
+    }
+    return layout_js;
+}
+
+static shared_ptr<runtime::cpu::LayoutDescriptor> read_layout(const descriptor::Tensor& tensor,
+                                                              const json& layout_js)
+{
+    auto layout = make_shared<runtime::cpu::LayoutDescriptor>(tensor);
+    Strides strides = layout_js.at("strides").get<vector<size_t>>();
+    layout->set_strides(strides);
+    if (layout_js.count("mkldnn_md") != 0)
+    {
+        mkldnn_memory_desc_t md;
+        from_hex(layout_js.at("mkldnn_md").get<string>(), &md, sizeof(md));
+        layout->set_mkldnn_md(mkldnn::memory::desc(md));
+    }
+    return layout;
+}
+
+static json write_element_type(const element::Type& type)
+{
+    return static_cast<int>(static_cast<element::Type_t>(type));
+}
+
+static element::Type read_element_type(const json& j)
+{
+    return element::Type(static_cast<element::Type_t>(j.get<int>()));
+}
+
+runtime::cpu::CPUSerializerExtension::CPUSerializerExtension(BufferSets& buffer_sets,
+                                                             TensorBufferIDs& tensor_buffer_ids)
+    : m_buffer_sets(buffer_sets)
+    , m_tensor_buffer_ids(tensor_buffer_ids)
+{
+}
+
+bool runtime::cpu::CPUSerializerExtension::serialize_op(const Node& n, json& node)
+{
+    if (auto tmp = as_type<const ngraph::op::BatchNormTrainingRelu>(&n))
+    {
+        node["eps"] = tmp->get_eps_value();
+    }
+    else if (auto tmp = as_type<const ngraph::op::BatchNormInferenceRelu>(&n))
+    {
+        node["eps"] = tmp->get_eps_value();
+    }
+    else if (auto tmp = as_type<const ngraph::op::BoundedRelu>(&n))
+    {
+        node["alpha"] = tmp->get_alpha();
+    }
+    else if (auto tmp = as_type<const ngraph::op::ConvolutionAdd>(&n))
+    {
+        node["window_movement_strides"] = tmp->get_window_movement_strides();
+        node["window_dilation_strides"] = tmp->get_window_dilation_strides();
+        node["padding_below"] = tmp->get_padding_below();
+        node["padding_above"] = tmp->get_padding_above();
+        node["data_dilation_strides"] = tmp->get_data_dilation_strides();
+        node["with_relu"] = tmp->with_relu();
+    }
+    else if (auto tmp = as_type<const ngraph::op::ConvolutionRelu>(&n))
+    {
+        node["window_movement_strides"] = tmp->get_window_movement_strides();
+        node["window_dilation_strides"] = tmp->get_window_dilation_strides();
+        node["padding_below"] = tmp->get_padding_below();
+        node["padding_above"] = tmp->get_padding_above();
+        node["data_dilation_strides"] = tmp->get_data_dilation_strides();
+    }
+    else if (is_type<const runtime::cpu::op::ConvertLayout>(&n))
+    {
+        // The layout is the one of the output, which is part of the node state
+        node["element_type"] = write_element_type(n.get_output_element_type(0));
+        node["shape"] = n.get_output_shape(0);
+    }
+    else if (auto tmp = as_type<const ngraph::op::DeconvolutionBias>(&n))
+    {
+        node["data_batch_shape"] = tmp->get_data_batch_shape();
+        node["window_movement_strides_forward"] = tmp->get_window_movement_strides_forward();
+        node["window_dilation_strides_forward"] = tmp->get_window_dilation_strides_forward();
+        node["padding_below_forward"] = tmp->get_padding_below_forward();
+        node["padding_above_forward"] = tmp->get_padding_above_forward();
+        node["data_dilation_strides_forward"] = tmp->get_data_dilation_strides_forward();
+        node["with_relu"] = tmp->with_relu();
+    }
+    else if (is_type<const ngraph::op::Dropout>(&n) || is_type<const ngraph::op::GeluBackprop>(&n))
+    {
+        // Dropout takes its attributes as inputs
+    }
+    else if (auto tmp = as_type<const ngraph::op::GroupConvolutionBias>(&n))
+    {
+        node["window_movement_strides"] = tmp->get_window_movement_strides();
+        node["window_dilation_strides"] = tmp->get_window_dilation_strides();
+        node["padding_below"] = tmp->get_padding_below();
+        node["padding_above"] = tmp->get_padding_above();
+        node["data_dilation_strides"] = tmp->get_data_dilation_strides();
+        node["groups"] = tmp->get_groups();
+        node["output_shape"] = tmp->get_output_shape(0);
+        node["with_relu"] = tmp->with_relu();
+        node["alpha"] = tmp->get_alpha();
+    }
+    else if (auto tmp = as_type<const ngraph::op::CPULeakyRelu>(&n))
+    {
+        node["alpha"] = tmp->get_alpha();
+    }
+    else if (auto tmp = as_type<const ngraph::op::Lstm>(&n))
+    {
+        node["rnn_type"] = static_cast<int>(tmp->get_rnn_type());
+    }
+    else if (auto tmp = as_type<const ngraph::op::MatmulBias>(&n))
+    {
+        node["shape_w"] = tmp->get_a_shape();
+        node["shape_x"] = tmp->get_b_shape();
+        node["transpose_w"] = tmp->get_is_a_transposed();
+        node["transpose_x"] = tmp->get_is_b_transposed();
+        node["broadcast_axes"] = tmp->get_broadcast_axes();
+    }
+    else if (auto tmp = as_type<const ngraph::op::MaxPoolWithIndices>(&n))
+    {
+        node["window_shape"] = tmp->get_window_shape();
+        node["window_movement_strides"] = tmp->get_window_movement_strides();
+        node["padding_below"] = tmp->get_padding_below();
+        node["padding_above"] = tmp->get_padding_above();
+    }
+    else if (auto tmp = as_type<const ngraph::op::MaxPoolWithIndicesBackprop>(&n))
+    {
+        node["window_shape"] = tmp->get_window_shape();
+        node["window_movement_strides"] = tmp->get_window_movement_strides();
+        node["padding_below"] = tmp->get_padding_below();
+        node["padding_above"] = tmp->get_padding_above();
+    }
+    else if (auto tmp = as_type<const ngraph::op::QuantizedMatmul>(&n))
+    {
+        node["output_type"] = write_element_type(tmp->get_output_type());
+    }
+    else if (auto tmp = as_type<const ngraph::op::Rnn>(&n))
+    {
+        node["num_timesteps"] = tmp->get_num_timesteps();
+        node["num_gates_per_cell"] = tmp->get_gates_per_cell();
+        node["src_sequence_length"] = tmp->get_src_sequence_length();
+        node["num_cell_states"] = tmp->get_num_cell_states();
+        node["direction"] = tmp->get_direction();
+        node["num_fused_layers"] = tmp->get_num_fused_layers();
+        node["rnn_type"] = static_cast<int>(tmp->get_rnn_type());
+    }
+    else if (auto tmp = as_type<const ngraph::op::SigmoidMultiply>(&n))
+    {
+        node["input_0_type"] = static_cast<int>(tmp->get_input_func_type(0));
+        node["input_1_type"] = static_cast<int>(tmp->get_input_func_type(1));
+    }
+    else if (auto tmp = as_type<const ngraph::op::SigmoidMultiplyBackprop>(&n))
+    {
+        node["input_0_type"] = static_cast<int>(tmp->get_input_func_type(0));
+        node["input_1_type"] = static_cast<int>(tmp->get_input_func_type(1));
+    }
+    else if (auto tmp = as_type<const ngraph::op::UpdateSlice>(&n))
+    {
+        node["lower_bounds"] = tmp->get_lower_bounds();
+        node["upper_bounds"] = tmp->get_upper_bounds();
+        node["strides"] = tmp->get_strides();
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+shared_ptr<Node> runtime::cpu::CPUSerializerExtension::deserialize_op(const NodeTypeInfo& type_info,
+                                                                      const OutputVector& args,
+                                                                      const json& node_js)
+{
+    shared_ptr<Node> node;
+    if (type_info == ngraph::op::BatchNormTrainingRelu::type_info)
+    {
+        node = make_shared<ngraph::op::BatchNormTrainingRelu>(
+            node_js.at("eps").get<double>(), args.at(0), args.at(1), args.at(2));
+    }
+    else if (type_info == ngraph::op::BatchNormInferenceRelu::type_info)
+    {
+        node = make_shared<ngraph::op::BatchNormInferenceRelu>(node_js.at("eps").get<double>(),
+                                                       args.at(0),
+                                                       args.at(1),
+                                                       args.at(2),
+                                                       args.at(3),
+                                                       args.at(4));
+    }
+    else if (type_info == ngraph::op::BoundedRelu::type_info)
+    {
+        node = make_shared<ngraph::op::BoundedRelu>(args.at(0), node_js.at("alpha").get<float>());
+    }
+    else if (type_info == ngraph::op::ConvolutionAdd::type_info)
+    {
+        node = make_shared<ngraph::op::ConvolutionAdd>(
+            args.at(0),
+            args.at(1),
+            args.at(2),
+            node_js.at("window_movement_strides").get<vector<size_t>>(),
+            node_js.at("window_dilation_strides").get<vector<size_t>>(),
+            node_js.at("padding_below").get<vector<std::ptrdiff_t>>(),
+            node_js.at("padding_above").get<vector<std::ptrdiff_t>>(),
+            node_js.at("data_dilation_strides").get<vector<size_t>>(),
+            node_js.at("with_relu").get<bool>());
+    }
+    else if (type_info == ngraph::op::ConvolutionRelu::type_info)
+    {
+        node = make_shared<ngraph::op::ConvolutionRelu>(
+            args.at(0),
+            args.at(1),
+            node_js.at("window_movement_strides").get<vector<size_t>>(),
+            node_js.at("window_dilation_strides").get<vector<size_t>>(),
+            node_js.at("padding_below").get<vector<std::ptrdiff_t>>(),
+            node_js.at("padding_above").get<vector<std::ptrdiff_t>>(),
+            node_js.at("data_dilation_strides").get<vector<size_t>>());
+    }
+    else if (type_info == runtime::cpu::op::ConvertLayout::type_info)
+    {
+        descriptor::Tensor tensor(read_element_type(node_js.at("element_type")),
+                                  Shape(node_js.at("shape").get<vector<size_t>>()),
+                                  "");
+        auto layout = read_layout(
+            tensor, node_js.at("backend_state").at("outputs").at(0).at("layout"));
+        node = make_shared<runtime::cpu::op::ConvertLayout>(
+            args.at(0), args.at(0).get_index(), layout);
+    }
+    else if (type_info == ngraph::op::DeconvolutionBias::type_info)
+    {
+        node = make_shared<ngraph::op::DeconvolutionBias>(
+            node_js.at("data_batch_shape").get<vector<size_t>>(),
+            args.at(0),
+            args.at(1),
+            args.at(2),
+            node_js.at("window_movement_strides_forward").get<vector<size_t>>(),
+            node_js.at("window_dilation_strides_forward").get<vector<size_t>>(),
+            node_js.at("padding_below_forward").get<vector<std::ptrdiff_t>>(),
+            node_js.at("padding_above_forward").get<vector<std::ptrdiff_t>>(),
+            node_js.at("data_dilation_strides_forward").get<vector<size_t>>(),
+            node_js.at("with_relu").get<bool>());
+    }
+    else if (type_info == ngraph::op::Dropout::type_info)
+    {
+        node = make_shared<ngraph::op::Dropout>(args.at(0), args.at(1), args.at(2), args.at(3), args.at(4));
+    }
+    else if (type_info == ngraph::op::GeluBackprop::type_info)
+    {
+        node = make_shared<ngraph::op::GeluBackprop>(args.at(0), args.at(1));
+    }
+    else if (type_info == ngraph::op::GroupConvolutionBias::type_info)
+    {
+        node = make_shared<ngraph::op::GroupConvolutionBias>(
+            args.at(0),
+            args.at(1),
+            args.at(2),
+            node_js.at("window_movement_strides").get<vector<size_t>>(),
+            node_js.at("window_dilation_strides").get<vector<size_t>>(),
+            node_js.at("padding_below").get<vector<std::ptrdiff_t>>(),
+            node_js.at("padding_above").get<vector<std::ptrdiff_t>>(),
+            node_js.at("data_dilation_strides").get<vector<size_t>>(),
+            node_js.at("groups").get<size_t>(),
+            node_js.at("output_shape").get<vector<size_t>>(),
+            node_js.at("with_relu").get<bool>(),
+            node_js.at("alpha").get<float>());
+    }
+    else if (type_info == ngraph::op::CPULeakyRelu::type_info)
+    {
+        node = make_shared<ngraph::op::CPULeakyRelu>(args.at(0), node_js.at("alpha").get<float>());
+    }
+    else if (type_info == ngraph::op::Lstm::type_info)
+    {
+        auto rnn_type =
+            static_cast<runtime::cpu::rnn_utils::rnntype>(node_js.at("rnn_type").get<int>());
+#if MKLDNN_VERSION_MAJOR < 1
+        node = make_shared<ngraph::op::Lstm>(
+            args.at(0), args.at(1), args.at(2), args.at(3), args.at(4), rnn_type);
+#else
+        node = make_shared<ngraph::op::Lstm>(
+            args.at(0), args.at(1), args.at(2), args.at(3), args.at(4), args.at(5), rnn_type);
+#endif
+    }
+    else if (type_info == ngraph::op::MatmulBias::type_info)
+    {
+        node = make_shared<ngraph::op::MatmulBias>(args.at(0),
+                                           args.at(1),
+                                           args.size() == 3 ? args.at(2) : Output<Node>(),
+                                           node_js.at("shape_w").get<vector<size_t>>(),
+                                           node_js.at("shape_x").get<vector<size_t>>(),
+                                           node_js.at("transpose_w").get<bool>(),
+                                           node_js.at("transpose_x").get<bool>(),
+                                           node_js.at("broadcast_axes").get<set<size_t>>());
+    }
+    else if (type_info == ngraph::op::MaxPoolWithIndices::type_info)
+    {
+        node = make_shared<ngraph::op::MaxPoolWithIndices>(
+            args.at(0),
+            node_js.at("window_shape").get<vector<size_t>>(),
+            node_js.at("window_movement_strides").get<vector<size_t>>(),
+            node_js.at("padding_below").get<vector<size_t>>(),
+            node_js.at("padding_above").get<vector<size_t>>());
+    }
+    else if (type_info == ngraph::op::MaxPoolWithIndicesBackprop::type_info)
+    {
+        node = make_shared<ngraph::op::MaxPoolWithIndicesBackprop>(
+            args.at(0),
+            args.at(1),
+            args.at(2),
+            node_js.at("window_shape").get<vector<size_t>>(),
+            node_js.at("window_movement_strides").get<vector<size_t>>(),
+            node_js.at("padding_below").get<vector<size_t>>(),
+            node_js.at("padding_above").get<vector<size_t>>());
+    }
+    else if (type_info == ngraph::op::QuantizedMatmul::type_info)
+    {
+        node = make_shared<ngraph::op::QuantizedMatmul>(
+            args.at(0), args.at(1), args.at(2), read_element_type(node_js.at("output_type")));
+    }
+    else if (type_info == ngraph::op::Rnn::type_info)
+    {
+        auto num_timesteps = node_js.at("num_timesteps").get<size_t>();
+        auto num_gates_per_cell = node_js.at("num_gates_per_cell").get<size_t>();
+        auto src_sequence_length = node_js.at("src_sequence_length").get<size_t>();
+        auto num_cell_states = node_js.at("num_cell_states").get<size_t>();
+        auto direction = node_js.at("direction").get<size_t>();
+        auto num_fused_layers = node_js.at("num_fused_layers").get<size_t>();
+        auto rnn_type =
+            static_cast<runtime::cpu::rnn_utils::rnntype>(node_js.at("rnn_type").get<int>());
+#if MKLDNN_VERSION_MAJOR < 1
+        node = make_shared<ngraph::op::Rnn>(args.at(0),
+                                    args.at(1),
+                                    args.at(2),
+                                    args.at(3),
+                                    args.at(4),
+                                    num_timesteps,
+                                    num_gates_per_cell,
+                                    src_sequence_length,
+                                    num_cell_states,
+                                    direction,
+                                    num_fused_layers,
+                                    rnn_type);
+#else
+        node = make_shared<ngraph::op::Rnn>(args.at(0),
+                                    args.at(1),
+                                    args.at(2),
+                                    args.at(3),
+                                    args.at(4),
+                                    args.at(5),
+                                    num_timesteps,
+                                    num_gates_per_cell,
+                                    src_sequence_length,
+                                    num_cell_states,
+                                    direction,
+                                    num_fused_layers,
+                                    rnn_type);
+#endif
+    }
+    else if (type_info == ngraph::op::SigmoidMultiply::type_info)
+    {
+        using FunctionType = ngraph::op::SigmoidMultiply::FunctionType;
+        node = make_shared<ngraph::op::SigmoidMultiply>(
+            args.at(0),
+            args.at(1),
+            static_cast<FunctionType>(node_js.at("input_0_type").get<int>()),
+            static_cast<FunctionType>(node_js.at("input_1_type").get<int>()));
+    }
+    else if (type_info == ngraph::op::SigmoidMultiplyBackprop::type_info)
+    {
+        using FunctionType = ngraph::op::SigmoidMultiply::FunctionType;
+        std::array<FunctionType, 2> input_type{
+            {static_cast<FunctionType>(node_js.at("input_0_type").get<int>()),
+             static_cast<FunctionType>(node_js.at("input_1_type").get<int>())}};
+        node = make_shared<ngraph::op::SigmoidMultiplyBackprop>(
+            args.at(0), args.at(1), args.at(2), input_type);
+    }
+    else if (type_info == ngraph::op::UpdateSlice::type_info)
+    {
+        node = make_shared<ngraph::op::UpdateSlice>(args.at(0),
+                                            args.at(1),
+                                            node_js.at("lower_bounds").get<vector<size_t>>(),
+                                            node_js.at("upper_bounds").get<vector<size_t>>(),
+                                            node_js.at("strides").get<vector<size_t>>());
+    }
+    return node;
+}
+
+json runtime::cpu::CPUSerializerExtension::serialize_state(const Node& node)
+{
+    json state;
+    if (auto annotations = node.get_op_annotations())
+    {
+        auto cpu_annotations = dynamic_pointer_cast<CPUOpAnnotations>(annotations);
+        json annotations_js;
+        annotations_js["mkldnn_op"] = cpu_annotations && cpu_annotations->is_mkldnn_op();
+        annotations_js["cacheable"] = annotations->is_cacheable();
+        json in_place_oi_pairs = json::array();
+        for (auto& oi_pair : annotations->get_in_place_oi_pairs())
+        {
+            json oi_pair_js;
+            oi_pair_js["output"] = oi_pair.output;
+            oi_pair_js["input"] = oi_pair.input;
+            oi_pair_js["destructive"] = oi_pair.destructive;
+            in_place_oi_pairs.push_back(oi_pair_js);
+        }
+        annotations_js["in_place_oi_pairs"] = in_place_oi_pairs;
+        state["annotations"] = annotations_js;
+    }
+
+    json outputs = json::array();
+    for (size_t i = 0; i < node.get_output_size(); ++i)
+    {
+        descriptor::Tensor& tensor = node.get_output_tensor(i);
+        json output;
+        output["pool_offset"] = tensor.get_pool_offset();
+        auto buffer_id = m_tensor_buffer_ids.find(&tensor);
+        if (buffer_id != m_tensor_buffer_ids.end())
+        {
+            output["buffer_id"] = buffer_id->second;
+            output["tensor_role"] =
+                static_cast<int>(m_buffer_sets.at(buffer_id->second).first);
+        }
+        if (auto layout = dynamic_pointer_cast<LayoutDescriptor>(tensor.get_tensor_layout()))
+        {
+            output["layout"] = write_layout(*layout);
+        }
+        outputs.push_back(output);
+    }
+    state["outputs"] = outputs;
+    return state;
+}
+
+void runtime::cpu::CPUSerializerExtension::deserialize_state(Node& node, const json& state)
+{
+    shared_ptr<CPUOpAnnotations> annotations;
+    if (state.count("annotations") != 0)
+    {
+        const json& annotations_js = state.at("annotations");
+        annotations = make_shared<CPUOpAnnotations>();
+        annotations->set_mkldnn_op(annotations_js.at("mkldnn_op").get<bool>());
+        annotations->set_cacheable(annotations_js.at("cacheable").get<bool>());
+        for (const json& oi_pair_js : annotations_js.at("in_place_oi_pairs"))
+        {
+            annotations->add_in_place_oi_pair({oi_pair_js.at("output").get<size_t>(),
+                                               oi_pair_js.at("input").get<size_t>(),
+                                               oi_pair_js.at("destructive").get<bool>()});
+        }
+    }
+    node.set_op_annotations(annotations);
+
+    const json& outputs = state.at("outputs");
+    NGRAPH_CHECK(outputs.size() == node.get_output_size(),
+                 "State of ",
+                 node.description(),
+                 " has ",
+                 outputs.size(),
+                 " outputs but the node has ",
+                 node.get_output_size());
+    for (size_t i = 0; i < node.get_output_size(); ++i)
+    {
+        const json& output = outputs.at(i);
+        descriptor::Tensor& tensor = node.get_output_tensor(i);
+        tensor.set_pool_offset(output.at("pool_offset").get<size_t>());
+        if (output.count("buffer_id") != 0)
+        {
+            size_t buffer_id = output.at("buffer_id").get<size_t>();
+            auto& buffer_set = m_buffer_sets[buffer_id];
+            buffer_set.first = static_cast<TensorRole>(output.at("tensor_role").get<int>());
+            buffer_set.second.insert(&tensor);
+            m_tensor_buffer_ids[&tensor] = buffer_id;
+        }
+        if (output.count("layout") != 0)
+        {
+            tensor.set_tensor_layout(read_layout(tensor, output.at("layout")));
+        }
+    }
+}
+
+json runtime::cpu::CPUSerializerExtension::serialize_state(const Function& function)
+{
+    json state;
+    state["temporary_pool_size"] = function.get_temporary_pool_size();
+    return state;
+}
+
+void runtime::cpu::CPUSerializerExtension::deserialize_state(Function& function,
+                                                             const json& state)
+{
+    function.set_temporary_pool_size(state.at("temporary_pool_size").get<size_t>());
+}
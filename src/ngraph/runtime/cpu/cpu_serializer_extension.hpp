@@ -0,0 +1,66 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "ngraph/descriptor/tensor.hpp"
+#include "ngraph/serializer_extension.hpp"
+#include "ngraph/util.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Serializes a function after the CPU passes have run: the CPU backend ops,
+            ///        the tensor layouts, op annotations and pool offsets, and the buffer sets
+            ///        assigned by CPUMemoryAssignment
+            class CPUSerializerExtension : public ngraph::SerializerExtension
+            {
+            public:
+                using BufferSets = std::unordered_map<
+                    size_t,
+                    std::pair<ngraph::TensorRole, std::unordered_set<descriptor::Tensor*>>>;
+                using TensorBufferIDs = std::unordered_map<descriptor::Tensor*, size_t>;
+
+                /// \param buffer_sets Buffer sets of the serialized function, filled in when
+                ///        deserializing
+                /// \param tensor_buffer_ids Buffer set of each tensor, filled in when
+                ///        deserializing
+                CPUSerializerExtension(BufferSets& buffer_sets, TensorBufferIDs& tensor_buffer_ids);
+
+                bool serialize_op(const Node& node, nlohmann::json& node_js) override;
+                std::shared_ptr<Node> deserialize_op(const NodeTypeInfo& type_info,
+                                                     const OutputVector& args,
+                                                     const nlohmann::json& node_js) override;
+                nlohmann::json serialize_state(const Node& node) override;
+                void deserialize_state(Node& node, const nlohmann::json& state) override;
+                nlohmann::json serialize_state(const Function& function) override;
+                void deserialize_state(Function& function, const nlohmann::json& state) override;
+
+            private:
+                BufferSets& m_buffer_sets;
+                TensorBufferIDs& m_tensor_buffer_ids;
+            };
+        }
+    }
+}
@@ -0,0 +1,120 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cstring>
+
+#include "ngraph/runtime/cpu/cpu_weight_pool.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static size_t get_data_size(const op::Constant& constant)
+{
+    return shape_size(constant.get_shape()) * constant.get_element_type().size();
+}
+
+static size_t hash_constant(const op::Constant& constant)
+{
+    // Over the element type, shape and data
+    FNV1aHash hash;
+    hash.add(static_cast<uint64_t>(static_cast<element::Type_t>(constant.get_element_type())));
+    for (size_t dim : constant.get_shape())
+    {
+        hash.add(dim);
+    }
+    hash.add_bytes(constant.get_data_ptr(), get_data_size(constant));
+    return static_cast<size_t>(hash.get());
+}
+
+runtime::cpu::WeightPool& runtime::cpu::WeightPool::get()
+{
+    static WeightPool pool;
+    return pool;
+}
+
+shared_ptr<op::Constant>
+    runtime::cpu::WeightPool::intern(const shared_ptr<op::Constant>& constant)
+{
+    const auto& buffer = constant->get_data_buffer();
+    if (!buffer)
+    {
+        return constant;
+    }
+    size_t size = get_data_size(*constant);
+    size_t hash = hash_constant(*constant);
+
+    lock_guard<mutex> lock(m_mutex);
+    auto range = m_entries.equal_range(hash);
+    for (auto it = range.first; it != range.second;)
+    {
+        auto data = it->second.data.lock();
+        if (!data)
+        {
+            it = m_entries.erase(it);
+            continue;
+        }
+        if (data == buffer)
+        {
+            return constant;
+        }
+        if (it->second.element_type == constant->get_element_type() &&
+            it->second.shape == constant->get_shape() &&
+            memcmp(data->get_ptr(), constant->get_data_ptr(), size) == 0)
+        {
+            m_hits++;
+            return make_shared<op::Constant>(
+                constant->get_element_type(), constant->get_shape(), data);
+        }
+        ++it;
+    }
+
+    m_entries.emplace(hash, Entry{constant->get_element_type(), constant->get_shape(), buffer});
+    if (m_entries.size() > m_prune_threshold)
+    {
+        prune();
+        m_prune_threshold = max<size_t>(64, 2 * m_entries.size());
+    }
+    return constant;
+}
+
+runtime::cpu::WeightPool::Statistics runtime::cpu::WeightPool::get_statistics()
+{
+    lock_guard<mutex> lock(m_mutex);
+    prune();
+    Statistics statistics{m_entries.size(), 0, m_hits};
+    for (auto& entry : m_entries)
+    {
+        statistics.bytes += shape_size(entry.second.shape) * entry.second.element_type.size();
+    }
+    return statistics;
+}
+
+void runtime::cpu::WeightPool::prune()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (it->second.data.expired())
+        {
+            it = m_entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
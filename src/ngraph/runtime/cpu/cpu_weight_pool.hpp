@@ -0,0 +1,78 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "ngraph/op/constant.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Process-wide pool of immutable constant data.
+            ///
+            /// Constants with equal element type, shape and contents are stored once and shared
+            /// by every CPU executable and runtime context that uses them, including weights that
+            /// were converted to an MKLDNN layout at compile time. The pool only holds weak
+            /// references, so data is released when the last constant using it is destroyed.
+            class CPU_BACKEND_API WeightPool
+            {
+            public:
+                struct Statistics
+                {
+                    /// \brief Number of distinct live buffers in the pool
+                    size_t entries;
+                    /// \brief Total size of the live buffers
+                    size_t bytes;
+                    /// \brief Number of intern calls that found an existing buffer
+                    size_t hits;
+                };
+
+                static WeightPool& get();
+
+                /// \brief Return a constant equal to constant whose data is shared with all
+                ///        other interned constants of equal value. If there are none, constant
+                ///        is added to the pool and returned.
+                std::shared_ptr<op::Constant> intern(const std::shared_ptr<op::Constant>& constant);
+
+                Statistics get_statistics();
+
+            private:
+                struct Entry
+                {
+                    element::Type element_type;
+                    Shape shape;
+                    std::weak_ptr<AlignedBuffer> data;
+                };
+
+                void prune();
+
+                std::mutex m_mutex;
+                std::unordered_multimap<size_t, Entry> m_entries;
+                size_t m_prune_threshold = 64;
+                size_t m_hits = 0;
+            };
+        }
+    }
+}
@@ -0,0 +1,50 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/runtime/cpu/pass/cpu_shared_constants.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/runtime/cpu/cpu_weight_pool.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+bool runtime::cpu::pass::CPUSharedConstants::run_on_function(shared_ptr<Function> function)
+{
+    auto& pool = runtime::cpu::WeightPool::get();
+    bool replaced = false;
+    for (auto& node : function->get_ordered_ops())
+    {
+        auto constant = as_type_ptr<op::Constant>(node);
+        if (!constant)
+        {
+            continue;
+        }
+        auto shared = pool.intern(constant);
+        if (shared != constant)
+        {
+            // Keep the layout chosen for the original, which may be an MKLDNN weight layout
+            if (auto layout = constant->get_output_tensor_ptr(0)->get_tensor_layout())
+            {
+                shared->get_output_tensor_ptr(0)->set_tensor_layout(layout);
+            }
+            shared->set_op_annotations(constant->get_op_annotations());
+            replace_node(constant, shared);
+            replaced = true;
+        }
+    }
+    return replaced;
+}
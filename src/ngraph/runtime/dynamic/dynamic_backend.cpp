@@ -14,6 +14,9 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <chrono>
+#include <cstring>
+
 #include "ngraph/runtime/dynamic/dynamic_backend.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/op/avg_pool.hpp"
@@ -32,12 +35,21 @@
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/opset0_downgrade.hpp"
 #include "ngraph/pass/shape_relevance.hpp"
+#include "ngraph/runtime/host_tensor.hpp"
 #include "ngraph/specialize_function.hpp"
+#include "ngraph/strided_iterator.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
 using namespace ngraph;
 
+// Number of fallback executables kept per DynamicExecutable
+static const size_t s_fallback_cache_size = 16;
+// Number of unpadded output shapes kept per DynamicExecutable for slicing bucketed outputs
+static const size_t s_output_shape_cache_size = 1024;
+// Number of idle sets of staging tensors kept per DynamicExecutable for padding bucketed inputs
+static const size_t s_staging_cache_size = 16;
+
 runtime::dynamic::DynamicBackend::DynamicBackend(shared_ptr<runtime::Backend> wrapped_backend)
     : m_wrapped_backend(std::move(wrapped_backend))
 {
@@ -66,24 +78,136 @@ shared_ptr<runtime::Executable>
     runtime::dynamic::DynamicBackend::compile(shared_ptr<Function> function,
                                               bool enable_performance_collection)
 {
-    return make_shared<runtime::dynamic::DynamicExecutable>(
-        function, m_wrapped_backend, enable_performance_collection);
+    return make_shared<runtime::dynamic::DynamicExecutable>(function,
+                                                            m_wrapped_backend,
+                                                            enable_performance_collection,
+                                                            m_shape_buckets,
+                                                            m_fallback_backend);
+}
+
+bool runtime::dynamic::DynamicBackend::set_config(const map<string, string>& config,
+                                                  string& error)
+{
+    map<string, string> wrapped_config = config;
+    auto it = wrapped_config.find("shape_buckets");
+    if (it != wrapped_config.end())
+    {
+        ShapeBuckets shape_buckets;
+        try
+        {
+            for (const string& entry : split(it->second, ';', true))
+            {
+                if (entry.empty())
+                {
+                    continue;
+                }
+                vector<string> axis_and_sizes = split(entry, ':', true);
+                if (axis_and_sizes.size() != 2)
+                {
+                    error = "Invalid shape_buckets entry '" + entry + "'";
+                    return false;
+                }
+                vector<size_t>& sizes = shape_buckets[parse_string<size_t>(axis_and_sizes[0])];
+                for (const string& size : split(axis_and_sizes[1], ',', true))
+                {
+                    sizes.push_back(parse_string<size_t>(size));
+                }
+                sort(sizes.begin(), sizes.end());
+                sizes.erase(unique(sizes.begin(), sizes.end()), sizes.end());
+            }
+        }
+        catch (const exception& e)
+        {
+            error = e.what();
+            return false;
+        }
+        m_shape_buckets = shape_buckets;
+        wrapped_config.erase(it);
+    }
+    it = wrapped_config.find("compile_fallback");
+    if (it != wrapped_config.end())
+    {
+        shared_ptr<runtime::Backend> fallback_backend;
+        if (!it->second.empty())
+        {
+            try
+            {
+                fallback_backend = runtime::Backend::create(it->second);
+            }
+            catch (const exception& e)
+            {
+                error = e.what();
+                return false;
+            }
+            if (fallback_backend == nullptr)
+            {
+                error = "Unknown compile_fallback backend '" + it->second + "'";
+                return false;
+            }
+        }
+        m_fallback_backend = fallback_backend;
+        wrapped_config.erase(it);
+    }
+    if (wrapped_config.empty() && !config.empty())
+    {
+        error = "";
+        return true;
+    }
+    return m_wrapped_backend->set_config(wrapped_config, error);
 }
 
-runtime::dynamic::DynamicExecutable::DynamicExecutable(shared_ptr<Function> wrapped_function,
-                                                       shared_ptr<runtime::Backend> wrapped_backend,
-                                                       bool enable_performance_collection)
+runtime::dynamic::DynamicExecutable::DynamicExecutable(
+    shared_ptr<Function> wrapped_function,
+    shared_ptr<runtime::Backend> wrapped_backend,
+    bool enable_performance_collection,
+    const ShapeBuckets& shape_buckets,
+    shared_ptr<runtime::Backend> fallback_backend)
     : m_wrapped_function(wrapped_function)
     , m_wrapped_backend(wrapped_backend)
     , m_enable_performance_collection(enable_performance_collection)
+    , m_shape_buckets(shape_buckets)
+    , m_fallback_backend(fallback_backend)
 {
     pass::Manager passes;
     passes.register_pass<pass::ShapeRelevance>();
     passes.run_passes(m_wrapped_function);
 
+    if (m_fallback_backend)
+    {
+        // Fallback executables only serve specializations whose compilation is still pending
+        m_fallback_lru = make_shared<runtime::LRUCache>(s_fallback_cache_size, 0);
+    }
+
+    if (!m_shape_buckets.empty())
+    {
+        bool has_shape_relevant_parameters = false;
+        for (auto& parameter : m_wrapped_function->get_parameters())
+        {
+            has_shape_relevant_parameters |= parameter->is_relevant_to_shapes();
+        }
+        if (!has_shape_relevant_parameters)
+        {
+            m_shape_function = clone_function(*m_wrapped_function);
+        }
+    }
+
     set_parameters_and_results(*wrapped_function);
 }
 
+runtime::dynamic::DynamicExecutable::~DynamicExecutable()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_background_mutex);
+        m_stop_background = true;
+    }
+    m_background_cv.notify_all();
+    if (m_background_thread.joinable())
+    {
+        // Compilations still queued are dropped, which breaks their futures
+        m_background_thread.join();
+    }
+}
+
 // Due to clang++-3.9 bugs, this needs to be a non-static separate function from
 // count_dyn_nodes.
 bool is_dynamic_op(const std::shared_ptr<Node>& op)
@@ -115,209 +239,775 @@ bool runtime::dynamic::DynamicExecutable::call(
     const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
     const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
 {
-    // TODO: Get cached executable out if it exists.
-    // We will cache on:
-    // (1) all shapes;
-    // (2) all values of shape-relevant input tensors.
+    return m_shape_buckets.empty() ? call_specialized(outputs, inputs)
+                                   : call_bucketed(outputs, inputs);
+}
 
-    std::vector<int> merged_input_shapes;
-    std::ostringstream key;
-    size_t loop_count = 0;
-    for (auto& input : inputs)
+// Copy the leading corner of shape `shape` from a row-major tensor of shape src_shape into a
+// row-major tensor of shape dst_shape. Used to pad inputs to, and slice outputs from, bucketed
+// shapes.
+static void copy_corner(const char* src,
+                        const Shape& src_shape,
+                        char* dst,
+                        const Shape& dst_shape,
+                        const Shape& shape,
+                        size_t element_size)
+{
+    Strides src_strides = row_major_strides(src_shape);
+    Strides dst_strides = row_major_strides(dst_shape);
+    for (StridedIterator it(shape, {src_strides, dst_strides}); !it.done(); it.next_row())
     {
-        if (m_wrapped_function->get_parameters()[loop_count]->is_relevant_to_shapes())
+        memcpy(dst + it.get_offset(1) * element_size,
+               src + it.get_offset(0) * element_size,
+               it.get_inner_size() * element_size);
+    }
+}
+
+// Memory of a tensor that can be addressed directly, nullptr if the tensor is not a HostTensor
+static char* get_host_data(const std::shared_ptr<runtime::Tensor>& tensor)
+{
+    std::shared_ptr<runtime::Tensor> host_tensor = tensor;
+    if (auto dynamic_tensor = std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(tensor))
+    {
+        host_tensor = dynamic_tensor->get_wrapped_tensor();
+    }
+    auto rc = std::dynamic_pointer_cast<runtime::HostTensor>(host_tensor);
+    return rc ? rc->get_data_ptr() : nullptr;
+}
+
+bool runtime::dynamic::DynamicExecutable::call_bucketed(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
+{
+    NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == inputs.size());
+
+    bool padded = false;
+    std::vector<Shape> bucketed_shapes;
+    // Staging tensors are shared by all calls whose inputs pad to the same shapes
+    CacheKey staging_key;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        const std::shared_ptr<runtime::Tensor>& input = inputs[i];
+        const std::shared_ptr<op::Parameter>& parameter = m_wrapped_function->get_parameters()[i];
+        const Shape& shape = input->get_shape();
+        Shape bucketed_shape = shape;
+        const PartialShape& parameter_shape = parameter->get_partial_shape();
+        for (auto& axis_buckets : m_shape_buckets)
         {
-            // Caching on values of Shape relevant inputs
-            int size = input->get_size_in_bytes() / (input->get_element_type().bitwidth() / 8);
-            std::vector<int64_t> data(size);
-            input->read(data.data(), input->get_size_in_bytes());
-            for (int i = 0; i < input->get_element_count(); i++)
+            size_t axis = axis_buckets.first;
+            const std::vector<size_t>& buckets = axis_buckets.second;
+            // Only dimensions the function leaves dynamic, such as batch or sequence length,
+            // are bucketed. Inputs with a static size on the axis, such as weights, are not.
+            if (parameter->is_relevant_to_shapes() || axis >= shape.size() ||
+                (parameter_shape.rank().is_static() && parameter_shape[axis].is_static()))
             {
-                merged_input_shapes.emplace_back(data[i]);
+                continue;
+            }
+            auto bucket = std::lower_bound(buckets.begin(), buckets.end(), shape[axis]);
+            if (bucket != buckets.end() && *bucket != shape[axis])
+            {
+                bucketed_shape[axis] = *bucket;
+                padded = true;
             }
         }
+        staging_key.push_back(
+            static_cast<int64_t>(static_cast<element::Type_t>(input->get_element_type())));
+        staging_key.insert(staging_key.end(), bucketed_shape.begin(), bucketed_shape.end());
+        staging_key.push_back(-1);
+        bucketed_shapes.push_back(bucketed_shape);
+    }
+
+    if (!padded)
+    {
+        return call_specialized(outputs, inputs);
+    }
+
+    // Outputs are sliced back to the shapes the function infers for the unpadded inputs, so
+    // only the output axes that actually depend on a padded input axis are trimmed
+    std::vector<Shape> output_shapes = get_output_shapes(inputs);
+
+    std::unique_ptr<StagingTensors> staging =
+        acquire_staging_tensors(staging_key, inputs.size());
+    std::vector<std::shared_ptr<runtime::Tensor>> bucketed_inputs;
+    std::vector<char> input_data;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        const std::shared_ptr<runtime::Tensor>& input = inputs[i];
+        const Shape& shape = input->get_shape();
+        const Shape& bucketed_shape = bucketed_shapes[i];
+        if (bucketed_shape == shape)
+        {
+            bucketed_inputs.push_back(input);
+            continue;
+        }
+
+        const element::Type& type = input->get_element_type();
+        std::shared_ptr<runtime::Tensor>& staged_input = staging->inputs[i];
+        if (staged_input == nullptr)
+        {
+            staged_input = m_wrapped_backend->create_tensor(type, bucketed_shape);
+        }
+        // Pad straight into the staging tensor when its memory is addressable, and otherwise
+        // into a host copy that is written to it
+        size_t bucketed_size = shape_size(bucketed_shape) * type.size();
+        char* padded_data = get_host_data(staged_input);
+        bool write_padded_data = (padded_data == nullptr);
+        if (write_padded_data)
+        {
+            staging->host_inputs[i].resize(bucketed_size);
+            padded_data = staging->host_inputs[i].data();
+        }
+        // The padding only needs clearing when the unpadded extent changes, as calls do not
+        // write to their inputs
+        if (staging->filled_shapes[i] != shape)
+        {
+            memset(padded_data, 0, bucketed_size);
+            staging->filled_shapes[i] = shape;
+        }
+        const char* data = get_host_data(input);
+        if (data == nullptr)
+        {
+            input_data.resize(input->get_size_in_bytes());
+            input->read(input_data.data(), input_data.size());
+            data = input_data.data();
+        }
+        copy_corner(data, shape, padded_data, bucketed_shape, shape, type.size());
+        if (write_padded_data)
+        {
+            staged_input->write(padded_data, bucketed_size);
+        }
+        bucketed_inputs.push_back(staged_input);
+    }
+
+    std::vector<std::shared_ptr<runtime::Tensor>> bucketed_outputs;
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        bucketed_outputs.push_back(make_shared<DynamicTensor>(
+            element::dynamic, PartialShape::dynamic(), m_wrapped_backend));
+    }
+    bool rc = call_specialized(bucketed_outputs, bucketed_inputs);
+    release_staging_tensors(std::move(staging));
+
+    std::vector<char> bucketed_data;
+    std::vector<char> data;
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        const std::shared_ptr<runtime::Tensor>& bucketed_output = bucketed_outputs[i];
+        const element::Type& type = bucketed_output->get_element_type();
+        const Shape& bucketed_shape = bucketed_output->get_shape();
+        const Shape& shape = output_shapes[i];
+        NGRAPH_CHECK(shape.size() == bucketed_shape.size(),
+                     "Bucketed output ",
+                     i,
+                     " has shape ",
+                     bucketed_shape,
+                     ", expected rank of ",
+                     shape);
+        for (size_t axis = 0; axis < shape.size(); axis++)
+        {
+            NGRAPH_CHECK(shape[axis] <= bucketed_shape[axis],
+                         "Bucketed output ",
+                         i,
+                         " has shape ",
+                         bucketed_shape,
+                         ", smaller than its unpadded shape ",
+                         shape);
+        }
+
+        if (auto dynamic_tensor =
+                std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
+        {
+            dynamic_tensor->make_storage(type, shape);
+        }
+        const char* src = get_host_data(bucketed_output);
+        if (src == nullptr)
+        {
+            bucketed_data.resize(bucketed_output->get_size_in_bytes());
+            bucketed_output->read(bucketed_data.data(), bucketed_data.size());
+            src = bucketed_data.data();
+        }
+        char* dst = get_host_data(outputs[i]);
+        if (dst != nullptr)
+        {
+            copy_corner(src, bucketed_shape, dst, shape, shape, type.size());
+        }
         else
         {
-            // Caching on all remaining shapes
-            for (int i = 0; i < input->get_shape().size(); i++)
+            data.resize(shape_size(shape) * type.size());
+            copy_corner(src, bucketed_shape, data.data(), shape, shape, type.size());
+            outputs[i]->write(data.data(), data.size());
+        }
+    }
+    return rc;
+}
+
+std::unique_ptr<runtime::dynamic::DynamicExecutable::StagingTensors>
+    runtime::dynamic::DynamicExecutable::acquire_staging_tensors(const CacheKey& key,
+                                                                 size_t input_count)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_staging_mutex);
+        for (auto it = m_idle_staging_tensors.begin(); it != m_idle_staging_tensors.end(); ++it)
+        {
+            if ((*it)->key == key)
             {
-                merged_input_shapes.emplace_back(input->get_shape()[i]);
+                std::unique_ptr<StagingTensors> staging = std::move(*it);
+                m_idle_staging_tensors.erase(it);
+                return staging;
             }
         }
-        // -1 is the separator.
-        // So if shape of Input 1 = {2, 2, 3, 3} & Input 2 = {4, 5}
-        // the key would be 2, 2, 3, 3, -1, 4, 5, -1
-        merged_input_shapes.emplace_back(-1);
-        loop_count++;
     }
+    // Every set in use by a concurrent call needs its own tensors
+    std::unique_ptr<StagingTensors> staging(new StagingTensors());
+    staging->key = key;
+    staging->inputs.resize(input_count);
+    staging->filled_shapes.resize(input_count);
+    staging->host_inputs.resize(input_count);
+    return staging;
+}
 
-    std::copy(merged_input_shapes.begin(),
-              merged_input_shapes.end(),
-              std::ostream_iterator<int>(key, ", "));
+void runtime::dynamic::DynamicExecutable::release_staging_tensors(
+    std::unique_ptr<StagingTensors> staging)
+{
+    std::lock_guard<std::mutex> lock(m_staging_mutex);
+    m_idle_staging_tensors.push_front(std::move(staging));
+    if (m_idle_staging_tensors.size() > s_staging_cache_size)
+    {
+        m_idle_staging_tensors.pop_back();
+    }
+}
 
-    if (m_lru->is_cached(merged_input_shapes))
+std::vector<Shape> runtime::dynamic::DynamicExecutable::get_output_shapes(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
+{
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
+    std::shared_ptr<SpecializationArgs> args = make_specialization_args(inputs, wrapped_inputs);
+    CacheKey key = make_cache_key(*args);
+    std::vector<Shape> shapes;
+    bool inferred = false;
     {
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
+        std::lock_guard<std::mutex> lock(m_output_shape_mutex);
+        auto it = m_output_shapes.find(key);
+        if (it != m_output_shapes.end())
+        {
+            m_output_shape_lru.splice(m_output_shape_lru.begin(), m_output_shape_lru, it->second);
+            return it->second->second;
+        }
+        inferred = infer_output_shapes(*args, shapes);
+    }
 
-        std::shared_ptr<Function> clone = m_lru->get_cloned_function(merged_input_shapes);
-        const ResultVector& results = clone->get_results();
-        for (auto& result : results)
+    if (!inferred)
+    {
+        shapes.clear();
+        for (auto& result : specialize(*args)->get_results())
         {
-            NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
-                         "Shape staticization failed for result node ",
-                         *result);
+            shapes.push_back(result->get_shape());
         }
-        NGRAPH_CHECK(results.size() == outputs.size());
+    }
 
-        for (size_t i = 0; i < outputs.size(); i++)
+    std::lock_guard<std::mutex> lock(m_output_shape_mutex);
+    if (m_output_shapes.find(key) == m_output_shapes.end())
+    {
+        m_output_shape_lru.emplace_front(key, shapes);
+        m_output_shapes.insert({key, m_output_shape_lru.begin()});
+        if (m_output_shape_lru.size() > s_output_shape_cache_size)
         {
-            if (auto dynamic_tensor =
-                    std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
-            {
-                dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
-                                             results[i]->get_output_shape(0));
-                wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
-            }
-            else
-            {
-                wrapped_outputs.push_back(outputs[i]);
-            }
+            m_output_shapes.erase(m_output_shape_lru.back().first);
+            m_output_shape_lru.pop_back();
         }
+    }
+    return shapes;
+}
 
-        return m_lru->get_cached_entry(merged_input_shapes)->call(wrapped_outputs, inputs);
+bool runtime::dynamic::DynamicExecutable::infer_output_shapes(const SpecializationArgs& args,
+                                                              std::vector<Shape>& shapes)
+{
+    if (m_shape_function == nullptr)
+    {
+        return false;
     }
-    else
+    const ParameterVector& parameters = m_shape_function->get_parameters();
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        parameters[i]->set_element_type(args.element_types[i]);
+        parameters[i]->set_partial_shape(args.shapes[i]);
+    }
+    try
+    {
+        for (auto& node : m_shape_function->get_ordered_ops())
+        {
+            node->revalidate_and_infer_types();
+        }
+    }
+    catch (const std::exception&)
+    {
+        // Let specialization report the error, or handle ops that only validate once their
+        // dynamic inputs have been folded away
+        return false;
+    }
+    for (auto& result : m_shape_function->get_results())
+    {
+        if (!result->get_output_partial_shape(0).is_static())
+        {
+            return false;
+        }
+        shapes.push_back(result->get_shape());
+    }
+    return true;
+}
+
+std::shared_ptr<runtime::dynamic::DynamicExecutable::SpecializationArgs>
+    runtime::dynamic::DynamicExecutable::make_specialization_args(
+        const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+        std::vector<std::shared_ptr<runtime::Tensor>>& wrapped_inputs) const
+{
+    NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == inputs.size());
+
+    auto args = make_shared<SpecializationArgs>();
+    for (size_t i = 0; i < inputs.size(); i++)
     {
-        NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == inputs.size());
+        std::shared_ptr<runtime::Tensor> input = inputs[i];
+        // TODO(amprocte): Move has_storage() to runtime::Tensor?
+        if (auto dynamic_tensor = std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
+        {
+            NGRAPH_CHECK(dynamic_tensor->has_storage());
+            input = dynamic_tensor->get_wrapped_tensor();
+        }
+        wrapped_inputs.push_back(input);
+        args->element_types.push_back(input->get_element_type());
+        args->shapes.push_back(input->get_shape());
 
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
-        std::vector<element::Type> arg_element_types;
-        std::vector<PartialShape> arg_shapes;
+        if (m_wrapped_function->get_parameters()[i]->is_relevant_to_shapes())
+        {
+            args->values.emplace_back(input->get_size_in_bytes(), /*alignment=*/64);
+            // TODO(amprocte): For host-resident tensors we should be able to skip the read,
+            // but no API for that yet.
+            input->read(args->values.back().get_ptr(), input->get_size_in_bytes());
+        }
+        else
+        {
+            args->values.emplace_back();
+        }
+    }
+    return args;
+}
 
-        std::shared_ptr<Function> clone;
+bool runtime::dynamic::DynamicExecutable::call_specialized(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
+{
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
+    std::shared_ptr<SpecializationArgs> args = make_specialization_args(inputs, wrapped_inputs);
+    CacheKey key = make_cache_key(*args);
+    LRUCache::Entry entry;
+    if (!m_lru->get_entry(key, entry))
+    {
+        // With a fallback the call needs the specialized function right away, so it is
+        // specialized here and shared with the background compilation
+        bool background = (m_fallback_backend != nullptr);
+        Compilation compilation = compile_specialization(key, args, background, background);
+        if (background &&
+            compilation.entry.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
         {
-            // We'll use AlignedBuffers to back the base pointers, storing them in this vector for
-            // RAII
-            // purposes.
-            std::vector<AlignedBuffer> arg_buffers;
-            arg_buffers.reserve(inputs.size());
-            std::vector<void*> arg_value_base_pointers(inputs.size());
+            return call_fallback(key, *args, compilation.function, outputs, wrapped_inputs);
+        }
+        entry = compilation.entry.get();
+    }
+    return call_entry(entry, outputs, wrapped_inputs);
+}
 
-            size_t i = 0;
+void runtime::dynamic::DynamicExecutable::precompile(
+    const std::vector<std::vector<Shape>>& input_shapes)
+{
+    const ParameterVector& parameters = m_wrapped_function->get_parameters();
+    for (const std::vector<Shape>& shapes : input_shapes)
+    {
+        NGRAPH_CHECK(shapes.size() == parameters.size(),
+                     "precompile expects ",
+                     parameters.size(),
+                     " shapes, got ",
+                     shapes.size());
 
-            for (auto& input : inputs)
-            {
-                if (m_wrapped_function->get_parameters()[i]->is_relevant_to_shapes())
-                {
-                    // TODO(amprocte): Move has_storage() to runtime::Tensor?
-                    if (auto dynamic_tensor =
-                            std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
-                    {
-                        NGRAPH_CHECK(dynamic_tensor->has_storage());
-                    }
-
-                    arg_buffers.emplace_back(input->get_size_in_bytes(), /*alignment=*/64);
-                    arg_value_base_pointers[i] = arg_buffers.back().get_ptr();
-
-                    // TODO(amprocte): For host-resident tensors we should be able to skip the read,
-                    // but no API for that yet.
-                    input->read(arg_value_base_pointers[i], input->get_size_in_bytes());
-                }
-                else
-                {
-                    arg_value_base_pointers[i] = nullptr;
-                }
+        auto args = make_shared<SpecializationArgs>();
+        for (size_t i = 0; i < parameters.size(); i++)
+        {
+            const std::shared_ptr<op::Parameter>& parameter = parameters[i];
+            NGRAPH_CHECK(!parameter->is_relevant_to_shapes(),
+                         "Cannot precompile without the value of shape-relevant parameter ",
+                         *parameter);
+            NGRAPH_CHECK(parameter->get_element_type().is_static(),
+                         "Cannot precompile parameter ",
+                         *parameter,
+                         " with dynamic element type");
+            NGRAPH_CHECK(parameter->get_partial_shape().relaxes(shapes[i]),
+                         "Shape ",
+                         shapes[i],
+                         " is incompatible with parameter ",
+                         *parameter);
+            args->element_types.push_back(parameter->get_element_type());
+            args->shapes.push_back(shapes[i]);
+            args->values.emplace_back();
+        }
+        compile_specialization(make_cache_key(*args), args, true, false);
+    }
+}
 
-                if (auto dynamic_tensor =
-                        std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
-                {
-                    NGRAPH_CHECK(dynamic_tensor->has_storage());
-                    arg_element_types.push_back(
-                        dynamic_tensor->get_wrapped_tensor()->get_element_type());
-                    arg_shapes.push_back(dynamic_tensor->get_wrapped_tensor()->get_shape());
-                    wrapped_inputs.push_back(dynamic_tensor->get_wrapped_tensor());
-                }
-                else
-                {
-                    arg_element_types.push_back(input->get_element_type());
-                    arg_shapes.push_back(input->get_shape());
-                    wrapped_inputs.push_back(input);
-                }
+runtime::CacheKey
+    runtime::dynamic::DynamicExecutable::make_cache_key(const SpecializationArgs& args) const
+{
+    // We cache on:
+    // (1) the identity of the wrapped function;
+    // (2) all element types and shapes;
+    // (3) all values of shape-relevant input tensors.
+    //
+    // So if shape of Input 1 = {2, 2, 3, 3} & Input 2 = {4, 5} the key would be
+    // id, type1, 2, 2, 3, 3, -1, type2, 4, 5, -1
+    //
+    // The raw bytes of a shape-relevant input may themselves contain -1, so they are preceded
+    // by their size to keep the key unambiguous.
+    CacheKey key;
+    key.push_back(static_cast<int64_t>(m_wrapped_function->get_instance_id()));
+    for (size_t i = 0; i < args.element_types.size(); i++)
+    {
+        key.push_back(static_cast<int64_t>(static_cast<element::Type_t>(args.element_types[i])));
+        if (m_wrapped_function->get_parameters()[i]->is_relevant_to_shapes())
+        {
+            const AlignedBuffer& value = args.values[i];
+            // Caching on the raw bytes of shape relevant inputs
+            key.push_back(static_cast<int64_t>(value.size()));
+            std::vector<int64_t> data((value.size() + sizeof(int64_t) - 1) / sizeof(int64_t), 0);
+            memcpy(data.data(), value.get_ptr(), value.size());
+            key.insert(key.end(), data.begin(), data.end());
+        }
+        else
+        {
+            // Caching on all remaining shapes
+            const Shape& shape = args.shapes[i].to_shape();
+            key.insert(key.end(), shape.begin(), shape.end());
+        }
+        // -1 is the separator.
+        key.push_back(-1);
+    }
+    return key;
+}
 
-                i++;
-            }
+shared_ptr<Function>
+    runtime::dynamic::DynamicExecutable::specialize(const SpecializationArgs& args) const
+{
+    std::vector<void*> arg_value_base_pointers;
+    for (size_t i = 0; i < args.values.size(); i++)
+    {
+        bool is_shape_relevant = m_wrapped_function->get_parameters()[i]->is_relevant_to_shapes();
+        // specialize_function only reads the values.
+        void* value = const_cast<void*>(args.values[i].get_ptr());
+        arg_value_base_pointers.push_back(is_shape_relevant ? value : nullptr);
+    }
+    std::shared_ptr<Function> clone = specialize_function(
+        m_wrapped_function, args.element_types, args.shapes, arg_value_base_pointers);
+
+    pass::Manager passes;
+    passes.register_pass<pass::ConstantFolding>();
+    passes.register_pass<pass::DynElimination>();
+    passes.register_pass<pass::Opset0Downgrade>(); // Converts dynamic v1 variants to v0 ops
+    passes.set_per_pass_validation(false);
 
-            clone = specialize_function(
-                m_wrapped_function, arg_element_types, arg_shapes, arg_value_base_pointers);
+    // FIXME(amprocte): Vile, temporary hack: we need to do repeated rounds of
+    // ConstantFolding/DynElimination until everything that DynElimination is supposed to
+    // eliminate has actually been eliminated. We could do this by monitoring the return values
+    // of the passes (keep iterating until both CF and DE report no changes), but that did not
+    // seem to work so here we are. Probably a better fix is to somehow combine the matchers in
+    // CF
+    // and DE into one pass.
+    size_t num_dyn_nodes_last_pass = std::numeric_limits<size_t>::max();
+
+    while (num_dyn_nodes_last_pass != 0)
+    {
+        passes.run_passes(clone);
+        auto num_dyn_nodes_this_pass = count_dyn_nodes(clone);
+
+        NGRAPH_CHECK(num_dyn_nodes_this_pass < num_dyn_nodes_last_pass,
+                     "Could not eliminate all Dyn nodes (",
+                     num_dyn_nodes_this_pass,
+                     " remaining)");
+
+        num_dyn_nodes_last_pass = num_dyn_nodes_this_pass;
+    }
+
+    pass::Manager pass_val;
+    pass_val.register_pass<pass::Validate>();
+    pass_val.run_passes(clone);
+
+    for (auto& result : clone->get_results())
+    {
+        NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
+                     "Shape staticization failed for result node ",
+                     *result);
+    }
+    return clone;
+}
+
+runtime::dynamic::DynamicExecutable::Compilation
+    runtime::dynamic::DynamicExecutable::compile_specialization(
+        const CacheKey& key,
+        const std::shared_ptr<const SpecializationArgs>& args,
+        bool background,
+        bool specialize_now)
+{
+    // Return the pending compilation for key, or a finished one if the executable is cached
+    auto find_compilation = [this, &key](Compilation& compilation) {
+        auto it = m_pending_compilations.find(key);
+        if (it != m_pending_compilations.end())
+        {
+            compilation = it->second;
+            return true;
         }
+        // The compilation may have finished since the caller missed the cache.
+        LRUCache::Entry entry;
+        if (m_lru->get_entry(key, entry))
+        {
+            std::promise<LRUCache::Entry> cached;
+            cached.set_value(entry);
+            compilation.entry = cached.get_future().share();
+            return true;
+        }
+        return false;
+    };
 
-        pass::Manager passes;
-        passes.register_pass<pass::ConstantFolding>();
-        passes.register_pass<pass::DynElimination>();
-        passes.register_pass<pass::Opset0Downgrade>(); // Converts dynamic v1 variants to v0 ops
-        passes.set_per_pass_validation(false);
+    Compilation compilation;
+    {
+        std::lock_guard<std::mutex> lock(m_compilation_mutex);
+        if (find_compilation(compilation))
+        {
+            return compilation;
+        }
+    }
 
-        // FIXME(amprocte): Vile, temporary hack: we need to do repeated rounds of
-        // ConstantFolding/DynElimination until everything that DynElimination is supposed to
-        // eliminate has actually been eliminated. We could do this by monitoring the return values
-        // of the passes (keep iterating until both CF and DE report no changes), but that did not
-        // seem to work so here we are. Probably a better fix is to somehow combine the matchers in
-        // CF
-        // and DE into one pass.
-        size_t num_dyn_nodes_last_pass = std::numeric_limits<size_t>::max();
+    std::shared_ptr<Function> function;
+    std::shared_ptr<Function> compiled_function;
+    if (specialize_now)
+    {
+        // The wrapped backend may rewrite the function it compiles while other callers copy
+        // the specialized one for the fallback backend, so it compiles a copy
+        function = specialize(*args);
+        compiled_function = clone_function(*function);
+    }
+    std::packaged_task<LRUCache::Entry()> task([this, key, args, compiled_function]() {
+        try
+        {
+            LRUCache::Entry entry;
+            entry.function = compiled_function ? compiled_function : specialize(*args);
+            entry.executable =
+                m_wrapped_backend->compile(entry.function, m_enable_performance_collection);
+            // Put compiled executable in the cache before dropping the pending compilation, so
+            // a concurrent miss finds one or the other.
+            m_lru->add_entry(key, entry.executable, entry.function);
+            std::lock_guard<std::mutex> lock(m_compilation_mutex);
+            m_pending_compilations.erase(key);
+            return entry;
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_compilation_mutex);
+            m_pending_compilations.erase(key);
+            throw;
+        }
+    });
 
-        while (num_dyn_nodes_last_pass != 0)
+    {
+        std::lock_guard<std::mutex> lock(m_compilation_mutex);
+        // Another caller may have started the compilation while this one specialized
+        if (find_compilation(compilation))
         {
-            passes.run_passes(clone);
-            auto num_dyn_nodes_this_pass = count_dyn_nodes(clone);
+            return compilation;
+        }
+        compilation.entry = task.get_future().share();
+        compilation.function = function;
+        m_pending_compilations[key] = compilation;
+    }
 
-            NGRAPH_CHECK(num_dyn_nodes_this_pass < num_dyn_nodes_last_pass,
-                         "Could not eliminate all Dyn nodes (",
-                         num_dyn_nodes_this_pass,
-                         " remaining)");
+    if (background)
+    {
+        queue_background_compilation(std::move(task));
+    }
+    else
+    {
+        task();
+    }
+    return compilation;
+}
 
-            num_dyn_nodes_last_pass = num_dyn_nodes_this_pass;
+void runtime::dynamic::DynamicExecutable::queue_background_compilation(
+    std::packaged_task<LRUCache::Entry()> task)
+{
+    std::lock_guard<std::mutex> lock(m_background_mutex);
+    m_background_queue.push_back(std::move(task));
+    if (!m_background_thread.joinable())
+    {
+        m_background_thread =
+            std::thread(&runtime::dynamic::DynamicExecutable::run_background_compilations, this);
+    }
+    m_background_cv.notify_one();
+}
+
+void runtime::dynamic::DynamicExecutable::run_background_compilations()
+{
+    std::unique_lock<std::mutex> lock(m_background_mutex);
+    while (true)
+    {
+        m_background_cv.wait(
+            lock, [this]() { return m_stop_background || !m_background_queue.empty(); });
+        if (m_stop_background)
+        {
+            return;
         }
+        std::packaged_task<LRUCache::Entry()> task = std::move(m_background_queue.front());
+        m_background_queue.pop_front();
+        lock.unlock();
+        // Failures are reported through the task's future
+        task();
+        lock.lock();
+    }
+}
 
-        pass::Manager pass_val;
-        pass_val.register_pass<pass::Validate>();
-        pass_val.run_passes(clone);
+bool runtime::dynamic::DynamicExecutable::call_entry(
+    const LRUCache::Entry& entry,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& wrapped_inputs)
+{
+    const ResultVector& results = entry.function->get_results();
+    NGRAPH_CHECK(results.size() == outputs.size());
+
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (auto dynamic_tensor =
+                std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
+        {
+            dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
+                                         results[i]->get_output_shape(0));
+            wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
+        }
+        else
+        {
+            wrapped_outputs.push_back(outputs[i]);
+        }
+    }
 
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
+    return entry.executable->call(wrapped_outputs, wrapped_inputs);
+}
 
-        const ResultVector& results = clone->get_results();
-        for (auto& result : results)
+runtime::LRUCache::Entry runtime::dynamic::DynamicExecutable::compile_fallback(
+    const CacheKey& key, const SpecializationArgs& args, const std::shared_ptr<Function>& function)
+{
+    std::packaged_task<LRUCache::Entry()> task([this, &key, &args, &function]() {
+        try
         {
-            NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
-                         "Shape staticization failed for result node ",
-                         *result);
+            LRUCache::Entry entry;
+            entry.function = function ? clone_function(*function) : specialize(args);
+            entry.executable =
+                m_fallback_backend->compile(entry.function, m_enable_performance_collection);
+            m_fallback_lru->add_entry(key, entry.executable, entry.function);
+            std::lock_guard<std::mutex> lock(m_compilation_mutex);
+            m_pending_fallbacks.erase(key);
+            return entry;
         }
-        NGRAPH_CHECK(results.size() == outputs.size());
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_compilation_mutex);
+            m_pending_fallbacks.erase(key);
+            throw;
+        }
+    });
 
-        for (size_t i = 0; i < outputs.size(); i++)
+    std::shared_future<LRUCache::Entry> compilation;
+    bool compiling = false;
+    {
+        std::lock_guard<std::mutex> lock(m_compilation_mutex);
+        auto it = m_pending_fallbacks.find(key);
+        if (it != m_pending_fallbacks.end())
         {
-            if (auto dynamic_tensor =
-                    std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
-            {
-                dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
-                                             results[i]->get_output_shape(0));
-                wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
-            }
-            else
+            compilation = it->second;
+        }
+        else
+        {
+            LRUCache::Entry entry;
+            if (m_fallback_lru->get_entry(key, entry))
             {
-                wrapped_outputs.push_back(outputs[i]);
+                return entry;
             }
+            compilation = task.get_future().share();
+            m_pending_fallbacks[key] = compilation;
+            compiling = true;
         }
+    }
 
-        auto compiled_executable =
-            m_wrapped_backend->compile(clone, m_enable_performance_collection);
-        // Put compiled executable in the cache.
-        m_lru->add_entry(merged_input_shapes, compiled_executable, clone);
-        auto result = compiled_executable->call(wrapped_outputs, wrapped_inputs);
+    if (compiling)
+    {
+        task();
+    }
+    return compilation.get();
+}
 
-        return result;
+bool runtime::dynamic::DynamicExecutable::call_fallback(
+    const CacheKey& key,
+    const SpecializationArgs& args,
+    const std::shared_ptr<Function>& function,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& wrapped_inputs)
+{
+    LRUCache::Entry entry = compile_fallback(key, args, function);
+
+    // Tensors of the wrapped backend cannot be passed to the fallback backend, so stage inputs
+    // and outputs through its own tensors.
+    std::vector<std::shared_ptr<runtime::Tensor>> fallback_inputs;
+    for (auto& input : wrapped_inputs)
+    {
+        std::vector<char> data(input->get_size_in_bytes());
+        input->read(data.data(), data.size());
+        auto fallback_input =
+            m_fallback_backend->create_tensor(input->get_element_type(), input->get_shape());
+        fallback_input->write(data.data(), data.size());
+        fallback_inputs.push_back(fallback_input);
+    }
+
+    const ResultVector& results = entry.function->get_results();
+    NGRAPH_CHECK(results.size() == outputs.size());
+    std::vector<std::shared_ptr<runtime::Tensor>> fallback_outputs;
+    for (auto& result : results)
+    {
+        fallback_outputs.push_back(m_fallback_backend->create_tensor(
+            result->get_output_element_type(0), result->get_output_shape(0)));
     }
+
+    bool rc = entry.executable->call(fallback_outputs, fallback_inputs);
+
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        const std::shared_ptr<runtime::Tensor>& fallback_output = fallback_outputs[i];
+        if (auto dynamic_tensor =
+                std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
+        {
+            dynamic_tensor->make_storage(fallback_output->get_element_type(),
+                                         fallback_output->get_shape());
+        }
+        std::vector<char> data(fallback_output->get_size_in_bytes());
+        fallback_output->read(data.data(), data.size());
+        outputs[i]->write(data.data(), data.size());
+    }
+    return rc;
+}
+
+runtime::LRUCache::Statistics
+    runtime::dynamic::DynamicExecutable::get_cache_statistics() const
+{
+    return m_lru->get_statistics();
+}
+
+runtime::LRUCache::Statistics
+    runtime::dynamic::DynamicExecutable::get_fallback_statistics() const
+{
+    NGRAPH_CHECK(m_fallback_lru, "No fallback backend is configured");
+    return m_fallback_lru->get_statistics();
 }
 
 runtime::dynamic::DynamicTensor::DynamicTensor(
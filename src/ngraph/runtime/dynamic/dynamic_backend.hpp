@@ -16,11 +16,20 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/cache.hpp"
 #include "ngraph/runtime/host_tensor.hpp"
@@ -35,6 +44,9 @@ namespace ngraph
             class DynamicBackend;
             class DynamicExecutable;
             class DynamicTensor;
+
+            /// \brief For each bucketed axis, the sorted sizes that dimension is rounded up to
+            using ShapeBuckets = std::map<size_t, std::vector<size_t>>;
         }
     }
 }
@@ -71,8 +83,23 @@ public:
     std::shared_ptr<Executable> compile(std::shared_ptr<Function> function,
                                         bool enable_performance_data = false) override;
 
+    /// \brief Handles the keys "shape_buckets" and "compile_fallback" and forwards all other
+    ///        keys to the wrapped backend.
+    ///
+    /// "shape_buckets" enables shape bucketing for executables compiled afterwards. Its value
+    /// is a list of `axis:size,size,...` entries separated by `;`, for example
+    /// `0:1,8,32;1:64,128,256`. See DynamicExecutable for details. An empty value disables
+    /// bucketing.
+    ///
+    /// "compile_fallback" names a backend, for example `INTERPRETER`, that executables compiled
+    /// afterwards run on while a specialization for the wrapped backend is compiled in the
+    /// background. An empty value disables the fallback.
+    bool set_config(const std::map<std::string, std::string>& config, std::string& error) override;
+
 private:
     std::shared_ptr<ngraph::runtime::Backend> m_wrapped_backend;
+    std::shared_ptr<ngraph::runtime::Backend> m_fallback_backend;
+    ShapeBuckets m_shape_buckets;
 };
 
 ///
@@ -87,6 +114,31 @@ private:
 /// 2. compiles the clone using the wrapped backend;
 /// 3. fowards the input tensors to the clone executable for actual execution.
 ///
+/// When shape buckets are configured, every non-shape-relevant input dimension on a bucketed
+/// axis is rounded up to the smallest bucket that holds it, and the input is zero-padded to that
+/// shape, so a few compiled executables serve all traffic. Only dimensions that are dynamic in
+/// the wrapped function's parameter are bucketed, so inputs with a static size on the axis, such
+/// as weights, are passed through unchanged. Inputs are padded into staging tensors kept per
+/// bucket, which are reused by later calls. Outputs are sliced back to the shapes inferred for
+/// the unpadded inputs. Unless the function has shape-relevant parameters, those shapes are
+/// inferred by revalidating a clone of the function with retyped parameters, without
+/// specializing it, and they are kept in a small LRU cache. This is only correct for functions
+/// where padded elements along those axes do not affect the unpadded ones, such as the batch
+/// axis of most inference graphs. Dimensions larger than the largest bucket are compiled
+/// exactly.
+///
+/// Concurrent calls that miss the cache on the same specialization share a single compilation.
+/// Background compilations are queued to a single worker thread owned by the executable, so
+/// they never use more than one thread however many specializations are missed at once.
+/// `precompile` queues compilations for expected shapes ahead of the first call. If a fallback
+/// backend is given, a miss specializes the function on the calling thread, queues its
+/// compilation in the background and runs the call on the fallback backend until the compiled
+/// executable is ready, instead of blocking on the compilation. The fallback executable is
+/// compiled from a copy of that specialized function, so the function is specialized once for
+/// both backends. Fallback executables are compiled once per specialization even under
+/// concurrent misses and kept in a small cache of their own, since they are only needed while
+/// the wrapped backend is still compiling.
+///
 /// `DynamicExecutable` objects are produced by `DynamicBackend::compile()`.
 ///
 class ngraph::runtime::dynamic::DynamicExecutable : public ngraph::runtime::Executable
@@ -94,16 +146,148 @@ class ngraph::runtime::dynamic::DynamicExecutable : public ngraph::runtime::Exec
 public:
     DynamicExecutable(std::shared_ptr<Function> wrapped_function,
                       std::shared_ptr<ngraph::runtime::Backend> wrapped_backend,
-                      bool enable_performance_collection = false);
+                      bool enable_performance_collection = false,
+                      const ShapeBuckets& shape_buckets = ShapeBuckets(),
+                      std::shared_ptr<ngraph::runtime::Backend> fallback_backend = nullptr);
+    ~DynamicExecutable() override;
     virtual bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
 
+    /// \brief Queue the compilation of the specialization for each set of input shapes on the
+    ///        background thread. Calls with those shapes reuse the result, waiting for it if it
+    ///        is not ready yet.
+    /// \param input_shapes One shape per parameter for each specialization to compile. The
+    ///        function must not have shape-relevant parameters and its parameter element types
+    ///        must be static.
+    void precompile(const std::vector<std::vector<Shape>>& input_shapes);
+
+    /// \brief Hit, miss and eviction counts and current size of the executable cache
+    LRUCache::Statistics get_cache_statistics() const;
+
+    /// \brief Statistics of the fallback backend's executable cache. Every call run on the
+    ///        fallback backend looks up this cache once, so hits plus misses counts them.
+    LRUCache::Statistics get_fallback_statistics() const;
+
 private:
+    /// \brief Element types, shapes and shape-relevant values a specialization is built from
+    struct SpecializationArgs
+    {
+        std::vector<element::Type> element_types;
+        std::vector<PartialShape> shapes;
+        /// \brief Values of shape-relevant arguments, empty for the others
+        std::vector<AlignedBuffer> values;
+    };
+
+    /// \brief Collect the specialization arguments for inputs, and the backend tensors that
+    ///        wrap them into wrapped_inputs
+    std::shared_ptr<SpecializationArgs> make_specialization_args(
+        const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+        std::vector<std::shared_ptr<runtime::Tensor>>& wrapped_inputs) const;
+    CacheKey make_cache_key(const SpecializationArgs& args) const;
+    /// \brief Clone m_wrapped_function for args and eliminate all dynamic nodes from the clone
+    std::shared_ptr<Function> specialize(const SpecializationArgs& args) const;
+    /// \brief A pending or finished compilation for the wrapped backend
+    struct Compilation
+    {
+        std::shared_future<LRUCache::Entry> entry;
+        /// \brief The specialized function, if it was specialized on the thread that started
+        ///        the compilation. It is not compiled itself, so it can be copied for the
+        ///        fallback backend at any time.
+        std::shared_ptr<Function> function;
+    };
+    /// \brief Return the pending or finished compilation for key, starting one if there is
+    ///        none. A foreground compilation runs on the calling thread and is finished on
+    ///        return. A background compilation is queued to the background thread, and is
+    ///        specialized on the calling thread first if specialize_now is set.
+    Compilation compile_specialization(const CacheKey& key,
+                                       const std::shared_ptr<const SpecializationArgs>& args,
+                                       bool background,
+                                       bool specialize_now);
+    void queue_background_compilation(std::packaged_task<LRUCache::Entry()> task);
+    /// \brief Body of the background thread
+    void run_background_compilations();
+    bool call_entry(const LRUCache::Entry& entry,
+                    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                    const std::vector<std::shared_ptr<runtime::Tensor>>& wrapped_inputs);
+    /// \brief Return the fallback executable for key, compiling it if no other caller has.
+    ///        It is compiled from a copy of function if given, and otherwise specialized from
+    ///        args.
+    LRUCache::Entry compile_fallback(const CacheKey& key,
+                                     const SpecializationArgs& args,
+                                     const std::shared_ptr<Function>& function);
+    bool call_fallback(const CacheKey& key,
+                       const SpecializationArgs& args,
+                       const std::shared_ptr<Function>& function,
+                       const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                       const std::vector<std::shared_ptr<runtime::Tensor>>& wrapped_inputs);
+
+    /// \brief Run the executable specialized for the exact shapes of inputs
+    bool call_specialized(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                          const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+    bool call_bucketed(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+    /// \brief Shapes of the function's results for the exact shapes of inputs
+    std::vector<Shape>
+        get_output_shapes(const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+    /// \brief Infer the shapes of the function's results for args on m_shape_function.
+    ///        Requires m_output_shape_mutex to be held.
+    /// \returns false if the shapes could not be inferred without specializing the function
+    bool infer_output_shapes(const SpecializationArgs& args, std::vector<Shape>& shapes);
+
+    /// \brief Tensors of the wrapped backend that the inputs of a bucketed call are padded
+    ///        into, for one set of bucketed input shapes
+    struct StagingTensors
+    {
+        CacheKey key;
+        /// \brief Padded input tensors, null for inputs that have not needed padding yet
+        std::vector<std::shared_ptr<runtime::Tensor>> inputs;
+        /// \brief Unpadded shape last copied into each input tensor. The rest of the tensor
+        ///        holds zeros.
+        std::vector<Shape> filled_shapes;
+        /// \brief Host copies of the padded inputs, for backends whose tensors are not
+        ///        HostTensors
+        std::vector<std::vector<char>> host_inputs;
+    };
+    std::unique_ptr<StagingTensors> acquire_staging_tensors(const CacheKey& key,
+                                                            size_t input_count);
+    void release_staging_tensors(std::unique_ptr<StagingTensors> staging);
+
     std::shared_ptr<ngraph::Function> m_wrapped_function;
     std::shared_ptr<ngraph::runtime::Backend> m_wrapped_backend;
     std::shared_ptr<ngraph::runtime::LRUCache> m_lru =
         std::make_shared<ngraph::runtime::LRUCache>();
     bool m_enable_performance_collection;
+    ShapeBuckets m_shape_buckets;
+    std::shared_ptr<ngraph::runtime::Backend> m_fallback_backend;
+    std::shared_ptr<ngraph::runtime::LRUCache> m_fallback_lru;
+
+    std::mutex m_output_shape_mutex;
+    // Clone of the wrapped function whose parameters are retyped to infer output shapes, null
+    // if the function has shape-relevant parameters
+    std::shared_ptr<Function> m_shape_function;
+    // Output shapes by input key, most recently used first
+    std::list<std::pair<CacheKey, std::vector<Shape>>> m_output_shape_lru;
+    std::unordered_map<CacheKey,
+                       std::list<std::pair<CacheKey, std::vector<Shape>>>::iterator,
+                       CacheKeyHash>
+        m_output_shapes;
+
+    std::mutex m_staging_mutex;
+    // Idle staging tensors, most recently used first
+    std::list<std::unique_ptr<StagingTensors>> m_idle_staging_tensors;
+
+    std::mutex m_compilation_mutex;
+    std::unordered_map<CacheKey, Compilation, CacheKeyHash> m_pending_compilations;
+    std::unordered_map<CacheKey, std::shared_future<LRUCache::Entry>, CacheKeyHash>
+        m_pending_fallbacks;
+
+    // Background compilations waiting for the background thread, which is started by the
+    // first one and joined by the destructor
+    std::mutex m_background_mutex;
+    std::condition_variable m_background_cv;
+    std::deque<std::packaged_task<LRUCache::Entry()>> m_background_queue;
+    bool m_stop_background = false;
+    std::thread m_background_thread;
 };
 
 ///
@@ -14,7 +14,11 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "ngraph/file_util.hpp"
 #include "ngraph/runtime/executable.hpp"
@@ -24,12 +28,132 @@
 using namespace std;
 using namespace ngraph;
 
+/// \brief Worker threads that run the calls queued by the default call_async. Each thread
+///        holds a reference to the workers, since a callback may destroy the executable.
+class runtime::Executable::AsyncWorkers : public enable_shared_from_this<AsyncWorkers>
+{
+public:
+    AsyncWorkers()
+        : m_max_threads(max(1u, thread::hardware_concurrency()))
+    {
+    }
+
+    void push(function<void()> call)
+    {
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_calls.push_back(move(call));
+            if (m_num_idle < m_calls.size() && m_threads.size() < m_max_threads)
+            {
+                auto self = shared_from_this();
+                m_threads.emplace_back([self]() { self->run(); });
+            }
+        }
+        m_cv.notify_one();
+    }
+
+    /// \brief Wake and join all threads. Called when the executable is destroyed, so no
+    ///        calls can be pending.
+    void stop()
+    {
+        vector<thread> threads;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_stop = true;
+            threads.swap(m_threads);
+        }
+        m_cv.notify_all();
+        for (auto& worker : threads)
+        {
+            // The last reference to the executable may be released by a callback
+            if (worker.get_id() == this_thread::get_id())
+            {
+                worker.detach();
+            }
+            else
+            {
+                worker.join();
+            }
+        }
+    }
+
+private:
+    void run()
+    {
+        unique_lock<mutex> lock(m_mutex);
+        while (true)
+        {
+            m_num_idle++;
+            m_cv.wait(lock, [this]() { return m_stop || !m_calls.empty(); });
+            m_num_idle--;
+            if (m_stop)
+            {
+                return;
+            }
+            auto call = move(m_calls.front());
+            m_calls.pop_front();
+            lock.unlock();
+            call();
+            // Release the captures, which may hold the executable, before taking the lock
+            call = nullptr;
+            lock.lock();
+        }
+    }
+
+    const size_t m_max_threads;
+    mutex m_mutex;
+    condition_variable m_cv;
+    deque<function<void()>> m_calls;
+    vector<thread> m_threads;
+    size_t m_num_idle = 0;
+    bool m_stop = false;
+};
+
 runtime::Executable::Executable()
+    : m_async_workers(make_shared<AsyncWorkers>())
 {
 }
 
 runtime::Executable::~Executable()
 {
+    m_async_workers->stop();
+}
+
+void runtime::Executable::call_async(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                     const vector<shared_ptr<runtime::Tensor>>& inputs,
+                                     const CallCallback& callback)
+{
+    m_async_workers->push([this, outputs, inputs, callback]() {
+        bool result = false;
+        exception_ptr error;
+        try
+        {
+            result = call(outputs, inputs);
+        }
+        catch (...)
+        {
+            error = current_exception();
+        }
+        callback(result, error);
+    });
+}
+
+future<bool> runtime::Executable::call_async(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                             const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    auto promise = make_shared<std::promise<bool>>();
+    future<bool> result = promise->get_future();
+    call_async(outputs, inputs, [promise](bool call_result, exception_ptr error) {
+        if (error)
+        {
+            promise->set_exception(error);
+        }
+        else
+        {
+            promise->set_value(call_result);
+        }
+    });
+    return result;
 }
 
 bool runtime::Executable::call_with_validate(const vector<shared_ptr<runtime::Tensor>>& outputs,
@@ -135,6 +259,11 @@ vector<runtime::PerformanceCounter> runtime::Executable::get_performance_data()
     return vector<PerformanceCounter>();
 }
 
+runtime::MemoryReport runtime::Executable::get_memory_report() const
+{
+    return MemoryReport();
+}
+
 void runtime::Executable::save(std::ostream& /* output_stream */)
 {
     throw runtime_error("save operation unimplemented.");
@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
 
 #include "ngraph/function.hpp"
+#include "ngraph/runtime/memory_report.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
 #include "ngraph/shape.hpp"
 #include "ngraph/type/element_type.hpp"
@@ -35,6 +39,9 @@ namespace ngraph
 class NGRAPH_API ngraph::runtime::Executable
 {
 public:
+    /// \brief Called with the result of an asynchronous call, or with the exception it threw
+    using CallCallback = std::function<void(bool result, std::exception_ptr error)>;
+
     Executable();
     virtual ~Executable();
 
@@ -44,6 +51,28 @@ public:
     virtual bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) = 0;
 
+    /// \brief Start an iteration without waiting for it to finish.
+    ///
+    /// The tensors and this executable must stay alive, and the inputs unmodified, until the
+    /// callback has been invoked. The default implementation queues the call for a pool of
+    /// worker threads owned by the executable. Threads are started as needed, up to one per
+    /// hardware thread, and joined when the executable is destroyed.
+    /// \param outputs vector of runtime::Tensor used as outputs
+    /// \param inputs vector of runtime::Tensor used as inputs
+    /// \param callback Invoked on the thread that ran the call once it finishes
+    virtual void call_async(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                            const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                            const CallCallback& callback);
+
+    /// \brief Start an iteration without waiting for it to finish.
+    ///
+    /// The same lifetime requirements as for the callback variant apply.
+    /// \param outputs vector of runtime::Tensor used as outputs
+    /// \param inputs vector of runtime::Tensor used as inputs
+    /// \returns A future holding the result of call, or the exception it threw
+    std::future<bool> call_async(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                                 const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+
     /// \brief Executes a single iteration of a Function.
     /// \param outputs vector of runtime::Tensor used as outputs
     /// \param inputs vector of runtime::Tensor used as inputs
@@ -55,6 +84,10 @@ public:
     /// \returns Vector of PerformanceCounter information.
     virtual std::vector<PerformanceCounter> get_performance_data() const;
 
+    /// \brief Report the memory held by this executable.
+    /// \returns The sizes known to the backend, all zero by default
+    virtual MemoryReport get_memory_report() const;
+
     /// \brief Validates a Function.
     /// \param outputs vector of runtime::Tensor used as outputs
     /// \param inputs vector of runtime::Tensor used as inputs
@@ -122,6 +155,9 @@ protected:
     void set_parameters_and_results(const Function& func);
 
 private:
+    class AsyncWorkers;
+
     ngraph::ParameterVector m_parameters;
     ngraph::ResultVector m_results;
+    std::shared_ptr<AsyncWorkers> m_async_workers;
 };
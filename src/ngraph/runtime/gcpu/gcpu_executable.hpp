@@ -68,22 +68,24 @@ public:
     GCPUExecutable(const std::shared_ptr<Function>& function,
                    bool enable_performance_collection = false);
 
-    bool call(const std::vector<std::shared_ptr<Tensor>>& outputs,
-              const std::vector<std::shared_ptr<Tensor>>& intputs) override;
-
 private:
     int get_alignment() const { return 64; }
-    void generate_calls(const element::Type& type,
-                        const Node& op,
-                        const std::vector<std::shared_ptr<HostTensor>>& outputs,
-                        const std::vector<std::shared_ptr<HostTensor>>& inputs) override;
+    OpCall::Kernel get_kernel(const element::Type& type) const override;
+
+    template <typename T>
+    static void gop_engine_kernel(INTExecutable& executable, const OpCall& call)
+    {
+        static_cast<GCPUExecutable&>(executable)
+            .gop_engine<T>(*call.node, call.type_id, call.outputs, call.inputs);
+    }
 
     template <typename T>
     void gop_engine(const Node& node,
+                    ngraph::runtime::interpreter::OP_TYPEID type_id,
                     const std::vector<std::shared_ptr<HostTensor>>& out,
                     const std::vector<std::shared_ptr<HostTensor>>& args)
     {
-        switch (INTExecutable::get_typeid(node))
+        switch (type_id)
         {
         case ngraph::runtime::interpreter::OP_TYPEID::Broadcast:
         {
@@ -108,7 +110,7 @@ private:
                                node.get_output_shape(0));
             break;
         }
-        default: op_engine<T>(node, out, args); break;
+        default: op_engine<T>(node, type_id, out, args); break;
         }
     }
 };
@@ -61,6 +61,16 @@ shared_ptr<runtime::Executable>
     runtime::interpreter::INTBackend::compile(shared_ptr<Function> function,
                                               bool enable_performance_collection)
 {
+    // Saved executables do not collect performance data
+    shared_ptr<runtime::PersistentCache> cache =
+        enable_performance_collection ? nullptr : get_persistent_cache();
+    if (cache)
+    {
+        return cache->compile(
+            *this, function, pass::PassConfig(), enable_performance_collection, [&]() {
+                return make_shared<INTExecutable>(function, enable_performance_collection);
+            });
+    }
     return make_shared<INTExecutable>(function, enable_performance_collection);
 }
 
@@ -84,7 +94,10 @@ std::shared_ptr<runtime::Executable> runtime::interpreter::INTBackend::load(istr
             break;
         }
     }
-    if (save_info == "INTERPRETER Save File 1.0")
+    // 1.0 files hold the model as JSON text, 1.1 files as a binary serialization and 1.2 files
+    // as a binary serialization whose records may carry 64 bit sizes
+    if (save_info == "INTERPRETER Save File 1.0" || save_info == "INTERPRETER Save File 1.1" ||
+        save_info == "INTERPRETER Save File 1.2")
     {
         for (const cpio::FileInfo& info : file_info)
         {
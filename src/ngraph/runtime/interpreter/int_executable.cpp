@@ -14,6 +14,9 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <sstream>
+#include <unordered_set>
+
 #include "ngraph/runtime/interpreter/int_executable.hpp"
 #include "ngraph/cpio.hpp"
 #include "ngraph/descriptor/layout/dense_tensor_layout.hpp"
@@ -25,6 +28,7 @@
 #include "ngraph/pass/like_replacement.hpp"
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/memory_layout.hpp"
 #include "ngraph/pass/opset0_downgrade.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/runtime/chrome_trace.hpp"
@@ -78,183 +82,367 @@ runtime::interpreter::INTExecutable::INTExecutable(const shared_ptr<Function>& f
     pass_manager.register_pass<pass::FusedOpDecomposition>();
     pass_manager.register_pass<pass::AssignLayout<DenseTensorLayout>>();
     pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(get_alignment());
     pass_manager.run_passes(m_function);
     for (auto node : m_function->get_ordered_ops())
     {
         m_nodes.push_back(node);
     }
     set_parameters_and_results(*m_function);
+    build_op_calls();
 }
 
 runtime::interpreter::INTExecutable::INTExecutable(const std::string& model_string)
     : m_is_compiled{true}
     , m_performance_counters_enabled{false}
 {
-    m_function = deserialize(model_string);
+    stringstream model(model_string);
+    m_function = deserialize(model);
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(get_alignment());
+    pass_manager.run_passes(m_function);
     for (auto node : m_function->get_ordered_ops())
     {
         m_nodes.push_back(node);
     }
     set_parameters_and_results(*m_function);
+    build_op_calls();
 }
 
-bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
-                                               const vector<shared_ptr<runtime::Tensor>>& inputs)
+void runtime::interpreter::INTExecutable::build_op_calls()
 {
-    runtime::event::Duration d1("call", "Interpreter");
-
-    // convert inputs to HostTensor
-    vector<shared_ptr<HostTensor>> func_inputs;
-    for (auto tensor : inputs)
-    {
-        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
-        func_inputs.push_back(host_tensor);
-    }
-    if (m_nan_check_enabled)
-    {
-        perform_nan_check(func_inputs);
-    }
-
-    // convert outputs to HostTensor
-    vector<shared_ptr<HostTensor>> func_outputs;
-    for (auto tensor : outputs)
-    {
-        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
-        func_outputs.push_back(host_tensor);
-    }
-
-    // map function params -> HostTensor
-    unordered_map<descriptor::Tensor*, shared_ptr<HostTensor>> tensor_map;
-    size_t input_count = 0;
+    // function inputs and outputs are bound on every call, intermediates once per call context
+    // and constants here
+    unordered_map<descriptor::Tensor*, shared_ptr<HostTensor>> constant_map;
+    unordered_map<descriptor::Tensor*, size_t> parameter_map;
     for (auto param : get_parameters())
     {
         for (size_t i = 0; i < param->get_output_size(); ++i)
         {
-            descriptor::Tensor* tensor = &param->output(i).get_tensor();
-            tensor_map.insert({tensor, func_inputs[input_count++]});
+            parameter_map.insert({&param->output(i).get_tensor(), parameter_map.size()});
         }
     }
-
-    // map function outputs -> HostTensor
-    for (size_t output_count = 0; output_count < get_results().size(); ++output_count)
+    m_parameter_bindings.resize(parameter_map.size());
+    unordered_map<descriptor::Tensor*, size_t> result_map;
+    for (auto result : get_results())
     {
-        auto output = get_results()[output_count];
-        if (!is_type<op::Result>(output))
+        if (!is_type<op::Result>(result))
         {
             throw ngraph_error("One of function's outputs isn't op::Result");
         }
-        descriptor::Tensor* tensor = &output->output(0).get_tensor();
-        tensor_map.insert({tensor, func_outputs[output_count]});
+        result_map.insert({&result->output(0).get_tensor(), result_map.size()});
     }
+    m_result_bindings.resize(result_map.size());
 
-    // for each ordered op in the graph
-    for (auto op : m_nodes)
+    unordered_set<const void*> constant_data;
+    for (auto& op : m_nodes)
     {
-        runtime::event::Duration d2(op->description(), "Interpreter");
         if (op->is_parameter())
         {
             continue;
         }
-
-        // get op inputs from map
-        vector<shared_ptr<HostTensor>> op_inputs;
-        for (auto input : op->inputs())
+        auto constant = as_type_ptr<op::Constant>(op);
+        if (constant != nullptr)
         {
-            descriptor::Tensor* tensor = &input.get_tensor();
-            op_inputs.push_back(tensor_map.at(tensor));
+            // Constant outputs alias the Constant's data so there is nothing to compute
+            if (constant_data.insert(constant->get_data_ptr()).second)
+            {
+                m_constant_bytes +=
+                    constant->get_element_type().size() * shape_size(constant->get_shape());
+            }
+            descriptor::Tensor* tensor = &constant->output(0).get_tensor();
+            constant_map.insert({tensor,
+                                 make_shared<HostTensor>(constant->get_output_element_type(0),
+                                                         constant->get_output_shape(0),
+                                                         const_cast<void*>(
+                                                             constant->get_data_ptr()),
+                                                         tensor->get_name())});
+            continue;
         }
 
-        // get op outputs from map or create
-        vector<shared_ptr<HostTensor>> op_outputs;
+        m_op_calls.emplace_back();
+        size_t op_call_index = m_op_calls.size() - 1;
+        OpCall& call = m_op_calls.back();
+        call.node = op;
+        call.type_id = get_typeid(*op);
+        call.type = get_kernel_element_type(*op);
+        call.kernel = get_kernel(call.type);
         for (size_t i = 0; i < op->get_output_size(); ++i)
         {
             descriptor::Tensor* tensor = &op->output(i).get_tensor();
-            shared_ptr<HostTensor> host_tensor;
-            auto it = tensor_map.find(tensor);
-            if (it == tensor_map.end())
+            auto it = result_map.find(tensor);
+            if (it != result_map.end())
             {
-                const Shape& shape = op->get_output_shape(i);
-                const element::Type& type = op->get_output_element_type(i);
-                string name = op->output(i).get_tensor().get_name();
-                host_tensor = make_shared<runtime::HostTensor>(type, shape, name);
-                tensor_map.insert({tensor, host_tensor});
+                m_result_bindings[it->second].push_back({op_call_index, i});
             }
             else
             {
-                host_tensor = it->second;
+                m_pool_bindings.push_back({op_call_index, i, true, tensor});
             }
-            op_outputs.push_back(host_tensor);
+            call.outputs.push_back(nullptr);
+        }
+        for (auto input : op->inputs())
+        {
+            descriptor::Tensor* tensor = &input.get_tensor();
+            size_t index = call.inputs.size();
+            auto parameter = parameter_map.find(tensor);
+            auto constant_tensor = constant_map.find(tensor);
+            if (parameter != parameter_map.end())
+            {
+                m_parameter_bindings[parameter->second].push_back({op_call_index, index});
+                call.inputs.push_back(nullptr);
+            }
+            else if (constant_tensor != constant_map.end())
+            {
+                call.inputs.push_back(constant_tensor->second);
+            }
+            else
+            {
+                m_pool_bindings.push_back({op_call_index, index, false, tensor});
+                call.inputs.push_back(nullptr);
+            }
+        }
+    }
+}
+
+unique_ptr<runtime::interpreter::INTExecutable::CallContext>
+    runtime::interpreter::INTExecutable::create_call_context() const
+{
+    unique_ptr<CallContext> context(new CallContext());
+    context->temporary_pool =
+        AlignedBuffer(m_function->get_temporary_pool_size(), get_alignment());
+    context->op_calls = m_op_calls;
+    char* pool = static_cast<char*>(context->temporary_pool.get_ptr());
+    unordered_map<descriptor::Tensor*, shared_ptr<HostTensor>> tensor_map;
+    for (const PoolBinding& binding : m_pool_bindings)
+    {
+        descriptor::Tensor* tensor = binding.tensor;
+        auto it = tensor_map.find(tensor);
+        if (it == tensor_map.end())
+        {
+            auto host_tensor = make_shared<HostTensor>(tensor->get_element_type(),
+                                                       tensor->get_shape(),
+                                                       pool + tensor->get_pool_offset(),
+                                                       tensor->get_name());
+            it = tensor_map.insert({tensor, host_tensor}).first;
+        }
+        OpCall& call = context->op_calls[binding.op_call];
+        (binding.is_output ? call.outputs : call.inputs)[binding.index] = it->second;
+    }
+    if (m_performance_counters_enabled)
+    {
+        context->timers.resize(m_op_calls.size());
+    }
+    return context;
+}
+
+unique_ptr<runtime::interpreter::INTExecutable::CallContext>
+    runtime::interpreter::INTExecutable::acquire_call_context()
+{
+    {
+        lock_guard<mutex> lock(m_context_mutex);
+        if (!m_idle_contexts.empty())
+        {
+            unique_ptr<CallContext> context = move(m_idle_contexts.back());
+            m_idle_contexts.pop_back();
+            return context;
+        }
+    }
+    // Contexts are only created when every existing one is running, so the pool holds as
+    // many contexts as the largest number of concurrent calls
+    unique_ptr<CallContext> context = create_call_context();
+    m_num_contexts++;
+    return context;
+}
+
+void runtime::interpreter::INTExecutable::release_call_context(unique_ptr<CallContext> context)
+{
+    lock_guard<mutex> lock(m_context_mutex);
+    if (!context->timers.empty())
+    {
+        m_op_call_nanoseconds.resize(m_op_calls.size());
+        m_op_call_counts.resize(m_op_calls.size());
+        for (size_t i = 0; i < context->timers.size(); ++i)
+        {
+            m_op_call_nanoseconds[i] += context->timers[i].get_total_nanoseconds();
+            m_op_call_counts[i] += context->timers[i].get_call_count();
         }
+        context->timers.assign(context->timers.size(), stopwatch());
+    }
+    m_idle_contexts.push_back(move(context));
+}
 
-        // get op type
-        element::Type type;
-        if (is_type<op::Convert>(op) || is_type<op::Quantize>(op) || is_type<op::Dequantize>(op) ||
-            is_type<op::ArgMin>(op) || is_type<op::ArgMax>(op))
+void runtime::interpreter::INTExecutable::bind_io_tensors(
+    vector<OpCall>& op_calls,
+    const vector<shared_ptr<runtime::Tensor>>& outputs,
+    const vector<shared_ptr<runtime::Tensor>>& inputs) const
+{
+    NGRAPH_CHECK(inputs.size() == m_parameter_bindings.size(),
+                 "Expected ",
+                 m_parameter_bindings.size(),
+                 " input tensors, got ",
+                 inputs.size());
+    NGRAPH_CHECK(outputs.size() == m_result_bindings.size(),
+                 "Expected ",
+                 m_result_bindings.size(),
+                 " output tensors, got ",
+                 outputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        auto host_tensor = static_pointer_cast<runtime::HostTensor>(inputs[i]);
+        for (const IOBinding& binding : m_parameter_bindings[i])
         {
-            type = op->get_input_element_type(0);
+            op_calls[binding.op_call].inputs[binding.index] = host_tensor;
         }
-        else if (is_type<op::Equal>(op) || is_type<op::Greater>(op) || is_type<op::GreaterEq>(op) ||
-                 is_type<op::Less>(op) || is_type<op::LessEq>(op) || is_type<op::NotEqual>(op))
+    }
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        auto host_tensor = static_pointer_cast<runtime::HostTensor>(outputs[i]);
+        for (const IOBinding& binding : m_result_bindings[i])
+        {
+            op_calls[binding.op_call].outputs[binding.index] = host_tensor;
+        }
+    }
+}
+
+void runtime::interpreter::INTExecutable::release_io_tensors(vector<OpCall>& op_calls) const
+{
+    for (auto& bindings : m_parameter_bindings)
+    {
+        for (const IOBinding& binding : bindings)
         {
-            // Get the type of the second input, not the first
-            // All BinaryElementwiseComparision ops have the same type for inputs
-            // Select has bool for first input and the type we are interested in for the second
-            type = op->get_input_element_type(1);
+            op_calls[binding.op_call].inputs[binding.index] = nullptr;
         }
-        else if (is_type<op::TopK>(op))
+    }
+    for (auto& bindings : m_result_bindings)
+    {
+        for (const IOBinding& binding : bindings)
         {
-            type = op->get_output_element_type(1);
+            op_calls[binding.op_call].outputs[binding.index] = nullptr;
         }
-        else
+    }
+}
+
+bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                               const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    runtime::event::Duration d1("call", "Interpreter");
+
+    // The context goes back to the pool even if an op throws
+    struct ContextGuard
+    {
+        INTExecutable& executable;
+        unique_ptr<CallContext> context;
+        ~ContextGuard()
         {
-            type = op->get_output_element_type(0);
+            executable.release_io_tensors(context->op_calls);
+            executable.m_num_running--;
+            executable.release_call_context(move(context));
         }
+    } guard{*this, acquire_call_context()};
+    size_t running = ++m_num_running;
+    size_t peak = m_peak_running;
+    while (running > peak && !m_peak_running.compare_exchange_weak(peak, running))
+    {
+    }
 
+    vector<OpCall>& op_calls = guard.context->op_calls;
+    vector<stopwatch>& timers = guard.context->timers;
+    bind_io_tensors(op_calls, outputs, inputs);
+    if (m_nan_check_enabled)
+    {
+        vector<shared_ptr<HostTensor>> func_inputs;
+        for (auto tensor : inputs)
+        {
+            func_inputs.push_back(static_pointer_cast<runtime::HostTensor>(tensor));
+        }
+        perform_nan_check(func_inputs);
+    }
+
+    // for each ordered op in the graph
+    for (size_t i = 0; i < op_calls.size(); ++i)
+    {
+        const OpCall& op_call = op_calls[i];
+        runtime::event::Duration d2(op_call.node->description(), "Interpreter");
         if (m_performance_counters_enabled)
         {
-            m_timer_map[op].start();
+            timers[i].start();
         }
-        generate_calls(type, *op.get(), op_outputs, op_inputs);
+        op_call.kernel(*this, op_call);
         if (m_performance_counters_enabled)
         {
-            m_timer_map[op].stop();
+            timers[i].stop();
         }
         if (m_nan_check_enabled)
         {
-            perform_nan_check(op_outputs, op.get());
+            perform_nan_check(op_call.outputs, op_call.node.get());
         }
     }
 
     return true;
 }
 
-void runtime::interpreter::INTExecutable::generate_calls(const element::Type& type,
-                                                         const Node& op,
-                                                         const vector<shared_ptr<HostTensor>>& out,
-                                                         const vector<shared_ptr<HostTensor>>& in)
+element::Type runtime::interpreter::INTExecutable::get_kernel_element_type(const Node& node)
 {
-    stringstream ss;
+    element::Type type;
+    if (is_type<op::Convert>(&node) || is_type<op::Quantize>(&node) ||
+        is_type<op::Dequantize>(&node) || is_type<op::ArgMin>(&node) || is_type<op::ArgMax>(&node))
+    {
+        type = node.get_input_element_type(0);
+    }
+    else if (is_type<op::Equal>(&node) || is_type<op::Greater>(&node) ||
+             is_type<op::GreaterEq>(&node) || is_type<op::Less>(&node) ||
+             is_type<op::LessEq>(&node) || is_type<op::NotEqual>(&node))
+    {
+        // Get the type of the second input, not the first
+        // All BinaryElementwiseComparision ops have the same type for inputs
+        // Select has bool for first input and the type we are interested in for the second
+        type = node.get_input_element_type(1);
+    }
+    else if (is_type<op::TopK>(&node))
+    {
+        type = node.get_output_element_type(1);
+    }
+    else
+    {
+        type = node.get_output_element_type(0);
+    }
+    return type;
+}
+
+runtime::interpreter::INTExecutable::OpCall::Kernel
+    runtime::interpreter::INTExecutable::get_kernel(const element::Type& type) const
+{
+    OpCall::Kernel kernel = nullptr;
     switch (type)
     {
-    case element::Type_t::boolean: op_engine<char>(op, out, in); break;
-    case element::Type_t::f32: op_engine<float>(op, out, in); break;
-    case element::Type_t::f64: op_engine<double>(op, out, in); break;
-    case element::Type_t::i8: op_engine<int8_t>(op, out, in); break;
-    case element::Type_t::i16: op_engine<int16_t>(op, out, in); break;
-    case element::Type_t::i32: op_engine<int32_t>(op, out, in); break;
-    case element::Type_t::i64: op_engine<int64_t>(op, out, in); break;
-    case element::Type_t::u8: op_engine<uint8_t>(op, out, in); break;
-    case element::Type_t::u16: op_engine<uint16_t>(op, out, in); break;
-    case element::Type_t::u32: op_engine<uint32_t>(op, out, in); break;
-    case element::Type_t::u64: op_engine<uint64_t>(op, out, in); break;
+    case element::Type_t::boolean: kernel = op_engine_kernel<char>; break;
+    case element::Type_t::f32: kernel = op_engine_kernel<float>; break;
+    case element::Type_t::f64: kernel = op_engine_kernel<double>; break;
+    case element::Type_t::i8: kernel = op_engine_kernel<int8_t>; break;
+    case element::Type_t::i16: kernel = op_engine_kernel<int16_t>; break;
+    case element::Type_t::i32: kernel = op_engine_kernel<int32_t>; break;
+    case element::Type_t::i64: kernel = op_engine_kernel<int64_t>; break;
+    case element::Type_t::u8: kernel = op_engine_kernel<uint8_t>; break;
+    case element::Type_t::u16: kernel = op_engine_kernel<uint16_t>; break;
+    case element::Type_t::u32: kernel = op_engine_kernel<uint32_t>; break;
+    case element::Type_t::u64: kernel = op_engine_kernel<uint64_t>; break;
     case element::Type_t::undefined:
     case element::Type_t::dynamic:
     case element::Type_t::u1:
     case element::Type_t::bf16:
-    case element::Type_t::f16:
-        ss << "unsupported element type " << type << " op " << op.get_name();
-        throw ngraph_error(ss.str());
+    case element::Type_t::f16: kernel = unsupported_type_kernel; break;
     }
+    return kernel;
+}
+
+void runtime::interpreter::INTExecutable::unsupported_type_kernel(INTExecutable& /* executable */,
+                                                                  const OpCall& call)
+{
+    stringstream ss;
+    ss << "unsupported element type " << call.type << " op " << call.node->get_name();
+    throw ngraph_error(ss.str());
 }
 
 void runtime::interpreter::INTExecutable::set_nan_check(bool enable)
@@ -266,13 +454,30 @@ vector<runtime::PerformanceCounter>
     runtime::interpreter::INTExecutable::get_performance_data() const
 {
     vector<runtime::PerformanceCounter> rc;
-    for (const pair<shared_ptr<const Node>, stopwatch> p : m_timer_map)
+    lock_guard<mutex> lock(m_context_mutex);
+    for (size_t i = 0; i < m_op_call_counts.size(); ++i)
     {
-        rc.emplace_back(p.first, p.second.get_total_microseconds(), p.second.get_call_count());
+        if (m_op_call_counts[i] > 0)
+        {
+            rc.emplace_back(
+                m_op_calls[i].node, m_op_call_nanoseconds[i] / 1000, m_op_call_counts[i]);
+        }
     }
     return rc;
 }
 
+runtime::MemoryReport runtime::interpreter::INTExecutable::get_memory_report() const
+{
+    // Each concurrent call runs out of its own context, and contexts are kept once created
+    MemoryReport report;
+    report.activation_bytes = m_function->get_temporary_pool_size();
+    report.constant_bytes = m_constant_bytes;
+    report.contexts = m_num_contexts;
+    report.allocated_contexts = m_num_contexts;
+    report.peak_call_bytes = m_peak_running * report.activation_bytes;
+    return report;
+}
+
 void runtime::interpreter::INTExecutable::perform_nan_check(
     const vector<shared_ptr<HostTensor>>& tensors, const Node* op)
 {
@@ -325,10 +530,13 @@ void runtime::interpreter::INTExecutable::perform_nan_check(
 void runtime::interpreter::INTExecutable::save(ostream& out)
 {
     cpio::Writer writer(out);
-    string si = "INTERPRETER Save File 1.0";
+    string si = "INTERPRETER Save File 1.2";
     writer.write("save_info", si.data(), si.size());
-    string model = serialize(m_function, 0);
-    writer.write("model", model.data(), model.size());
+    // Constant data is stored as raw bytes rather than as decimal text
+    stringstream model;
+    serialize_binary(model, m_function, 0);
+    string model_string = model.str();
+    writer.write("model", model_string.data(), model_string.size());
 }
 
 shared_ptr<ngraph::op::Parameter>
@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <initializer_list>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -161,6 +163,8 @@ public:
 
     std::vector<PerformanceCounter> get_performance_data() const override;
 
+    MemoryReport get_memory_report() const override;
+
     std::shared_ptr<runtime::Tensor> create_input_tensor(size_t input_index) override;
 
     std::shared_ptr<runtime::Tensor> create_output_tensor(size_t output_index) override;
@@ -181,23 +185,103 @@ protected:
     bool m_nan_check_enabled = false;
     bool m_performance_counters_enabled = false;
     std::shared_ptr<Function> m_function;
-    std::unordered_map<std::shared_ptr<const Node>, stopwatch> m_timer_map;
     std::vector<std::shared_ptr<Node>> m_nodes;
     std::unordered_map<const Node*, std::shared_ptr<State>> m_states;
     std::set<std::string> m_unsupported_op_name_list;
 
+    /// \brief An op lowered for execution. The kernel, op type and tensors are resolved once
+    ///        at compile time so call() does no per-op lookups.
+    struct OpCall
+    {
+        using Kernel = void (*)(INTExecutable&, const OpCall&);
+
+        std::shared_ptr<Node> node;
+        OP_TYPEID type_id;
+        element::Type type;
+        Kernel kernel;
+        std::vector<std::shared_ptr<HostTensor>> inputs;
+        std::vector<std::shared_ptr<HostTensor>> outputs;
+    };
+
+    /// \brief Location of a function input or output tensor within m_op_calls
+    struct IOBinding
+    {
+        size_t op_call;
+        size_t index;
+    };
+
+    /// \brief Location of an intermediate tensor within m_op_calls. Each call context
+    ///        binds it at the tensor's pool offset in its own temporary pool.
+    struct PoolBinding
+    {
+        size_t op_call;
+        size_t index;
+        bool is_output;
+        descriptor::Tensor* tensor;
+    };
+
+    /// \brief The temporary pool and op calls used by one running call
+    struct CallContext
+    {
+        AlignedBuffer temporary_pool;
+        std::vector<OpCall> op_calls;
+        /// \brief Per op call timers, only used with performance counters enabled. They are
+        ///        added to the executable's totals when the context is released.
+        std::vector<stopwatch> timers;
+    };
+
+    // Static buffer plan built once at compile time. m_op_calls holds the lowered ops with
+    // constants bound to the Constant's own data; intermediate tensors are bound per call
+    // context, so concurrent calls each run out of their own copy of the temporary pool.
+    size_t m_constant_bytes = 0;
+    std::vector<OpCall> m_op_calls;
+    std::vector<PoolBinding> m_pool_bindings;
+    std::vector<std::vector<IOBinding>> m_parameter_bindings;
+    std::vector<std::vector<IOBinding>> m_result_bindings;
+
+    mutable std::mutex m_context_mutex;
+    std::vector<std::unique_ptr<CallContext>> m_idle_contexts;
+    // Time and call count of each op call over the released contexts, guarded by
+    // m_context_mutex
+    std::vector<size_t> m_op_call_nanoseconds;
+    std::vector<size_t> m_op_call_counts;
+    std::atomic<size_t> m_num_contexts{0};
+    std::atomic<size_t> m_num_running{0};
+    std::atomic<size_t> m_peak_running{0};
+
+    /// \brief Lower m_nodes into m_op_calls.
+    ///        Requires the Liveness and MemoryLayout passes to have been run.
+    void build_op_calls();
+    std::unique_ptr<CallContext> create_call_context() const;
+    std::unique_ptr<CallContext> acquire_call_context();
+    void release_call_context(std::unique_ptr<CallContext> context);
+    void bind_io_tensors(std::vector<OpCall>& op_calls,
+                         const std::vector<std::shared_ptr<Tensor>>& outputs,
+                         const std::vector<std::shared_ptr<Tensor>>& inputs) const;
+    void release_io_tensors(std::vector<OpCall>& op_calls) const;
+
     static OP_TYPEID get_typeid(const Node& node);
 
+    /// \brief The element type that selects the op_engine instantiation for node
+    static element::Type get_kernel_element_type(const Node& node);
+
     static void perform_nan_check(const std::vector<std::shared_ptr<HostTensor>>&,
                                   const Node* op = nullptr);
 
-    virtual void generate_calls(const element::Type& type,
-                                const Node& op,
-                                const std::vector<std::shared_ptr<HostTensor>>& outputs,
-                                const std::vector<std::shared_ptr<HostTensor>>& inputs);
+    /// \brief Select the kernel that runs ops of element type type
+    virtual OpCall::Kernel get_kernel(const element::Type& type) const;
+
+    static void unsupported_type_kernel(INTExecutable& executable, const OpCall& call);
+
+    template <typename T>
+    static void op_engine_kernel(INTExecutable& executable, const OpCall& call)
+    {
+        executable.op_engine<T>(*call.node, call.type_id, call.outputs, call.inputs);
+    }
 
     template <typename T>
     void op_engine(const Node& node,
+                   OP_TYPEID type_id,
                    const std::vector<std::shared_ptr<HostTensor>>& out,
                    const std::vector<std::shared_ptr<HostTensor>>& args)
     {
@@ -209,7 +293,7 @@ protected:
 #pragma GCC diagnostic error "-Wswitch"
 #pragma GCC diagnostic error "-Wswitch-enum"
 #endif
-        switch (get_typeid(node))
+        switch (type_id)
         {
         case OP_TYPEID::Abs:
         {
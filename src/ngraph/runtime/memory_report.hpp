@@ -0,0 +1,55 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+
+#include "ngraph/ngraph_visibility.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        /// \brief Memory held by a compiled Executable
+        struct NGRAPH_API MemoryReport
+        {
+            /// \brief Size of the buffers the buffer plan assigns to intermediate values, for
+            ///        one execution context
+            size_t activation_bytes = 0;
+            /// \brief Size of the constant and weight data. Buffers shared between constants
+            ///        are counted once.
+            size_t constant_bytes = 0;
+            /// \brief Size of the MKLDNN scratchpad of one execution context
+            size_t scratchpad_bytes = 0;
+            /// \brief Number of execution contexts, each of which can run one call at a time
+            size_t contexts = 0;
+            /// \brief Number of execution contexts currently holding their own activation and
+            ///        scratchpad memory
+            size_t allocated_contexts = 0;
+            /// \brief Largest activation and scratchpad memory held at once by running calls
+            size_t peak_call_bytes = 0;
+
+            /// \brief Activation and scratchpad memory duplicated in each allocated context
+            size_t context_bytes() const { return activation_bytes + scratchpad_bytes; }
+            /// \brief Memory currently held
+            size_t allocated_bytes() const
+            {
+                return constant_bytes + allocated_contexts * context_bytes();
+            }
+        };
+    }
+}
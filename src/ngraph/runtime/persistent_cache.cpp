@@ -0,0 +1,186 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstdio>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <typeinfo>
+
+#include "ngraph/cpio.hpp"
+#include "ngraph/env_util.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/persistent_cache.hpp"
+#include "ngraph/serializer.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::PersistentCache::PersistentCache(const string& directory)
+    : m_directory(directory)
+{
+    if (!file_util::exists(m_directory))
+    {
+        file_util::make_directory(m_directory);
+    }
+}
+
+runtime::PersistentCache::~PersistentCache()
+{
+}
+
+shared_ptr<runtime::PersistentCache> runtime::PersistentCache::create_default()
+{
+    shared_ptr<PersistentCache> cache;
+    string directory = getenv_string("NGRAPH_COMPILATION_CACHE_DIR");
+    if (!directory.empty())
+    {
+        cache = make_shared<PersistentCache>(directory);
+    }
+    return cache;
+}
+
+string runtime::PersistentCache::get_key(const shared_ptr<Function>& func,
+                                         const Backend& backend,
+                                         const pass::PassConfig& pass_config,
+                                         bool enable_performance_data)
+{
+    stringstream key;
+    key << typeid(backend).name() << " " << backend.get_version() << "\n";
+    key << NGRAPH_VERSION << "\n";
+    for (auto& enable : pass_config.get_enables())
+    {
+        key << enable.first << ":" << enable.second << ";";
+    }
+    key << "\n";
+    for (auto& attribute : pass_config.get_pass_attributes())
+    {
+        key << attribute.first << "=" << attribute.second << ";";
+    }
+    key << "\n";
+    key << enable_performance_data << "\n";
+    key << serialize_canonical(func);
+    return key.str();
+}
+
+string runtime::PersistentCache::get_path(const string& key) const
+{
+    // The full key is stored with the entry and compared on load, so a collision only costs a
+    // recompilation.
+    FNV1aHash hash;
+    hash.add_bytes(key.data(), key.size());
+    stringstream name;
+    name << hex << setw(16) << setfill('0') << hash.get() << ".cache";
+    return file_util::path_join(m_directory, name.str());
+}
+
+shared_ptr<runtime::Executable> runtime::PersistentCache::load(Backend& backend,
+                                                               const string& key)
+{
+    shared_ptr<Executable> exec;
+    string path = get_path(key);
+    if (file_util::exists(path))
+    {
+        try
+        {
+            cpio::Reader reader(path);
+            string stored_key;
+            string saved_executable;
+            for (const cpio::FileInfo& info : reader.get_file_info())
+            {
+                vector<char> buffer = reader.read(info);
+                if (info.get_name() == "key")
+                {
+                    stored_key = string(buffer.data(), buffer.size());
+                }
+                else if (info.get_name() == "executable")
+                {
+                    saved_executable = string(buffer.data(), buffer.size());
+                }
+            }
+            if (stored_key == key)
+            {
+                stringstream in(saved_executable);
+                exec = backend.load(in);
+            }
+        }
+        catch (const exception& e)
+        {
+            NGRAPH_WARN << "Unable to load compilation cache entry '" << path << "': " << e.what();
+        }
+    }
+    return exec;
+}
+
+void runtime::PersistentCache::save(Executable& exec, const string& key)
+{
+    stringstream saved_executable;
+    exec.save(saved_executable);
+    string executable = saved_executable.str();
+
+    // Write to a unique temporary file and rename it, so concurrent readers and writers of the
+    // same entry never see a partial file
+    string path = get_path(key);
+    random_device rd;
+    string temp_path = path + "." + to_string(rd()) + ".tmp";
+    {
+        cpio::Writer writer(temp_path);
+        writer.write("key", key.data(), key.size());
+        writer.write("executable", executable.data(), executable.size());
+    }
+    if (rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        file_util::remove_file(temp_path);
+        throw runtime_error("Unable to write compilation cache entry '" + path + "'");
+    }
+}
+
+shared_ptr<runtime::Executable> runtime::PersistentCache::compile(
+    Backend& backend,
+    const shared_ptr<Function>& func,
+    const pass::PassConfig& pass_config,
+    bool enable_performance_data,
+    const function<shared_ptr<Executable>()>& compile_function)
+{
+    string key;
+    try
+    {
+        key = get_key(func, backend, pass_config, enable_performance_data);
+    }
+    catch (const exception& e)
+    {
+        NGRAPH_DEBUG << "Compiling without the compilation cache: " << e.what();
+        return compile_function();
+    }
+
+    shared_ptr<Executable> exec = load(backend, key);
+    if (!exec)
+    {
+        exec = compile_function();
+        try
+        {
+            save(*exec, key);
+        }
+        catch (const exception& e)
+        {
+            NGRAPH_WARN << "Unable to save compilation cache entry: " << e.what();
+        }
+    }
+    return exec;
+}
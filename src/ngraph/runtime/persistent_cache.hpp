@@ -0,0 +1,93 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "ngraph/function.hpp"
+#include "ngraph/pass/pass_config.hpp"
+#include "ngraph/runtime/executable.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class Backend;
+        class PersistentCache;
+    }
+}
+
+/// \brief Cache of compiled executables kept in a directory, so that processes compiling the
+///        same function on the same backend reuse each other's work.
+///
+/// Executables are stored with Executable::save and restored with Backend::load, so only
+/// backends implementing both benefit. An entry is keyed by a fingerprint of the function's
+/// canonical serialization, which covers its structure, attributes and a hash of its constant
+/// data, together with the backend type and version, the nGraph version, the pass configuration
+/// and whether performance data is collected. Entries are written atomically, so several
+/// processes may share a directory. Lookups and stores that fail, for example because the
+/// serializer is disabled in the build, fall back to compiling without the cache.
+///
+/// Backends whose load skips compilation use the cache returned by
+/// Backend::get_persistent_cache: INTERPRETER, and CPU when it builds for direct execution
+/// (DEX), in which case load restores the function as its passes left it. It is off unless
+/// NGRAPH_COMPILATION_CACHE_DIR is set or a cache is given to Backend::set_persistent_cache,
+/// and the default cache is only created when such a backend first compiles. Derive from this
+/// class to keep entries somewhere else.
+class NGRAPH_API ngraph::runtime::PersistentCache
+{
+public:
+    /// \param directory Directory holding the entries, created if it does not exist. Throws
+    ///        if it cannot be created.
+    PersistentCache(const std::string& directory);
+    virtual ~PersistentCache();
+
+    /// \brief The cache in NGRAPH_COMPILATION_CACHE_DIR, or nullptr if it is not set
+    static std::shared_ptr<PersistentCache> create_default();
+
+    /// \brief Returns the key under which an executable compiled from func is stored
+    static std::string get_key(const std::shared_ptr<Function>& func,
+                               const Backend& backend,
+                               const pass::PassConfig& pass_config,
+                               bool enable_performance_data);
+
+    /// \brief Returns the executable stored for key, loaded by backend, or nullptr if there is
+    ///        none
+    virtual std::shared_ptr<Executable> load(Backend& backend, const std::string& key);
+
+    /// \brief Stores exec under key, replacing any existing entry
+    virtual void save(Executable& exec, const std::string& key);
+
+    /// \brief Returns the stored executable for func if there is one, otherwise calls compile
+    ///        and stores its result
+    std::shared_ptr<Executable>
+        compile(Backend& backend,
+                const std::shared_ptr<Function>& func,
+                const pass::PassConfig& pass_config,
+                bool enable_performance_data,
+                const std::function<std::shared_ptr<Executable>()>& compile_function);
+
+    const std::string& get_directory() const { return m_directory; }
+protected:
+    /// \brief Path of the file holding the entry for key
+    std::string get_path(const std::string& key) const;
+
+private:
+    std::string m_directory;
+};
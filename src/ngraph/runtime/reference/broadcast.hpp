@@ -18,8 +18,10 @@
 
 #include <cmath>
 
+#include "ngraph/check.hpp"
 #include "ngraph/coordinate_transform.hpp"
 #include "ngraph/shape_util.hpp"
+#include "ngraph/strided_iterator.hpp"
 
 namespace ngraph
 {
@@ -34,33 +36,34 @@ namespace ngraph
                            const Shape& out_shape,
                            const AxisSet& broadcast_axes)
             {
-                // Remove all broadcast axes from in_shape
-                Shape adjusted_in_shape;
-                for (auto length : in_shape)
-                {
-                    if (length != 1)
-                    {
-                        adjusted_in_shape.push_back(length);
-                    }
-                }
-                // Remove 1s from out_shape
+                // Axes of length 1 in out_shape may or may not be present in in_shape, so treat
+                // them as broadcast and let every axis of out_shape that remains index arg in
+                // row-major order.
                 AxisSet adjusted_axes(broadcast_axes);
                 for (uint64_t axis = 0; axis < out_shape.size(); ++axis)
                 {
-                    auto length = out_shape.at(axis);
-                    if (length == 1)
+                    if (out_shape.at(axis) == 1)
                     {
                         adjusted_axes.insert(axis);
                     }
                 }
-                CoordinateTransform input_transform(adjusted_in_shape);
-                CoordinateTransform output_transform(out_shape);
+                NGRAPH_CHECK(shape_size(reduce(out_shape, adjusted_axes)) == shape_size(in_shape),
+                             "Broadcast input shape ",
+                             in_shape,
+                             " is not compatible with output shape ",
+                             out_shape);
 
-                for (const Coordinate& output_coord : output_transform)
+                StridedIterator it(out_shape,
+                                   {StridedIterator::reduced_strides(out_shape, adjusted_axes)});
+                T* out_ptr = out;
+                for (; !it.done(); it.next_row())
                 {
-                    Coordinate input_coord = reduce(output_coord, adjusted_axes);
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
+                    const T* in_ptr = arg + it.get_offset(0);
+                    size_t in_stride = it.get_inner_stride(0);
+                    for (size_t i = 0; i < it.get_inner_size(); ++i, in_ptr += in_stride)
+                    {
+                        *out_ptr++ = *in_ptr;
+                    }
                 }
             }
         }
@@ -16,12 +16,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
+#include <vector>
 
 #include <cfenv>
 #include <functional>
 #include "convolution.hpp"
+#include "ngraph/check.hpp"
 #include "ngraph/coordinate_transform.hpp"
 #include "ngraph/shape_util.hpp"
 
@@ -31,6 +34,109 @@ namespace ngraph
     {
         namespace reference
         {
+            // Block sizes for dot_matrix_matrix. A block of DOT_BLOCK_M x DOT_BLOCK_N accumulators
+            // and a DOT_BLOCK_K x DOT_BLOCK_N panel of arg1 stay in cache while it is reused for
+            // every row of the block.
+            constexpr size_t DOT_BLOCK_M = 32;
+            constexpr size_t DOT_BLOCK_N = 128;
+            constexpr size_t DOT_BLOCK_K = 128;
+
+            /// \brief value as an ACCUMULATION, less zero_point when QUANTIZED. QUANTIZED is a
+            ///        template argument so the plain instantiations are a bare multiply-add.
+            template <bool QUANTIZED, typename ACCUMULATION, typename INPUT>
+            ACCUMULATION dot_operand(INPUT value, ACCUMULATION zero_point)
+            {
+                return QUANTIZED ? static_cast<ACCUMULATION>(value) - zero_point
+                                 : static_cast<ACCUMULATION>(value);
+            }
+
+            /// \brief Product of an m x k row-major matrix and a k-vector. write_output is called
+            ///        with each output index and its accumulated sum.
+            template <bool QUANTIZED,
+                      typename INPUT0,
+                      typename INPUT1,
+                      typename ACCUMULATION,
+                      typename WRITE>
+            void dot_matrix_vector(const INPUT0* arg0,
+                                   const INPUT1* arg1,
+                                   size_t m,
+                                   size_t k,
+                                   ACCUMULATION zero_point0,
+                                   ACCUMULATION zero_point1,
+                                   WRITE write_output)
+            {
+                for (size_t i = 0; i < m; ++i)
+                {
+                    const INPUT0* arg0_row = arg0 + i * k;
+                    ACCUMULATION sum = 0;
+                    for (size_t p = 0; p < k; ++p)
+                    {
+                        sum += dot_operand<QUANTIZED>(arg0_row[p], zero_point0) *
+                               dot_operand<QUANTIZED>(arg1[p], zero_point1);
+                    }
+                    write_output(i, sum);
+                }
+            }
+
+            /// \brief Cache-blocked product of an m x k and a k x n row-major matrix.
+            ///        write_output is called with each output index and its accumulated sum.
+            ///
+            /// The innermost loop runs along a contiguous row of arg1 and of the accumulators so
+            /// it can be vectorized. Each output still accumulates its products in order of
+            /// increasing k, so results match the naive triple loop exactly.
+            template <bool QUANTIZED,
+                      typename INPUT0,
+                      typename INPUT1,
+                      typename ACCUMULATION,
+                      typename WRITE>
+            void dot_matrix_matrix(const INPUT0* arg0,
+                                   const INPUT1* arg1,
+                                   size_t m,
+                                   size_t k,
+                                   size_t n,
+                                   ACCUMULATION zero_point0,
+                                   ACCUMULATION zero_point1,
+                                   WRITE write_output)
+            {
+                std::vector<ACCUMULATION> acc(DOT_BLOCK_M * DOT_BLOCK_N);
+                for (size_t i0 = 0; i0 < m; i0 += DOT_BLOCK_M)
+                {
+                    size_t i_end = std::min(m, i0 + DOT_BLOCK_M);
+                    for (size_t j0 = 0; j0 < n; j0 += DOT_BLOCK_N)
+                    {
+                        size_t j_count = std::min(n, j0 + DOT_BLOCK_N) - j0;
+                        std::fill(acc.begin(), acc.end(), ACCUMULATION(0));
+                        for (size_t p0 = 0; p0 < k; p0 += DOT_BLOCK_K)
+                        {
+                            size_t p_end = std::min(k, p0 + DOT_BLOCK_K);
+                            for (size_t i = i0; i < i_end; ++i)
+                            {
+                                ACCUMULATION* acc_row = &acc[(i - i0) * DOT_BLOCK_N];
+                                for (size_t p = p0; p < p_end; ++p)
+                                {
+                                    ACCUMULATION a =
+                                        dot_operand<QUANTIZED>(arg0[i * k + p], zero_point0);
+                                    const INPUT1* arg1_row = arg1 + p * n + j0;
+                                    for (size_t j = 0; j < j_count; ++j)
+                                    {
+                                        acc_row[j] +=
+                                            a * dot_operand<QUANTIZED>(arg1_row[j], zero_point1);
+                                    }
+                                }
+                            }
+                        }
+                        for (size_t i = i0; i < i_end; ++i)
+                        {
+                            const ACCUMULATION* acc_row = &acc[(i - i0) * DOT_BLOCK_N];
+                            for (size_t j = 0; j < j_count; ++j)
+                            {
+                                write_output(i * n + j0 + j, acc_row[j]);
+                            }
+                        }
+                    }
+                }
+            }
+
             template <typename INPUT0,
                       typename INPUT1,
                       typename OUTPUT,
@@ -58,112 +164,58 @@ namespace ngraph
 
                 auto old_mode = std::fegetround();
                 std::fesetround(FE_TONEAREST);
-                // Get the sizes of the dot axes. It's easiest to pull them from arg1 because
-                // they're right up front.
-                Shape dot_axis_sizes(reduction_axes_count);
-                std::copy(arg1_shape.begin(),
-                          arg1_shape.begin() + reduction_axes_count,
-                          dot_axis_sizes.begin());
-
-                CoordinateTransform arg0_transform(arg0_shape);
-                CoordinateTransform arg1_transform(arg1_shape);
-                CoordinateTransform output_transform(out_shape);
 
-                // Create coordinate transforms for arg0 and arg1 that throw away the dotted axes.
+                // The dotted axes are the trailing reduction_axes_count axes of arg0 and the
+                // leading reduction_axes_count axes of arg1, and the output is the concatenation
+                // of the remaining axes. In row-major order this is a plain matrix product of an
+                // M x K matrix with a K x N matrix, so no coordinates are needed.
                 size_t arg0_projected_rank = arg0_shape.size() - reduction_axes_count;
-                size_t arg1_projected_rank = arg1_shape.size() - reduction_axes_count;
-
-                Shape arg0_projected_shape(arg0_projected_rank);
-                std::copy(arg0_shape.begin(),
-                          arg0_shape.begin() + arg0_projected_rank,
-                          arg0_projected_shape.begin());
-
-                Shape arg1_projected_shape(arg1_projected_rank);
-                std::copy(arg1_shape.begin() + reduction_axes_count,
-                          arg1_shape.end(),
-                          arg1_projected_shape.begin());
-
-                CoordinateTransform arg0_projected_transform(arg0_projected_shape);
-                CoordinateTransform arg1_projected_transform(arg1_projected_shape);
-
-                // Create a coordinate transform that allows us to iterate over all possible values
-                // for the dotted axes.
-                CoordinateTransform dot_axes_transform(dot_axis_sizes);
-
-                for (const Coordinate& arg0_projected_coord : arg0_projected_transform)
+                size_t m = shape_size(
+                    Shape(arg0_shape.begin(), arg0_shape.begin() + arg0_projected_rank));
+                size_t k = shape_size(
+                    Shape(arg1_shape.begin(), arg1_shape.begin() + reduction_axes_count));
+                size_t n =
+                    shape_size(Shape(arg1_shape.begin() + reduction_axes_count, arg1_shape.end()));
+                NGRAPH_CHECK(shape_size(out_shape) == m * n,
+                             "Dot output shape ",
+                             out_shape,
+                             " does not match the projected input shapes");
+
+                if (is_quantized)
                 {
-                    for (const Coordinate& arg1_projected_coord : arg1_projected_transform)
+                    ACCUMULATION zero_point0 = static_cast<ACCUMULATION>(*input0_zero_point);
+                    ACCUMULATION zero_point1 = static_cast<ACCUMULATION>(*input1_zero_point);
+                    float scale = *input0_scale * *input1_scale / *output_scale;
+                    auto write_output = [&](size_t index, ACCUMULATION sum) {
+                        out[index] =
+                            static_cast<OUTPUT>(std::round(static_cast<float>(sum) * scale)) +
+                            *output_zero_point;
+                    };
+                    if (n == 1)
                     {
-                        // The output coordinate is just the concatenation of the projected
-                        // coordinates.
-                        Coordinate out_coord(arg0_projected_coord.size() +
-                                             arg1_projected_coord.size());
-
-                        auto out_coord_it = std::copy(arg0_projected_coord.begin(),
-                                                      arg0_projected_coord.end(),
-                                                      out_coord.begin());
-                        std::copy(
-                            arg1_projected_coord.begin(), arg1_projected_coord.end(), out_coord_it);
-
-                        // Zero out to start the sum.
-                        ACCUMULATION sum = 0;
-
-                        size_t out_index = output_transform.index(out_coord);
-
-                        // Walk along the dotted axes.
-                        Coordinate arg0_coord(arg0_shape.size());
-                        Coordinate arg1_coord(arg1_shape.size());
-                        auto arg0_it = std::copy(arg0_projected_coord.begin(),
-                                                 arg0_projected_coord.end(),
-                                                 arg0_coord.begin());
-                        for (const Coordinate& dot_axis_positions : dot_axes_transform)
-                        {
-                            // In order to find the points to multiply together, we need to inject
-                            // our current positions along the dotted axes back into the projected
-                            // arg0 and arg1 coordinates.
-                            std::copy(
-                                dot_axis_positions.begin(), dot_axis_positions.end(), arg0_it);
-
-                            auto arg1_it = std::copy(dot_axis_positions.begin(),
-                                                     dot_axis_positions.end(),
-                                                     arg1_coord.begin());
-                            std::copy(
-                                arg1_projected_coord.begin(), arg1_projected_coord.end(), arg1_it);
-
-                            // Multiply and add to the sum.
-                            if (is_quantized)
-                            {
-                                sum += (static_cast<ACCUMULATION>(
-                                            arg0[arg0_transform.index(arg0_coord)]) -
-                                        static_cast<ACCUMULATION>(*input0_zero_point)) *
-                                       (static_cast<ACCUMULATION>(
-                                            arg1[arg1_transform.index(arg1_coord)]) -
-                                        static_cast<ACCUMULATION>(*input1_zero_point));
-                            }
-                            else
-                            {
-                                sum += static_cast<ACCUMULATION>(
-                                           arg0[arg0_transform.index(arg0_coord)]) *
-                                       static_cast<ACCUMULATION>(
-                                           arg1[arg1_transform.index(arg1_coord)]);
-                            }
-                        }
-
-                        if (is_quantized)
-                        {
-                            float scale = *input0_scale * *input1_scale / *output_scale;
-                            // Write the sum back.
-                            out[out_index] =
-                                static_cast<OUTPUT>(std::round(static_cast<float>(sum) * scale)) +
-                                *output_zero_point;
-                        }
-                        else
-                        {
-                            out[out_index] = sum;
-                        }
+                        dot_matrix_vector<true>(
+                            arg0, arg1, m, k, zero_point0, zero_point1, write_output);
+                    }
+                    else
+                    {
+                        dot_matrix_matrix<true>(
+                            arg0, arg1, m, k, n, zero_point0, zero_point1, write_output);
+                    }
+                }
+                else
+                {
+                    auto write_output = [&](size_t index, ACCUMULATION sum) { out[index] = sum; };
+                    ACCUMULATION zero = 0;
+                    if (n == 1)
+                    {
+                        dot_matrix_vector<false>(arg0, arg1, m, k, zero, zero, write_output);
+                    }
+                    else
+                    {
+                        dot_matrix_matrix<false>(arg0, arg1, m, k, n, zero, zero, write_output);
                     }
-                    std::fesetround(old_mode);
                 }
+                std::fesetround(old_mode);
             }
         }
     }
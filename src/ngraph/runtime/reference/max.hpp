@@ -16,11 +16,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
 #include "ngraph/coordinate_transform.hpp"
 #include "ngraph/shape_util.hpp"
+#include "ngraph/strided_iterator.hpp"
 
 namespace ngraph
 {
@@ -39,24 +41,23 @@ namespace ngraph
                                ? T(-std::numeric_limits<T>::infinity())
                                : std::numeric_limits<T>::min();
 
-                CoordinateTransform output_transform(out_shape);
+                size_t out_size = shape_size(out_shape);
+                std::fill(out, out + out_size, minval);
 
-                for (const Coordinate& output_coord : output_transform)
+                StridedIterator it(in_shape,
+                                   {StridedIterator::reduced_strides(in_shape, reduction_axes)});
+                const T* x_ptr = arg;
+                for (; !it.done(); it.next_row())
                 {
-                    out[output_transform.index(output_coord)] = minval;
-                }
-
-                CoordinateTransform input_transform(in_shape);
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    Coordinate output_coord = reduce(input_coord, reduction_axes);
-
-                    T x = arg[input_transform.index(input_coord)];
-                    T max = out[output_transform.index(output_coord)];
-                    if (x > max)
+                    size_t out_index = it.get_offset(0);
+                    size_t out_stride = it.get_inner_stride(0);
+                    for (size_t i = 0; i < it.get_inner_size(); ++i, out_index += out_stride)
                     {
-                        out[output_transform.index(output_coord)] = x;
+                        T x = *x_ptr++;
+                        if (x > out[out_index])
+                        {
+                            out[out_index] = x;
+                        }
                     }
                 }
             }
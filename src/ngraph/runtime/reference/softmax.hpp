@@ -17,10 +17,13 @@
 #pragma once
 
 #include <cmath>
+#include <vector>
+
 #include "ngraph/coordinate_transform.hpp"
 #include "ngraph/runtime/reference/max.hpp"
 #include "ngraph/runtime/reference/sum.hpp"
 #include "ngraph/shape_util.hpp"
+#include "ngraph/strided_iterator.hpp"
 
 namespace ngraph
 {
@@ -33,28 +36,34 @@ namespace ngraph
             {
                 auto temp_shape = reduce(shape, axes);
                 auto temp_elements = shape_size(temp_shape);
-                auto temp_ptr = new T[temp_elements];
+                std::vector<T> temp(temp_elements);
+                Strides temp_strides = StridedIterator::reduced_strides(shape, axes);
 
-                max(arg, temp_ptr, shape, temp_shape, axes);
+                max(arg, temp.data(), shape, temp_shape, axes);
 
-                CoordinateTransform transform(shape);
-                CoordinateTransform temp_transform(temp_shape);
-                for (const Coordinate& coord : transform)
+                size_t index = 0;
+                for (StridedIterator it(shape, {temp_strides}); !it.done(); it.next_row())
                 {
-                    Coordinate temp_coord = reduce(coord, axes);
-                    out[transform.index(coord)] = std::exp(
-                        arg[transform.index(coord)] - temp_ptr[temp_transform.index(temp_coord)]);
+                    size_t temp_index = it.get_offset(0);
+                    for (size_t i = 0; i < it.get_inner_size(); ++i, ++index)
+                    {
+                        out[index] = std::exp(arg[index] - temp[temp_index]);
+                        temp_index += it.get_inner_stride(0);
+                    }
                 }
 
-                sum(out, temp_ptr, shape, temp_shape, axes);
+                sum(out, temp.data(), shape, temp_shape, axes);
 
-                for (const Coordinate& coord : transform)
+                index = 0;
+                for (StridedIterator it(shape, {temp_strides}); !it.done(); it.next_row())
                 {
-                    Coordinate temp_coord = reduce(coord, axes);
-                    out[transform.index(coord)] /= temp_ptr[temp_transform.index(temp_coord)];
+                    size_t temp_index = it.get_offset(0);
+                    for (size_t i = 0; i < it.get_inner_size(); ++i, ++index)
+                    {
+                        out[index] /= temp[temp_index];
+                        temp_index += it.get_inner_stride(0);
+                    }
                 }
-
-                delete[] temp_ptr;
             }
         }
     }
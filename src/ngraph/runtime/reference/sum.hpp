@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
 #include "ngraph/coordinate_transform.hpp"
 #include "ngraph/shape_util.hpp"
+#include "ngraph/strided_iterator.hpp"
 #include "ngraph/type/bfloat16.hpp"
 #include "ngraph/type/float16.hpp"
 
@@ -59,34 +61,33 @@ namespace ngraph
                      const Shape& out_shape,
                      const AxisSet& reduction_axes)
             {
-                CoordinateTransform output_transform(out_shape);
-                std::vector<T> cs(shape_size(out_shape));
+                size_t out_size = shape_size(out_shape);
+                std::fill(out, out + out_size, T(0));
+                std::vector<T> cs(out_size, T(0));
 
-                for (const Coordinate& output_coord : output_transform)
+                StridedIterator it(in_shape,
+                                   {StridedIterator::reduced_strides(in_shape, reduction_axes)});
+                const T* x_ptr = arg;
+                for (; !it.done(); it.next_row())
                 {
-                    out[output_transform.index(output_coord)] = 0;
-                    cs[output_transform.index(output_coord)] = 0;
-                }
-
-                CoordinateTransform input_transform(in_shape);
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    Coordinate output_coord = reduce(input_coord, reduction_axes);
-
-                    T x = arg[input_transform.index(input_coord)];
-                    T& z = out[output_transform.index(output_coord)];
-
-                    if (is_finite(x) && is_finite(z))
-                    {
-                        T& c = cs[output_transform.index(output_coord)];
-                        T t = z + (x - c);
-                        c = (t - z) - (x - c);
-                        z = t;
-                    }
-                    else
+                    size_t out_index = it.get_offset(0);
+                    size_t out_stride = it.get_inner_stride(0);
+                    for (size_t i = 0; i < it.get_inner_size(); ++i, out_index += out_stride)
                     {
-                        z = z + x;
+                        T x = *x_ptr++;
+                        T& z = out[out_index];
+
+                        if (is_finite(x) && is_finite(z))
+                        {
+                            T& c = cs[out_index];
+                            T t = z + (x - c);
+                            c = (t - z) - (x - c);
+                            z = t;
+                        }
+                        else
+                        {
+                            z = z + x;
+                        }
                     }
                 }
             }
@@ -0,0 +1,49 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+
+#include "ngraph/runtime/aligned_buffer.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        template <typename T>
+        class SharedBuffer;
+    }
+}
+
+/// \brief An AlignedBuffer over memory owned by another object, for example a MappedFile.
+///        The buffer keeps a copy of shared_object, typically a shared_ptr to the owner, so the
+///        memory stays valid for the lifetime of the buffer. The memory is never freed by the
+///        buffer itself.
+template <typename T>
+class ngraph::runtime::SharedBuffer : public ngraph::runtime::AlignedBuffer
+{
+public:
+    SharedBuffer(char* data, size_t size, const T& shared_object)
+        : m_shared_object(shared_object)
+    {
+        m_aligned_buffer = data;
+        m_byte_size = size;
+    }
+
+private:
+    T m_shared_object;
+};
@@ -14,8 +14,10 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cmath>
 #include <fstream>
 #include <functional>
+#include <limits>
 #include <queue>
 #include <stack>
 
@@ -23,9 +25,12 @@
 #include "ngraph/env_util.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
+#include "ngraph/mapped_file.hpp"
 #include "ngraph/ops.hpp"
 #include "ngraph/provenance.hpp"
+#include "ngraph/runtime/shared_buffer.hpp"
 #include "ngraph/serializer.hpp"
+#include "ngraph/serializer_extension.hpp"
 #include "ngraph/util.hpp"
 #include "nlohmann/json.hpp"
 
@@ -110,6 +115,15 @@ public:
         m_binary_constant_data = binary_constant_data;
     }
 
+    void set_hash_constant_data(bool hash_constant_data)
+    {
+        m_hash_constant_data = hash_constant_data;
+    }
+
+    void set_extension(SerializerExtension* extension) { m_extension = extension; }
+
+    /// \brief Constants serialized without their values when binary constant data is enabled
+    const vector<const op::Constant*>& get_binary_constants() const { return m_binary_constants; }
     json serialize_function(const Function& function);
     json serialize_output(const Output<Node>& output);
     json serialize_parameter_vector(const ParameterVector& parameters);
@@ -125,6 +139,9 @@ protected:
     size_t m_indent{0};
     bool m_serialize_output_shapes{false};
     bool m_binary_constant_data{false};
+    bool m_hash_constant_data{false};
+    SerializerExtension* m_extension{nullptr};
+    vector<const op::Constant*> m_binary_constants;
     json m_json_nodes;
 };
 
@@ -136,6 +153,8 @@ public:
         m_const_data_callback = const_data_callback;
     }
 
+    void set_extension(SerializerExtension* extension) { m_extension = extension; }
+
     shared_ptr<Function> deserialize_function(json j);
     Output<Node> deserialize_output(json j);
     OutputVector deserialize_output_vector(json j);
@@ -152,10 +171,13 @@ protected:
     unordered_map<string, shared_ptr<Node>> m_node_map;
     unordered_map<string, shared_ptr<Function>> m_function_map;
     function<const_data_callback_t> m_const_data_callback;
+    SerializerExtension* m_extension{nullptr};
 };
 
-static string
-    serialize(shared_ptr<ngraph::Function> func, size_t indent, bool binary_constant_data);
+static string serialize(shared_ptr<ngraph::Function> func,
+                        size_t indent,
+                        vector<const op::Constant*>* binary_constants,
+                        SerializerExtension* extension = nullptr);
 
 static json write_dimension(Dimension d)
 {
@@ -308,34 +330,89 @@ void ngraph::serialize(const string& path, shared_ptr<ngraph::Function> func, si
 
 void ngraph::serialize(ostream& out, shared_ptr<ngraph::Function> func, size_t indent)
 {
-    out << ::serialize(func, indent, false);
+    out << ::serialize(func, indent, nullptr);
+}
+
+void ngraph::serialize_binary(const string& path,
+                              shared_ptr<ngraph::Function> func,
+                              size_t indent)
+{
+    ofstream out(path, ios_base::binary | ios_base::out);
+    NGRAPH_CHECK(out, "Unable to open '", path, "' for writing");
+    serialize_binary(out, func, indent);
+    out.close();
+    NGRAPH_CHECK(out, "Unable to write '", path, "'");
 }
 
-#if defined ENABLE_CPIO_FILE
-static void serialize_to_cpio(ostream& out, shared_ptr<ngraph::Function> func, size_t indent)
+// Size of the data of a Constant, as read by the op::Constant constructors
+static size_t get_constant_data_size(const element::Type& et, const Shape& shape)
 {
-    string j = ::serialize(func, indent, true);
+    size_t count = shape_size(shape);
+    NGRAPH_CHECK(et.bitwidth() == 0 || count <= (numeric_limits<size_t>::max() - 7) / et.bitwidth(),
+                 "Constant of shape ",
+                 shape,
+                 " is too large");
+    return (count * et.bitwidth() + 7) / 8;
+}
+
+// Constant data records must hold exactly the data of the constant, otherwise a truncated or
+// malformed archive would be read past the end of the record
+static void check_constant_record_size(const string& name,
+                                       const element::Type& et,
+                                       const Shape& shape,
+                                       size_t size)
+{
+    size_t expected = get_constant_data_size(et, shape);
+    NGRAPH_CHECK(size == expected,
+                 "Record '",
+                 name,
+                 "' holds ",
+                 size,
+                 " bytes but a constant of type ",
+                 et,
+                 " and shape ",
+                 shape,
+                 " needs ",
+                 expected);
+}
+
+static void serialize_binary(ostream& out,
+                             shared_ptr<ngraph::Function> func,
+                             size_t indent,
+                             SerializerExtension* extension)
+{
+    vector<const op::Constant*> constants;
+    string j = ::serialize(func, indent, &constants, extension);
     cpio::Writer writer(out);
-    writer.write(func->get_name(), j.c_str(), static_cast<uint32_t>(j.size()));
-
-    traverse_nodes(const_cast<Function*>(func.get()),
-                   [&](shared_ptr<Node> node) {
-                       if (auto c = node->as_type<op::Constant>())
-                       {
-                           uint32_t size =
-                               static_cast<uint32_t>(shape_size(c->get_output_shape(0)) *
-                                                     c->get_output_element_type(0).size());
-                           writer.write(c->get_name(), c->get_data_ptr(), size);
-                       }
-                   },
-                   true);
+    writer.write(func->get_name(), j.c_str(), j.size());
+
+    for (const op::Constant* c : constants)
+    {
+        size_t size = get_constant_data_size(c->get_element_type(), c->get_shape());
+        writer.write(c->get_name(), c->get_data_ptr(), size, op::Constant::host_alignment());
+    }
+}
+
+void ngraph::serialize_binary(ostream& out, shared_ptr<ngraph::Function> func, size_t indent)
+{
+    ::serialize_binary(out, func, indent, nullptr);
+}
+
+void ngraph::serialize_binary(ostream& out,
+                              shared_ptr<ngraph::Function> func,
+                              SerializerExtension& extension)
+{
+    ::serialize_binary(out, func, 0, &extension);
 }
-#endif
 
-static string serialize(shared_ptr<Function> func, size_t indent, bool binary_constant_data)
+static string serialize(shared_ptr<Function> func,
+                        size_t indent,
+                        vector<const op::Constant*>* binary_constants,
+                        SerializerExtension* extension)
 {
     JSONSerializer serializer;
-    serializer.set_binary_constant_data(binary_constant_data);
+    serializer.set_extension(extension);
+    serializer.set_binary_constant_data(binary_constants != nullptr);
     serializer.set_indent(indent);
     serializer.set_serialize_output_shapes(s_serialize_output_shapes_enabled);
 
@@ -351,12 +428,91 @@ static string serialize(shared_ptr<Function> func, size_t indent, bool binary_co
     {
         rc = j.dump(static_cast<int>(indent));
     }
+    if (binary_constants)
+    {
+        *binary_constants = serializer.get_binary_constants();
+    }
     return rc;
 }
 
 std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t indent)
 {
-    return ::serialize(func, indent, false);
+    return ::serialize(func, indent, nullptr);
+}
+
+// Assign a position based name to every node and tensor name in j
+static void collect_canonical_names(const json& j, unordered_map<string, string>& names)
+{
+    if (j.is_object())
+    {
+        if (has_key(j, "op") && j.at("name").is_string())
+        {
+            names.insert({j.at("name").get<string>(), "N" + to_string(names.size())});
+            if (has_key(j, "outputs"))
+            {
+                for (auto& output : j.at("outputs"))
+                {
+                    names.insert({output.get<string>(), "T" + to_string(names.size())});
+                }
+            }
+        }
+        for (auto& item : j.items())
+        {
+            collect_canonical_names(item.value(), names);
+        }
+    }
+    else if (j.is_array())
+    {
+        for (auto& item : j)
+        {
+            collect_canonical_names(item, names);
+        }
+    }
+}
+
+static void rename_canonical(json& j, const unordered_map<string, string>& names)
+{
+    if (j.is_string())
+    {
+        auto it = names.find(j.get<string>());
+        if (it != names.end())
+        {
+            j = it->second;
+        }
+    }
+    else if (j.is_object())
+    {
+        j.erase("friendly_name");
+        if (has_key(j, "ops") && has_key(j, "parameters"))
+        {
+            // Function name
+            j.erase("name");
+        }
+        for (auto& item : j.items())
+        {
+            rename_canonical(item.value(), names);
+        }
+    }
+    else if (j.is_array())
+    {
+        for (auto& item : j)
+        {
+            rename_canonical(item, names);
+        }
+    }
+}
+
+std::string ngraph::serialize_canonical(std::shared_ptr<ngraph::Function> func)
+{
+    JSONSerializer serializer;
+    serializer.set_hash_constant_data(true);
+    json j;
+    j.push_back(serializer.serialize_function(*func));
+
+    unordered_map<string, string> names;
+    collect_canonical_names(j, names);
+    rename_canonical(j, names);
+    return j.dump();
 }
 
 std::string
@@ -386,7 +542,7 @@ std::vector<std::pair<PartialShape, element::Type>>
     }
     return outs;
 }
-shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
+static shared_ptr<ngraph::Function> deserialize(istream& in, SerializerExtension* extension)
 {
     shared_ptr<Function> rc;
     if (cpio::is_cpio(in))
@@ -396,13 +552,14 @@ shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
         if (file_info.size() > 0)
         {
             // The first file is the model
-            uint32_t size = static_cast<uint32_t>(file_info[0].get_size());
+            size_t size = file_info[0].get_size();
             char* data = new char[size];
             reader.read(file_info[0].get_name(), data, size);
             string jstr(data, size);
             delete[] data;
             json js = json::parse(jstr);
             JSONDeserializer deserializer;
+            deserializer.set_extension(extension);
             deserializer.set_const_data_callback(
                 [&](const string& const_name, const element::Type& et, const Shape& shape) {
                     shared_ptr<Node> const_node;
@@ -410,6 +567,7 @@ shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
                     {
                         if (info.get_name() == const_name)
                         {
+                            check_constant_record_size(const_name, et, shape, info.get_size());
                             void* const_data = ngraph_malloc(info.get_size());
                             reader.read(const_name, const_data, info.get_size());
                             const_node = make_shared<op::Constant>(et, shape, const_data);
@@ -430,15 +588,91 @@ shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
         // json file?
         std::stringstream ss;
         ss << in.rdbuf();
+        NGRAPH_CHECK(!extension, "Functions written with an extension are cpio archives");
         rc = deserialize(ss.str());
     }
     return rc;
 }
 
+shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
+{
+    return ::deserialize(in, nullptr);
+}
+
+shared_ptr<ngraph::Function> ngraph::deserialize(istream& in, SerializerExtension& extension)
+{
+    return ::deserialize(in, &extension);
+}
+
+// Constants in the archive refer to the mapping instead of copying their data. Records that
+// are not suitably aligned, for example from archives written without alignment, are copied.
+static shared_ptr<ngraph::Function> deserialize_mapped(const string& path)
+{
+    shared_ptr<Function> rc;
+    vector<cpio::FileInfo> file_info;
+    {
+        cpio::Reader reader(path);
+        file_info = reader.get_file_info();
+    }
+    if (file_info.size() > 0)
+    {
+        auto mapping = make_shared<MappedFile>(path);
+        unordered_map<string, const cpio::FileInfo*> records;
+        for (const cpio::FileInfo& info : file_info)
+        {
+            // Written so that 64 bit record sizes cannot overflow the sum
+            NGRAPH_CHECK(info.get_offset() <= mapping->size() &&
+                             info.get_size() <= mapping->size() - info.get_offset(),
+                         "Record '",
+                         info.get_name(),
+                         "' extends past the end of '",
+                         path,
+                         "'");
+            records.insert({info.get_name(), &info});
+        }
+        // The first file is the model
+        string jstr(mapping->data() + file_info[0].get_offset(), file_info[0].get_size());
+        json js = json::parse(jstr);
+        JSONDeserializer deserializer;
+        deserializer.set_const_data_callback(
+            [&](const string& const_name, const element::Type& et, const Shape& shape) {
+                shared_ptr<Node> const_node;
+                auto it = records.find(const_name);
+                if (it != records.end())
+                {
+                    char* data = mapping->data() + it->second->get_offset();
+                    size_t size = it->second->get_size();
+                    check_constant_record_size(const_name, et, shape, size);
+                    if (size_t(data) % op::Constant::host_alignment() == 0)
+                    {
+                        auto buffer =
+                            make_shared<runtime::SharedBuffer<shared_ptr<MappedFile>>>(
+                                data, size, mapping);
+                        const_node = make_shared<op::Constant>(et, shape, buffer);
+                    }
+                    else
+                    {
+                        const_node = make_shared<op::Constant>(et, shape, data);
+                    }
+                }
+                return const_node;
+            });
+        for (json func : js)
+        {
+            rc = deserializer.deserialize_function(func);
+        }
+    }
+    return rc;
+}
+
 shared_ptr<ngraph::Function> ngraph::deserialize(const string& s)
 {
     shared_ptr<Function> rc;
-    if (file_util::exists(s))
+    if (file_util::exists(s) && cpio::is_cpio(s))
+    {
+        rc = deserialize_mapped(s);
+    }
+    else if (file_util::exists(s))
     {
         // s is a file and not a json string
         ifstream in(s, ios_base::binary | ios_base::in);
@@ -485,6 +719,14 @@ json JSONSerializer::serialize_function(const Function& f)
     }
 
     function["ops"] = nodes;
+    if (m_extension)
+    {
+        json state = m_extension->serialize_state(f);
+        if (!state.is_null())
+        {
+            function["backend_state"] = state;
+        }
+    }
     return function;
 }
 
@@ -740,6 +982,22 @@ shared_ptr<Function> JSONDeserializer::deserialize_function(json func_js)
     ParameterVector params = deserialize_parameter_vector(func_js.at("parameters"));
 
     shared_ptr<Function> rc{make_shared<Function>(result, params, func_name)};
+    if (m_extension)
+    {
+        // Constructing and validating the ops may set the same state, so it is restored last
+        for (json node_js : func_js.at("ops"))
+        {
+            if (has_key(node_js, "backend_state"))
+            {
+                m_extension->deserialize_state(*m_node_map.at(node_js.at("name").get<string>()),
+                                               node_js.at("backend_state"));
+            }
+        }
+        if (has_key(func_js, "backend_state"))
+        {
+            m_extension->deserialize_state(*rc, func_js.at("backend_state"));
+        }
+    }
     m_function_map[func_name] = rc;
     return rc;
 }
@@ -1071,8 +1329,16 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
                 has_key(node_js, "element_type") ? node_js : node_js.at("value_type");
             auto element_type = read_element_type(type_node_js.at("element_type"));
             auto shape = type_node_js.at("shape");
-            auto value = node_js.at("value").get<vector<string>>();
-            node = make_shared<op::Constant>(element_type, shape, value);
+            if (!has_key(node_js, "value") && m_const_data_callback)
+            {
+                node = m_const_data_callback(node_name, element_type, shape);
+                NGRAPH_CHECK(node, "No data found for constant '", node_name, "'");
+            }
+            else
+            {
+                auto value = node_js.at("value").get<vector<string>>();
+                node = make_shared<op::Constant>(element_type, shape, value);
+            }
             break;
         }
         case OP_TYPEID::Convert:
@@ -3037,6 +3303,14 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
         }
         case OP_TYPEID::UnknownOp:
         {
+            if (m_extension)
+            {
+                node = m_extension->deserialize_op(type_info, args, node_js);
+                if (node)
+                {
+                    break;
+                }
+            }
             stringstream ss;
             ss << "unsupported op " << type_info.name << ":" << type_info.version;
             throw runtime_error(ss.str());
@@ -3396,7 +3670,21 @@ json JSONSerializer::serialize_node(const Node& n)
     case OP_TYPEID::Constant:
     {
         auto tmp = static_cast<const op::Constant*>(&n);
-        if (tmp->get_all_data_elements_bitwise_identical() && shape_size(tmp->get_shape()) > 0)
+        if (m_binary_constant_data)
+        {
+            // The value is stored in a separate record named after the node
+            m_binary_constants.push_back(tmp);
+        }
+        else if (m_hash_constant_data)
+        {
+            size_t size =
+                (shape_size(tmp->get_shape()) * tmp->get_element_type().bitwidth() + 7) / 8;
+            FNV1aHash hash;
+            hash.add_bytes(tmp->get_data_ptr(), size);
+            node["value_hash"] = hash.get();
+        }
+        else if (tmp->get_all_data_elements_bitwise_identical() &&
+                 shape_size(tmp->get_shape()) > 0)
         {
             vector<string> vs;
             vs.push_back(tmp->convert_value_to_string(0));
@@ -4693,11 +4981,27 @@ json JSONSerializer::serialize_node(const Node& n)
     }
     case OP_TYPEID::VariadicSplit_v1: { break;
     }
-    case OP_TYPEID::UnknownOp: { break;
+    case OP_TYPEID::UnknownOp:
+    {
+        // Fail when saving rather than when loading
+        NGRAPH_CHECK(!m_extension || m_extension->serialize_op(n, node),
+                     "Unable to serialize unsupported op ",
+                     type_info.name,
+                     ":",
+                     type_info.version);
+        break;
     }
     }
 #if !(defined(__GNUC__) && (__GNUC__ == 4 && __GNUC_MINOR__ == 8))
 #pragma GCC diagnostic pop
 #endif
+    if (m_extension)
+    {
+        json state = m_extension->serialize_state(n);
+        if (!state.is_null())
+        {
+            node["backend_state"] = state;
+        }
+    }
     return node;
 }
@@ -23,6 +23,8 @@
 
 namespace ngraph
 {
+    class SerializerExtension;
+
     /// \brief Serialize a Function to a json string
     /// \param func The Function to serialize
     /// \param indent If 0 then there is no formatting applied and the resulting string is the
@@ -30,6 +32,16 @@ namespace ngraph
     ///    indent level specified.
     std::string serialize(std::shared_ptr<ngraph::Function> func, size_t indent = 0);
 
+    /// \brief Serialize a Function to a compact json string that only depends on its structure,
+    ///        attributes and constant data
+    ///
+    /// Node and tensor names, which depend on the order in which nodes were created, are replaced
+    /// by names based on their position in the graph, friendly names are dropped and constant
+    /// values are replaced by a hash of their data. Two Functions built the same way in different
+    /// processes serialize to the same string, which makes it usable as a fingerprint.
+    /// \param func The Function to serialize
+    std::string serialize_canonical(std::shared_ptr<ngraph::Function> func);
+
     /// \brief Serialize given vector of shapes/types
     /// \param types The vector of shape/types to serialize
     std::string serialize_types(const std::vector<std::pair<PartialShape, element::Type>>& types);
@@ -55,12 +67,49 @@ namespace ngraph
     ///    indent level specified.
     void serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func, size_t indent = 0);
 
+    /// \brief Serialize a Function to a cpio archive holding the json graph and the raw data of
+    ///        each Constant as a separate record aligned to op::Constant::host_alignment()
+    ///
+    /// Deserializing the archive from a path memory maps it and the Constants use their data in
+    /// place, without parsing or copying it.
+    /// \param path The path to the output file
+    /// \param func The Function to serialize
+    /// \param indent Indent level of the json graph, see serialize()
+    void serialize_binary(const std::string& path,
+                          std::shared_ptr<ngraph::Function> func,
+                          size_t indent = 0);
+
+    /// \brief Serialize a Function to a cpio archive stream, see serialize_binary()
+    /// \param out The output stream to which the data is serialized.
+    /// \param func The Function to serialize
+    /// \param indent Indent level of the json graph, see serialize()
+    void serialize_binary(std::ostream& out,
+                          std::shared_ptr<ngraph::Function> func,
+                          size_t indent = 0);
+
+    /// \brief Serialize a Function compiled by a backend to a cpio archive stream, see
+    ///        serialize_binary()
+    /// \param out The output stream to which the data is serialized.
+    /// \param func The Function to serialize
+    /// \param extension Serializes the backend ops and state, see SerializerExtension
+    void serialize_binary(std::ostream& out,
+                          std::shared_ptr<ngraph::Function> func,
+                          SerializerExtension& extension);
+
     /// \brief Deserialize a Function
     /// \param in An isteam to the input data
     std::shared_ptr<ngraph::Function> deserialize(std::istream& in);
 
+    /// \brief Deserialize a Function written with a SerializerExtension
+    /// \param in An isteam to the input data
+    /// \param extension Deserializes the backend ops and state, see SerializerExtension
+    std::shared_ptr<ngraph::Function> deserialize(std::istream& in,
+                                                  SerializerExtension& extension);
+
     /// \brief Deserialize a Function
-    /// \param str The json formatted string to deseriailze.
+    /// \param str The json formatted string to deseriailze, or the path to a json file or a
+    ///        cpio archive. An archive is memory mapped and Constants refer to the mapping,
+    ///        which stays open as long as any of them exists.
     std::shared_ptr<ngraph::Function> deserialize(const std::string& str);
 
     /// \brief If enabled adds output shapes to the serialized graph
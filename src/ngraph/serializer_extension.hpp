@@ -0,0 +1,70 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+
+#include "ngraph/function.hpp"
+#include "ngraph/node.hpp"
+#include "nlohmann/json.hpp"
+
+namespace ngraph
+{
+    /// \brief Serializes what a backend adds to a Function when it compiles it: ops that only
+    ///        the backend knows and the state its passes attach to nodes and to the Function.
+    ///
+    /// Passed to serialize_binary and deserialize. The serializer calls serialize_op and
+    /// deserialize_op for ops it does not know. Node state is stored with each node and
+    /// Function state with the Function, and both are restored once the whole Function has been
+    /// constructed.
+    class SerializerExtension
+    {
+    public:
+        virtual ~SerializerExtension() = default;
+
+        /// \brief Writes the attributes of an op the serializer does not know to node_js
+        /// \returns false if the extension does not know the op either
+        virtual bool serialize_op(const Node& /* node */, nlohmann::json& /* node_js */)
+        {
+            return false;
+        }
+
+        /// \brief Constructs an op written by serialize_op
+        /// \param type_info The type of the op
+        /// \param args The arguments of the op
+        /// \param node_js The serialized node, including its state
+        /// \returns nullptr if the extension does not know the op
+        virtual std::shared_ptr<Node> deserialize_op(const NodeTypeInfo& /* type_info */,
+                                                     const OutputVector& /* args */,
+                                                     const nlohmann::json& /* node_js */)
+        {
+            return nullptr;
+        }
+
+        /// \brief Returns the state attached to node, or null if there is none
+        virtual nlohmann::json serialize_state(const Node& /* node */) { return nullptr; }
+        /// \brief Restores state returned by serialize_state on the deserialized node
+        virtual void deserialize_state(Node& /* node */, const nlohmann::json& /* state */) {}
+        /// \brief Returns the state attached to function, or null if there is none
+        virtual nlohmann::json serialize_state(const Function& /* function */) { return nullptr; }
+        /// \brief Restores state returned by serialize_state on the deserialized function,
+        ///        after the state of its nodes
+        virtual void deserialize_state(Function& /* function */, const nlohmann::json& /* state */)
+        {
+        }
+    };
+}
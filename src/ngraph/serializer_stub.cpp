@@ -21,6 +21,11 @@ std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t ind
     throw std::runtime_error("serializer disabled in build");
 }
 
+std::string ngraph::serialize_canonical(std::shared_ptr<ngraph::Function> func)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
 void ngraph::serialize(const std::string& path,
                        std::shared_ptr<ngraph::Function> func,
                        size_t indent)
@@ -33,11 +38,38 @@ void ngraph::serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func
     throw std::runtime_error("serializer disabled in build");
 }
 
+void ngraph::serialize_binary(const std::string& path,
+                              std::shared_ptr<ngraph::Function> func,
+                              size_t indent)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
+void ngraph::serialize_binary(std::ostream& out,
+                              std::shared_ptr<ngraph::Function> func,
+                              size_t indent)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
+void ngraph::serialize_binary(std::ostream& out,
+                              std::shared_ptr<ngraph::Function> func,
+                              SerializerExtension& extension)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
 std::shared_ptr<ngraph::Function> ngraph::deserialize(std::istream& in)
 {
     throw std::runtime_error("serializer disabled in build");
 }
 
+std::shared_ptr<ngraph::Function> ngraph::deserialize(std::istream& in,
+                                                      SerializerExtension& extension)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
 std::shared_ptr<ngraph::Function> ngraph::deserialize(const std::string& str)
 {
     throw std::runtime_error("serializer disabled in build");
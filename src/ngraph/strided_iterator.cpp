@@ -0,0 +1,74 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/strided_iterator.hpp"
+#include "ngraph/check.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+StridedIterator::StridedIterator(const Shape& shape, const vector<Strides>& operand_strides)
+    : m_inner_strides(operand_strides.size(), 0)
+    , m_offsets(operand_strides.size(), 0)
+    , m_inner_size(1)
+    , m_done(shape_size(shape) == 0)
+{
+    for (const Strides& strides : operand_strides)
+    {
+        NGRAPH_CHECK(strides.size() == shape.size(),
+                     "Operand strides ",
+                     strides,
+                     " do not have the same number of axes as the iterated shape ",
+                     shape);
+    }
+    if (shape.empty())
+    {
+        return;
+    }
+
+    size_t inner_axis = shape.size() - 1;
+    m_inner_size = shape[inner_axis];
+    for (size_t i = 0; i < operand_strides.size(); ++i)
+    {
+        m_inner_strides[i] = operand_strides[i][inner_axis];
+    }
+    m_outer_shape = Shape(shape.begin(), shape.begin() + inner_axis);
+    m_coordinate = Shape(inner_axis, 0);
+    m_outer_strides.resize(inner_axis * operand_strides.size());
+    for (size_t axis = 0; axis < inner_axis; ++axis)
+    {
+        for (size_t i = 0; i < operand_strides.size(); ++i)
+        {
+            m_outer_strides[axis * operand_strides.size() + i] = operand_strides[i][axis];
+        }
+    }
+}
+
+Strides StridedIterator::reduced_strides(const Shape& shape, const AxisSet& reduced_axes)
+{
+    Strides strides(shape.size(), 0);
+    size_t stride = 1;
+    for (size_t axis = shape.size(); axis-- > 0;)
+    {
+        if (reduced_axes.count(axis) == 0)
+        {
+            strides[axis] = stride;
+            stride *= shape[axis];
+        }
+    }
+    return strides;
+}
@@ -0,0 +1,97 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include "ngraph/axis_set.hpp"
+#include "ngraph/shape.hpp"
+#include "ngraph/strides.hpp"
+
+namespace ngraph
+{
+    /// \brief Walks every coordinate of a shape in row-major order while keeping track of the
+    ///        linear offset of the current coordinate in one or more operands.
+    ///
+    /// Each operand is described by its element stride along every axis of the iterated shape. A
+    /// stride of 0 means the operand does not vary along that axis, which is how broadcast and
+    /// reduction operands are expressed. Unlike CoordinateTransform no Coordinate is produced
+    /// and offsets are updated incrementally, so the innermost axis can be walked by the caller
+    /// with a plain pointer increment:
+    ///
+    ///     for (StridedIterator it(shape, {in_strides}); !it.done(); it.next_row())
+    ///     {
+    ///         size_t in_index = it.get_offset(0);
+    ///         for (size_t i = 0; i < it.get_inner_size(); ++i)
+    ///         {
+    ///             ... in[in_index] ...
+    ///             in_index += it.get_inner_stride(0);
+    ///         }
+    ///     }
+    class NGRAPH_API StridedIterator
+    {
+    public:
+        /// \param shape The shape to iterate over
+        /// \param operand_strides For each operand, its stride along each axis of shape
+        StridedIterator(const Shape& shape, const std::vector<Strides>& operand_strides);
+
+        /// \brief Number of elements along the innermost axis
+        size_t get_inner_size() const { return m_inner_size; }
+        /// \brief Stride of operand along the innermost axis
+        size_t get_inner_stride(size_t operand) const { return m_inner_strides[operand]; }
+        /// \brief Offset of operand at the start of the current innermost row
+        size_t get_offset(size_t operand) const { return m_offsets[operand]; }
+        /// \brief True once every row has been visited
+        bool done() const { return m_done; }
+        /// \brief Advance to the start of the next innermost row
+        void next_row()
+        {
+            for (size_t axis = m_outer_shape.size(); axis-- > 0;)
+            {
+                const size_t* strides = &m_outer_strides[axis * m_offsets.size()];
+                if (++m_coordinate[axis] < m_outer_shape[axis])
+                {
+                    for (size_t i = 0; i < m_offsets.size(); ++i)
+                    {
+                        m_offsets[i] += strides[i];
+                    }
+                    return;
+                }
+                m_coordinate[axis] = 0;
+                for (size_t i = 0; i < m_offsets.size(); ++i)
+                {
+                    m_offsets[i] -= strides[i] * (m_outer_shape[axis] - 1);
+                }
+            }
+            m_done = true;
+        }
+
+        /// \brief Strides for indexing a row-major tensor of shape reduce(shape, reduced_axes)
+        ///        with coordinates of shape. Axes in reduced_axes get a stride of 0.
+        static Strides reduced_strides(const Shape& shape, const AxisSet& reduced_axes);
+
+    private:
+        Shape m_outer_shape;
+        // Stride of operand i along outer axis a is m_outer_strides[a * operand_count + i]
+        std::vector<size_t> m_outer_strides;
+        std::vector<size_t> m_inner_strides;
+        std::vector<size_t> m_offsets;
+        Shape m_coordinate;
+        size_t m_inner_size;
+        bool m_done;
+    };
+}
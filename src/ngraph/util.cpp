@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <cstdio>
 #include <deque>
 #include <forward_list>
 #include <iomanip>
@@ -152,6 +153,29 @@ vector<string> ngraph::split(const string& src, char delimiter, bool do_trim)
     return rc;
 }
 
+void ngraph::append_json_escaped(string& out, const char* value, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        char c = value[i];
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+            out += escaped;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+}
+
 size_t ngraph::hash_combine(const std::vector<size_t>& list)
 {
     size_t seed = 0;
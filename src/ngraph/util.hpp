@@ -76,12 +76,39 @@ namespace ngraph
     }
 
     size_t hash_combine(const std::vector<size_t>& list);
+
+    /// \brief 64 bit FNV-1a hash, extended one value or one buffer at a time
+    class FNV1aHash
+    {
+    public:
+        void add(uint64_t value)
+        {
+            m_hash ^= value;
+            m_hash *= 1099511628211ULL;
+        }
+        /// \brief Add each of size bytes at data as its own value
+        void add_bytes(const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                add(bytes[i]);
+            }
+        }
+        uint64_t get() const { return m_hash; }
+
+    private:
+        uint64_t m_hash = 14695981039346656037ULL;
+    };
+
     void dump(std::ostream& out, const void*, size_t);
 
     std::string to_lower(const std::string& s);
     std::string to_upper(const std::string& s);
     std::string trim(const std::string& s);
     std::vector<std::string> split(const std::string& s, char delimiter, bool trim = false);
+    /// \brief Append size bytes of value to out, escaped for use inside a JSON string
+    void append_json_escaped(std::string& out, const char* value, size_t size);
     template <typename T>
     std::string locale_string(T x)
     {
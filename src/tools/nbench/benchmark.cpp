@@ -31,13 +31,15 @@ vector<runtime::PerformanceCounter> run_benchmark(shared_ptr<Function> f,
                                                   size_t iterations,
                                                   bool timing_detail,
                                                   size_t warmup_iterations,
-                                                  bool copy_data)
+                                                  bool copy_data,
+                                                  BenchmarkStats& stats)
 {
     stopwatch timer;
     timer.start();
     auto backend = runtime::Backend::create(backend_name);
     auto exec = backend->compile(f, timing_detail);
     timer.stop();
+    stats.compile_ms = timer.get_milliseconds();
     stringstream ss;
     ss.imbue(locale(""));
     ss << "compile time: " << timer.get_milliseconds() << "ms" << endl;
@@ -79,12 +81,14 @@ vector<runtime::PerformanceCounter> run_benchmark(shared_ptr<Function> f,
     }
 
     stopwatch t1;
+    stopwatch iteration_timer;
     for (size_t i = 0; i < iterations + warmup_iterations; i++)
     {
         if (i == warmup_iterations)
         {
             t1.start();
         }
+        iteration_timer.start();
         if (copy_data)
         {
             for (size_t arg_index = 0; arg_index < args.size(); arg_index++)
@@ -109,12 +113,18 @@ vector<runtime::PerformanceCounter> run_benchmark(shared_ptr<Function> f,
                              data->get_element_count() * data->get_element_type().size());
             }
         }
+        iteration_timer.stop();
+        if (i >= warmup_iterations)
+        {
+            stats.iteration_ms.push_back(iteration_timer.get_nanoseconds() / 1e6);
+        }
     }
     t1.stop();
     float time = t1.get_milliseconds();
     ss << time / iterations << "ms per iteration" << endl;
     cout << ss.str();
 
+    stats.memory = exec->get_memory_report();
     vector<runtime::PerformanceCounter> perf_data = exec->get_performance_data();
     return perf_data;
 }
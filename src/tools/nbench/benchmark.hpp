@@ -22,11 +22,22 @@
 #include <vector>
 
 #include "ngraph/function.hpp"
+#include "ngraph/runtime/memory_report.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
 
+struct BenchmarkStats
+{
+    double compile_ms = 0;
+    // Time of each timed iteration, or the average iteration time if iterations overlap
+    std::vector<double> iteration_ms;
+    // Memory held by the executable after the timed iterations
+    ngraph::runtime::MemoryReport memory;
+};
+
 std::vector<ngraph::runtime::PerformanceCounter> run_benchmark(std::shared_ptr<ngraph::Function> f,
                                                                const std::string& backend_name,
                                                                size_t iterations,
                                                                bool timing_detail,
                                                                size_t warmup_iterations,
-                                                               bool copy_data);
+                                                               bool copy_data,
+                                                               BenchmarkStats& stats);
@@ -0,0 +1,295 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+#include "benchmark_load.hpp"
+#include "benchmark_utils.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/host_tensor.hpp"
+#include "ngraph/runtime/tensor.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+using Clock = chrono::steady_clock;
+
+static double get_thread_cpu_ms()
+{
+#if !defined(_WIN32)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+    {
+        return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+    }
+#endif
+    return 0;
+}
+
+namespace
+{
+    struct Client
+    {
+        vector<shared_ptr<runtime::HostTensor>> arg_data;
+        vector<shared_ptr<runtime::Tensor>> args;
+        vector<shared_ptr<runtime::HostTensor>> result_data;
+        vector<shared_ptr<runtime::Tensor>> results;
+        vector<double> latencies_us;
+        double cpu_ms = 0;
+        Clock::time_point last_end;
+    };
+}
+
+double LoadResult::percentile(double p) const
+{
+    if (latencies_us.empty())
+    {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(ceil(p / 100 * latencies_us.size()));
+    return latencies_us[min(max<size_t>(rank, 1), latencies_us.size()) - 1];
+}
+
+double LoadResult::mean() const
+{
+    if (latencies_us.empty())
+    {
+        return 0;
+    }
+    return accumulate(latencies_us.begin(), latencies_us.end(), 0.0) / latencies_us.size();
+}
+
+static void call(runtime::Executable& exec, Client& client, bool copy_data)
+{
+    if (copy_data)
+    {
+        for (size_t i = 0; i < client.args.size(); i++)
+        {
+            const auto& data = client.arg_data[i];
+            client.args[i]->write(data->get_data_ptr(),
+                                  data->get_element_count() * data->get_element_type().size());
+        }
+    }
+    exec.call(client.results, client.args);
+    if (copy_data)
+    {
+        for (size_t i = 0; i < client.results.size(); i++)
+        {
+            const auto& data = client.result_data[i];
+            client.results[i]->read(data->get_data_ptr(),
+                                    data->get_element_count() * data->get_element_type().size());
+        }
+    }
+}
+
+LoadResult run_load_benchmark(shared_ptr<Function> f,
+                              const string& backend_name,
+                              const LoadOptions& options)
+{
+    auto backend = runtime::Backend::create(backend_name);
+    auto exec = backend->compile(f);
+    set_denormals_flush_to_zero();
+
+    size_t num_clients = max<size_t>(1, options.clients);
+    vector<Client> clients(num_clients);
+    for (Client& client : clients)
+    {
+        for (shared_ptr<op::Parameter> param : f->get_parameters())
+        {
+            auto tensor = backend->create_tensor(param->get_element_type(), param->get_shape());
+            auto tensor_data =
+                make_shared<runtime::HostTensor>(param->get_element_type(), param->get_shape());
+            random_init(tensor_data);
+            tensor->write(tensor_data->get_data_ptr(),
+                          tensor_data->get_element_count() *
+                              tensor_data->get_element_type().size());
+            client.args.push_back(tensor);
+            client.arg_data.push_back(tensor_data);
+        }
+        for (shared_ptr<Node> out : f->get_results())
+        {
+            client.results.push_back(
+                backend->create_tensor(out->get_element_type(), out->get_shape()));
+            client.result_data.push_back(
+                make_shared<runtime::HostTensor>(out->get_element_type(), out->get_shape()));
+        }
+    }
+
+    mutex start_mutex;
+    condition_variable start_condition;
+    size_t num_ready = 0;
+    bool started = false;
+    Clock::time_point start_time;
+    auto duration = chrono::duration_cast<Clock::duration>(
+        chrono::duration<double>(options.duration_seconds));
+
+    auto client_entry = [&](size_t id) {
+        Client& client = clients[id];
+        for (size_t i = 0; i < options.warmup_iterations; i++)
+        {
+            call(*exec, client, options.copy_data);
+        }
+        {
+            unique_lock<mutex> lock(start_mutex);
+            num_ready++;
+            start_condition.notify_all();
+            start_condition.wait(lock, [&]() { return started; });
+        }
+        double cpu_start = get_thread_cpu_ms();
+        Clock::time_point end_time = start_time + duration;
+        client.last_end = start_time;
+        for (size_t k = 0;; k++)
+        {
+            Clock::time_point call_start;
+            if (options.qps > 0)
+            {
+                // Clients take turns so that calls are evenly spaced over all of them
+                call_start = start_time + chrono::duration_cast<Clock::duration>(
+                                              chrono::duration<double>(
+                                                  (k * num_clients + id) / options.qps));
+                if (call_start >= end_time)
+                {
+                    break;
+                }
+                this_thread::sleep_until(call_start);
+            }
+            else
+            {
+                call_start = Clock::now();
+                if (call_start >= end_time)
+                {
+                    break;
+                }
+            }
+            call(*exec, client, options.copy_data);
+            client.last_end = Clock::now();
+            client.latencies_us.push_back(
+                chrono::duration<double, micro>(client.last_end - call_start).count());
+        }
+        client.cpu_ms = get_thread_cpu_ms() - cpu_start;
+    };
+
+    vector<thread> threads;
+    for (size_t id = 0; id < num_clients; id++)
+    {
+        threads.emplace_back(client_entry, id);
+    }
+    {
+        unique_lock<mutex> lock(start_mutex);
+        start_condition.wait(lock, [&]() { return num_ready == num_clients; });
+        start_time = Clock::now();
+        started = true;
+    }
+    start_condition.notify_all();
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    LoadResult result;
+    Clock::time_point last_end = start_time;
+    for (Client& client : clients)
+    {
+        result.latencies_us.insert(
+            result.latencies_us.end(), client.latencies_us.begin(), client.latencies_us.end());
+        result.thread_cpu_ms.push_back(client.cpu_ms);
+        last_end = max(last_end, client.last_end);
+    }
+    sort(result.latencies_us.begin(), result.latencies_us.end());
+    result.memory = exec->get_memory_report();
+    result.calls = result.latencies_us.size();
+    result.elapsed_seconds = chrono::duration<double>(last_end - start_time).count();
+    if (result.elapsed_seconds > 0)
+    {
+        result.throughput = result.calls / result.elapsed_seconds;
+    }
+    return result;
+}
+
+static const vector<double> s_percentiles{50, 90, 99, 99.9};
+
+void print_load_result(const LoadResult& result, const LoadOptions& options)
+{
+    cout << "clients: " << max<size_t>(1, options.clients) << ", ";
+    if (options.qps > 0)
+    {
+        cout << "target " << options.qps << " calls/s\n";
+    }
+    else
+    {
+        cout << "closed loop\n";
+    }
+    cout << fixed << setprecision(1);
+    cout << result.calls << " calls in " << result.elapsed_seconds << "s, " << result.throughput
+         << " calls/s\n";
+    cout << "latency mean " << result.mean() << "us";
+    for (double p : s_percentiles)
+    {
+        cout << ", p" << p << " " << result.percentile(p) << "us";
+    }
+    if (!result.latencies_us.empty())
+    {
+        cout << ", max " << result.latencies_us.back() << "us";
+    }
+    cout << "\n";
+    for (size_t i = 0; i < result.thread_cpu_ms.size(); i++)
+    {
+        cout << "client " << i << " cpu time " << result.thread_cpu_ms[i] << "ms";
+        if (result.elapsed_seconds > 0)
+        {
+            cout << " (" << 100 * result.thread_cpu_ms[i] / (1e3 * result.elapsed_seconds)
+                 << "%)";
+        }
+        cout << "\n";
+    }
+    cout << defaultfloat;
+}
+
+nlohmann::json load_result_to_json(const LoadResult& result, const LoadOptions& options)
+{
+    nlohmann::json latency;
+    latency["mean"] = result.mean();
+    for (double p : s_percentiles)
+    {
+        stringstream name;
+        name << "p" << p;
+        latency[name.str()] = result.percentile(p);
+    }
+    latency["max"] = result.latencies_us.empty() ? 0 : result.latencies_us.back();
+
+    nlohmann::json json;
+    json["clients"] = max<size_t>(1, options.clients);
+    json["target_qps"] = options.qps;
+    json["calls"] = result.calls;
+    json["elapsed_seconds"] = result.elapsed_seconds;
+    json["throughput"] = result.throughput;
+    json["latency_us"] = latency;
+    json["thread_cpu_ms"] = result.thread_cpu_ms;
+    return json;
+}
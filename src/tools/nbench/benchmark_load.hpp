@@ -0,0 +1,68 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "ngraph/function.hpp"
+#include "ngraph/runtime/memory_report.hpp"
+
+struct LoadOptions
+{
+    // Number of client threads calling the executable concurrently
+    size_t clients = 1;
+    // Total calls per second over all clients, 0 for closed loop (each client calls again as
+    // soon as its previous call returns)
+    double qps = 0;
+    double duration_seconds = 10;
+    // Untimed calls per client before the measurement starts
+    size_t warmup_iterations = 1;
+    bool copy_data = true;
+};
+
+struct LoadResult
+{
+    size_t calls = 0;
+    double elapsed_seconds = 0;
+    // Completed calls per second
+    double throughput = 0;
+    // Sorted latencies of all timed calls. In open loop they are measured from the time the
+    // call was scheduled, so time spent behind a late previous call is included.
+    std::vector<double> latencies_us;
+    // CPU time of each client thread during the measurement
+    std::vector<double> thread_cpu_ms;
+    // Memory held by the executable after the measurement
+    ngraph::runtime::MemoryReport memory;
+
+    // Nearest-rank percentile, for example 99.9
+    double percentile(double p) const;
+    double mean() const;
+};
+
+// Drive an executable compiled for backend_name from concurrent clients, each with its own
+// input and output tensors. The backend must allow concurrent calls into one executable.
+LoadResult run_load_benchmark(std::shared_ptr<ngraph::Function> f,
+                              const std::string& backend_name,
+                              const LoadOptions& options);
+
+void print_load_result(const LoadResult& result, const LoadOptions& options);
+
+nlohmann::json load_result_to_json(const LoadResult& result, const LoadOptions& options);
@@ -109,7 +109,8 @@ vector<runtime::PerformanceCounter> run_benchmark_pipelined(shared_ptr<Function>
                                                             size_t iterations,
                                                             bool timing_detail,
                                                             int warmup_iterations,
-                                                            bool /* copy_data */)
+                                                            bool /* copy_data */,
+                                                            BenchmarkStats& stats)
 {
     constexpr size_t pipeline_depth = 2;
     s_iterations = iterations;
@@ -120,6 +121,7 @@ vector<runtime::PerformanceCounter> run_benchmark_pipelined(shared_ptr<Function>
     auto backend = runtime::Backend::create(backend_name);
     auto exec = backend->compile(f, timing_detail);
     timer.stop();
+    stats.compile_ms = timer.get_milliseconds();
     stringstream ss;
     ss.imbue(locale(""));
     ss << "compile time: " << timer.get_milliseconds() << "ms" << endl;
@@ -184,8 +186,10 @@ vector<runtime::PerformanceCounter> run_benchmark_pipelined(shared_ptr<Function>
     }
     float time = s_timer.get_milliseconds();
     ss << time / iterations << "ms per iteration" << endl;
+    stats.iteration_ms.push_back(time / iterations);
     cout << ss.str();
 
+    stats.memory = exec->get_memory_report();
     vector<runtime::PerformanceCounter> perf_data = exec->get_performance_data();
     return perf_data;
 }
@@ -0,0 +1,311 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+#include "benchmark_results.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+size_t get_process_peak_rss_bytes()
+{
+#if !defined(_WIN32)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#if defined(__APPLE__)
+        return static_cast<size_t>(usage.ru_maxrss);
+#else
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+    return 0;
+}
+
+size_t get_peak_memory_bytes(const runtime::MemoryReport& report)
+{
+    return max(report.allocated_bytes(), report.constant_bytes + report.peak_call_bytes);
+}
+
+static double mean(const vector<double>& values)
+{
+    return values.empty() ? 0 : accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+static double variance(const vector<double>& values)
+{
+    if (values.size() < 2)
+    {
+        return 0;
+    }
+    double m = mean(values);
+    double sum = 0;
+    for (double value : values)
+    {
+        sum += (value - m) * (value - m);
+    }
+    return sum / (values.size() - 1);
+}
+
+// Two-sided 95% critical value of Student's t distribution, from the Cornish-Fisher expansion
+// around the normal quantile. Within 3% of the exact value for 2 or more degrees of freedom.
+static double t_critical_95(double df)
+{
+    df = max(df, 1.0);
+    const double z = 1.959964;
+    double g1 = (pow(z, 3) + z) / 4;
+    double g2 = (5 * pow(z, 5) + 16 * pow(z, 3) + 3 * z) / 96;
+    double g3 = (3 * pow(z, 7) + 19 * pow(z, 5) + 17 * pow(z, 3) - 15 * z) / 384;
+    return z + g1 / df + g2 / (df * df) + g3 / (df * df * df);
+}
+
+// Welch's t-test on the difference of the means of two samples
+static bool significant_difference(const vector<double>& a, const vector<double>& b)
+{
+    double va = variance(a) / a.size();
+    double vb = variance(b) / b.size();
+    double difference = mean(a) - mean(b);
+    if (va + vb == 0)
+    {
+        return difference != 0;
+    }
+    double t = difference / sqrt(va + vb);
+    double df = (va + vb) * (va + vb) /
+                (va * va / (a.size() - 1) + vb * vb / (b.size() - 1));
+    return fabs(t) > t_critical_95(df);
+}
+
+static double change_percent(double base, double current)
+{
+    return base == 0 ? 0 : 100 * (current - base) / base;
+}
+
+nlohmann::json make_benchmark_result(const string& model,
+                                     const string& backend,
+                                     const BenchmarkStats& stats,
+                                     const vector<runtime::PerformanceCounter>& perf)
+{
+    nlohmann::json result;
+    result["model"] = model;
+    result["backend"] = backend;
+    result["compile_ms"] = stats.compile_ms;
+    result["iteration_ms"] = stats.iteration_ms;
+    result["mean_ms"] = mean(stats.iteration_ms);
+    result["stddev_ms"] = sqrt(variance(stats.iteration_ms));
+    result["peak_memory_bytes"] = get_peak_memory_bytes(stats.memory);
+    result["process_peak_rss_bytes"] = get_process_peak_rss_bytes();
+    nlohmann::json op_types = nlohmann::json::object();
+    nlohmann::json ops = nlohmann::json::object();
+    for (const runtime::PerformanceCounter& p : perf)
+    {
+        auto node = p.get_node();
+        ops[node->get_name()] = p.microseconds();
+        op_types[node->description()] =
+            op_types.value(node->description(), size_t(0)) + p.microseconds();
+    }
+    result["op_types"] = op_types;
+    result["ops"] = ops;
+    result["memory"] = memory_report_to_json(stats.memory);
+    return result;
+}
+
+void print_memory_report(const runtime::MemoryReport& report)
+{
+    cout << "\n---- Memory ----\n";
+    cout << "Activations (buffer plan): " << locale_string(report.activation_bytes)
+         << " bytes per context\n";
+    cout << "Scratchpad: " << locale_string(report.scratchpad_bytes) << " bytes per context\n";
+    cout << "Constants: " << locale_string(report.constant_bytes) << " bytes\n";
+    cout << "Contexts: " << report.allocated_contexts << " of " << report.contexts
+         << " allocated, " << locale_string(report.allocated_contexts * report.context_bytes())
+         << " bytes\n";
+    cout << "Peak during call: " << locale_string(report.peak_call_bytes) << " bytes\n";
+    cout << "Total allocated: " << locale_string(report.allocated_bytes()) << " bytes\n";
+}
+
+nlohmann::json memory_report_to_json(const runtime::MemoryReport& report)
+{
+    nlohmann::json json;
+    json["activation_bytes"] = report.activation_bytes;
+    json["scratchpad_bytes"] = report.scratchpad_bytes;
+    json["constant_bytes"] = report.constant_bytes;
+    json["contexts"] = report.contexts;
+    json["allocated_contexts"] = report.allocated_contexts;
+    json["peak_call_bytes"] = report.peak_call_bytes;
+    json["allocated_bytes"] = report.allocated_bytes();
+    return json;
+}
+
+static const nlohmann::json* find_model(const nlohmann::json& results,
+                                        const nlohmann::json& model)
+{
+    for (const auto& candidate : results["models"])
+    {
+        if (candidate.value("model", "") == model.value("model", "") &&
+            candidate.value("backend", "") == model.value("backend", ""))
+        {
+            return &candidate;
+        }
+    }
+    return nullptr;
+}
+
+// Print one compared figure and return whether it is a regression
+static bool report(const string& name,
+                   double base,
+                   double current,
+                   const string& unit,
+                   bool higher_is_worse,
+                   double threshold_percent,
+                   bool significant,
+                   bool counts)
+{
+    double change = change_percent(base, current);
+    bool worse = higher_is_worse ? change > threshold_percent : change < -threshold_percent;
+    bool better = higher_is_worse ? change < -threshold_percent : change > threshold_percent;
+    cout << "    " << setw(24) << left << name << right << setw(12) << base << unit << " ->"
+         << setw(12) << current << unit << setw(9) << showpos << change << noshowpos << "%";
+    bool regression = false;
+    if (worse && significant)
+    {
+        regression = counts;
+        cout << (counts ? "  REGRESSION" : "  slower");
+    }
+    else if (better && significant)
+    {
+        cout << "  improved";
+    }
+    else if (worse || better)
+    {
+        cout << "  not significant";
+    }
+    cout << "\n";
+    return regression;
+}
+
+size_t compare_to_baseline(const nlohmann::json& results,
+                           const nlohmann::json& baseline,
+                           double threshold_percent)
+{
+    size_t regressions = 0;
+    cout << "\n---- Comparison to baseline (threshold " << threshold_percent << "%) ----\n";
+    ios::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
+    cout << fixed << setprecision(3);
+    for (const auto& model : results["models"])
+    {
+        cout << model.value("model", "") << " (" << model.value("backend", "") << ")\n";
+        const nlohmann::json* base = find_model(baseline, model);
+        if (base == nullptr)
+        {
+            cout << "    not in baseline\n";
+            continue;
+        }
+        if (model.count("iteration_ms") && base->count("iteration_ms"))
+        {
+            vector<double> current = model["iteration_ms"];
+            vector<double> previous = (*base)["iteration_ms"];
+            bool significant = true;
+            if (current.size() >= 2 && previous.size() >= 2)
+            {
+                significant = significant_difference(current, previous);
+            }
+            if (!current.empty() && !previous.empty() &&
+                report("iteration",
+                       mean(previous),
+                       mean(current),
+                       "ms",
+                       true,
+                       threshold_percent,
+                       significant,
+                       true))
+            {
+                regressions++;
+            }
+            report("compile",
+                   base->value("compile_ms", 0.0),
+                   model.value("compile_ms", 0.0),
+                   "ms",
+                   true,
+                   threshold_percent,
+                   true,
+                   false);
+            const auto& op_types = model["op_types"];
+            const auto& base_op_types = (*base)["op_types"];
+            for (auto it = op_types.begin(); it != op_types.end(); ++it)
+            {
+                if (base_op_types.count(it.key()))
+                {
+                    double previous_us = base_op_types[it.key()];
+                    double current_us = it.value();
+                    if (fabs(change_percent(previous_us, current_us)) > threshold_percent)
+                    {
+                        report(it.key(),
+                               previous_us,
+                               current_us,
+                               "us",
+                               true,
+                               threshold_percent,
+                               true,
+                               false);
+                    }
+                }
+            }
+        }
+        if (model.count("load") && base->count("load"))
+        {
+            const auto& load = model["load"];
+            const auto& base_load = (*base)["load"];
+            if (report("throughput",
+                       base_load.value("throughput", 0.0),
+                       load.value("throughput", 0.0),
+                       "/s",
+                       false,
+                       threshold_percent,
+                       true,
+                       true))
+            {
+                regressions++;
+            }
+            if (report("p99 latency",
+                       base_load["latency_us"].value("p99", 0.0),
+                       load["latency_us"].value("p99", 0.0),
+                       "us",
+                       true,
+                       threshold_percent,
+                       true,
+                       true))
+            {
+                regressions++;
+            }
+        }
+    }
+    cout.flags(flags);
+    cout.precision(precision);
+    cout << regressions << " regression" << (regressions == 1 ? "" : "s") << "\n";
+    return regressions;
+}
@@ -0,0 +1,56 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "benchmark.hpp"
+#include "ngraph/runtime/memory_report.hpp"
+#include "ngraph/runtime/performance_counter.hpp"
+
+// Peak resident set size of the process so far, 0 if unknown. When several models are
+// benchmarked in one process this is the maximum over all of them.
+size_t get_process_peak_rss_bytes();
+
+// Largest memory the executable has held at once: its constants and the activation and
+// scratchpad memory of its contexts
+size_t get_peak_memory_bytes(const ngraph::runtime::MemoryReport& report);
+
+// Machine-readable result of benchmarking one model. Op timings are the average time per call
+// in microseconds, by op type and by op name. peak_memory_bytes is the model's own peak from
+// its memory report; process_peak_rss_bytes is process-wide.
+nlohmann::json make_benchmark_result(const std::string& model,
+                                     const std::string& backend,
+                                     const BenchmarkStats& stats,
+                                     const std::vector<ngraph::runtime::PerformanceCounter>& perf);
+
+void print_memory_report(const ngraph::runtime::MemoryReport& report);
+
+nlohmann::json memory_report_to_json(const ngraph::runtime::MemoryReport& report);
+
+// Compare the results of a run to those of a baseline run, matching models by file and backend.
+// A model regresses if its mean iteration time grows by more than threshold_percent and, when
+// both runs have at least two iterations, a Welch t-test finds the difference significant at
+// the 95% level. Load results regress if throughput drops or p99 latency grows by more than
+// threshold_percent. Compile times and op timings are reported but never count as regressions.
+// Prints a comparison table and returns the number of regressions.
+size_t compare_to_baseline(const nlohmann::json& results,
+                           const nlohmann::json& baseline,
+                           double threshold_percent);
@@ -29,7 +29,10 @@
 #include <iomanip>
 
 #include "benchmark.hpp"
+#include "benchmark_load.hpp"
 #include "benchmark_pipelined.hpp"
+#include "benchmark_results.hpp"
+#include "benchmark_utils.hpp"
 #include "ngraph/component_manager.hpp"
 #include "ngraph/distributed.hpp"
 #include "ngraph/except.hpp"
@@ -186,6 +189,12 @@ int main(int argc, char** argv)
     bool copy_data = true;
     bool dot_file = false;
     bool double_buffer = false;
+    bool load = false;
+    bool memory = false;
+    LoadOptions load_options;
+    string json_file;
+    string baseline_file;
+    double threshold_percent = 5;
 
     configure_static_backends();
     for (int i = 1; i < argc; i++)
@@ -239,6 +248,62 @@ int main(int argc, char** argv)
         {
             double_buffer = true;
         }
+        else if (arg == "--load")
+        {
+            load = true;
+        }
+        else if (arg == "--memory")
+        {
+            memory = true;
+        }
+        else if (arg == "--clients" || arg == "--qps" || arg == "--duration")
+        {
+            try
+            {
+                double value = stod(argv[++i]);
+                if (value < 0)
+                {
+                    throw invalid_argument(arg);
+                }
+                if (arg == "--clients")
+                {
+                    load_options.clients = static_cast<size_t>(value);
+                }
+                else if (arg == "--qps")
+                {
+                    load_options.qps = value;
+                }
+                else
+                {
+                    load_options.duration_seconds = value;
+                }
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--json")
+        {
+            json_file = argv[++i];
+        }
+        else if (arg == "--baseline")
+        {
+            baseline_file = argv[++i];
+        }
+        else if (arg == "--threshold")
+        {
+            try
+            {
+                threshold_percent = stod(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
         else if (arg == "-w" || arg == "--warmup_iterations")
         {
             try
@@ -272,6 +337,11 @@ int main(int argc, char** argv)
         cout << "Either file or directory must be specified\n";
         failed = true;
     }
+    if (!baseline_file.empty() && !file_util::exists(baseline_file))
+    {
+        cout << "Baseline " << baseline_file << " not found\n";
+        failed = true;
+    }
 
     if (failed)
     {
@@ -294,6 +364,18 @@ OPTIONS
         --no_copy_data            Disable copy of input/result data every iteration
         --dot                     Generate Graphviz dot file
         --double_buffer           Double buffer inputs and outputs
+        --load                    Measure latency and throughput under concurrent load
+                                  instead of the average time of -i iterations
+        --clients                 Load mode client threads (default: 1)
+        --qps                     Load mode target calls per second over all clients
+                                  (default: 0, closed loop)
+        --duration                Load mode duration in seconds (default: 10)
+        --memory                  Print the memory held by the compiled model
+        --json                    Write the results to a JSON file
+        --baseline                JSON file written by --json in an earlier run. Exits with 2
+                                  if any model regressed against it
+        --threshold               Percent change from the baseline that counts as a regression
+                                  (default: 5)
 )###";
         return 1;
     }
@@ -318,6 +400,8 @@ OPTIONS
     }
 
     vector<PerfShape> aggregate_perf_data;
+    nlohmann::json results;
+    results["models"] = nlohmann::json::array();
     int rc = 0;
     for (const string& model : models)
     {
@@ -439,20 +523,55 @@ OPTIONS
                 ss << t1.get_milliseconds();
                 cout << "deserialize took " << ss.str() << "ms\n";
                 vector<runtime::PerformanceCounter> perf_data;
+                if (load)
+                {
+                    load_options.warmup_iterations = warmup_iterations;
+                    load_options.copy_data = copy_data;
+                    LoadResult result = run_load_benchmark(f, backend, load_options);
+                    print_load_result(result, load_options);
+                    if (memory)
+                    {
+                        print_memory_report(result.memory);
+                    }
+                    nlohmann::json result_json;
+                    result_json["model"] = model;
+                    result_json["backend"] = backend;
+                    result_json["load"] = load_result_to_json(result, load_options);
+                    result_json["memory"] = memory_report_to_json(result.memory);
+                    results["models"].push_back(result_json);
+                    continue;
+                }
+                BenchmarkStats stats;
                 if (double_buffer)
                 {
-                    perf_data = run_benchmark_pipelined(
-                        f, backend, iterations, timing_detail, warmup_iterations, copy_data);
+                    perf_data = run_benchmark_pipelined(f,
+                                                        backend,
+                                                        iterations,
+                                                        timing_detail,
+                                                        warmup_iterations,
+                                                        copy_data,
+                                                        stats);
                 }
                 else
                 {
-                    perf_data = run_benchmark(
-                        f, backend, iterations, timing_detail, warmup_iterations, copy_data);
+                    perf_data = run_benchmark(f,
+                                              backend,
+                                              iterations,
+                                              timing_detail,
+                                              warmup_iterations,
+                                              copy_data,
+                                              stats);
                 }
+                results["models"].push_back(
+                    make_benchmark_result(model, backend, stats, perf_data));
                 auto perf_shape = to_perf_shape(f, perf_data);
                 aggregate_perf_data.insert(
                     aggregate_perf_data.end(), perf_shape.begin(), perf_shape.end());
                 print_results(perf_shape, timing_detail);
+                if (memory)
+                {
+                    print_memory_report(stats.memory);
+                }
             }
         }
         catch (ngraph::unsupported_op& ue)
@@ -476,5 +595,30 @@ OPTIONS
         print_results(aggregate_perf_data, timing_detail);
     }
 
+    if (!json_file.empty())
+    {
+        ofstream out(json_file);
+        out << results.dump(4) << "\n";
+    }
+
+    if (!baseline_file.empty())
+    {
+        try
+        {
+            ifstream in(baseline_file);
+            nlohmann::json baseline;
+            in >> baseline;
+            if (compare_to_baseline(results, baseline, threshold_percent) > 0)
+            {
+                rc = 2;
+            }
+        }
+        catch (exception& e)
+        {
+            cout << "Failed to read baseline " << baseline_file << "\n" << e.what() << endl;
+            rc += 1;
+        }
+    }
+
     return rc;
 }
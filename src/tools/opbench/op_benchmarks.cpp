@@ -0,0 +1,245 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <sstream>
+
+#include "ngraph/ops.hpp"
+#include "ngraph/util.hpp"
+#include "op_benchmarks.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static string shape_string(const Shape& shape)
+{
+    return "{" + join(shape) + "}";
+}
+
+static OpBenchmark make_benchmark(const string& op,
+                                  const string& config,
+                                  const element::Type& element_type,
+                                  double flops,
+                                  function<shared_ptr<Function>()> make_function)
+{
+    OpBenchmark benchmark;
+    benchmark.op = op;
+    benchmark.config = config;
+    benchmark.element_type = element_type;
+    benchmark.flops = flops;
+    benchmark.make_function = make_function;
+    return benchmark;
+}
+
+static OpBenchmark convolution(size_t n,
+                               size_t channels,
+                               size_t image_size,
+                               size_t filters,
+                               size_t window,
+                               size_t stride,
+                               size_t padding)
+{
+    size_t out = (image_size + 2 * padding - window) / stride + 1;
+    stringstream config;
+    config << "N" << n << " C" << channels << " " << image_size << "x" << image_size << " K"
+           << filters << " " << window << "x" << window << " s" << stride << " p" << padding;
+    double flops = 2.0 * n * filters * out * out * channels * window * window;
+    return make_benchmark("Convolution", config.str(), element::f32, flops, [=]() {
+        auto data = make_shared<op::Parameter>(element::f32,
+                                               Shape{n, channels, image_size, image_size});
+        auto weights =
+            make_shared<op::Parameter>(element::f32, Shape{filters, channels, window, window});
+        CoordinateDiff pad{static_cast<ptrdiff_t>(padding), static_cast<ptrdiff_t>(padding)};
+        auto conv = make_shared<op::Convolution>(
+            data, weights, Strides{stride, stride}, Strides{1, 1}, pad, pad);
+        return make_shared<Function>(conv, ParameterVector{data, weights});
+    });
+}
+
+static OpBenchmark dot(size_t m, size_t k, size_t n)
+{
+    stringstream config;
+    config << m << "x" << k << " * " << k << "x" << n;
+    return make_benchmark("Dot", config.str(), element::f32, 2.0 * m * k * n, [=]() {
+        auto a = make_shared<op::Parameter>(element::f32, Shape{m, k});
+        auto b = make_shared<op::Parameter>(element::f32, Shape{k, n});
+        return make_shared<Function>(make_shared<op::Dot>(a, b), ParameterVector{a, b});
+    });
+}
+
+template <typename OP>
+static OpBenchmark binary(const string& op, const element::Type& type, const Shape& shape)
+{
+    return make_benchmark(op, shape_string(shape), type, 0, [=]() {
+        auto a = make_shared<op::Parameter>(type, shape);
+        auto b = make_shared<op::Parameter>(type, shape);
+        return make_shared<Function>(make_shared<OP>(a, b), ParameterVector{a, b});
+    });
+}
+
+template <typename OP>
+static OpBenchmark unary(const string& op, const element::Type& type, const Shape& shape)
+{
+    return make_benchmark(op, shape_string(shape), type, 0, [=]() {
+        auto a = make_shared<op::Parameter>(type, shape);
+        return make_shared<Function>(make_shared<OP>(a), ParameterVector{a});
+    });
+}
+
+template <typename OP>
+static OpBenchmark
+    reduce(const string& op, const element::Type& type, const Shape& shape, const AxisSet& axes)
+{
+    string config = shape_string(shape) + " axes " + shape_string(Shape(axes.begin(), axes.end()));
+    return make_benchmark(op, config, type, 0, [=]() {
+        auto a = make_shared<op::Parameter>(type, shape);
+        return make_shared<Function>(make_shared<OP>(a, axes), ParameterVector{a});
+    });
+}
+
+static OpBenchmark softmax(const Shape& shape, size_t axis)
+{
+    string config = shape_string(shape) + " axis " + to_string(axis);
+    return make_benchmark("Softmax", config, element::f32, 0, [=]() {
+        auto a = make_shared<op::Parameter>(element::f32, shape);
+        return make_shared<Function>(make_shared<op::Softmax>(a, AxisSet{axis}),
+                                     ParameterVector{a});
+    });
+}
+
+static OpBenchmark gather(const element::Type& type, const Shape& shape, size_t indices)
+{
+    string config = shape_string(shape) + " indices {" + to_string(indices) + "}";
+    OpBenchmark benchmark = make_benchmark("Gather", config, type, 0, [=]() {
+        auto data = make_shared<op::Parameter>(type, shape);
+        auto index = make_shared<op::Parameter>(element::i64, Shape{indices});
+        return make_shared<Function>(make_shared<op::Gather>(data, index),
+                                     ParameterVector{data, index});
+    });
+    benchmark.int_range = shape[0];
+    return benchmark;
+}
+
+static OpBenchmark broadcast(const Shape& shape, const Shape& result_shape, const AxisSet& axes)
+{
+    string config = shape_string(shape) + " -> " + shape_string(result_shape) + " axes " +
+                    shape_string(Shape(axes.begin(), axes.end()));
+    return make_benchmark("Broadcast", config, element::f32, 0, [=]() {
+        auto a = make_shared<op::Parameter>(element::f32, shape);
+        return make_shared<Function>(make_shared<op::Broadcast>(a, result_shape, axes),
+                                     ParameterVector{a});
+    });
+}
+
+static OpBenchmark reshape(const Shape& shape, const AxisVector& order, const Shape& result_shape)
+{
+    string config = shape_string(shape) + " order " + shape_string(Shape(order)) + " -> " +
+                    shape_string(result_shape);
+    return make_benchmark("Reshape", config, element::f32, 0, [=]() {
+        auto a = make_shared<op::Parameter>(element::f32, shape);
+        return make_shared<Function>(make_shared<op::Reshape>(a, order, result_shape),
+                                     ParameterVector{a});
+    });
+}
+
+static OpBenchmark concat(const Shape& shape, size_t count, size_t axis)
+{
+    string config = to_string(count) + " x " + shape_string(shape) + " axis " + to_string(axis);
+    return make_benchmark("Concat", config, element::f32, 0, [=]() {
+        ParameterVector params;
+        NodeVector args;
+        for (size_t i = 0; i < count; i++)
+        {
+            auto param = make_shared<op::Parameter>(element::f32, shape);
+            params.push_back(param);
+            args.push_back(param);
+        }
+        return make_shared<Function>(make_shared<op::Concat>(args, axis), params);
+    });
+}
+
+template <typename OP>
+static OpBenchmark pool(const string& op, const Shape& shape, size_t window, size_t stride)
+{
+    stringstream config;
+    config << shape_string(shape) << " " << window << "x" << window << " s" << stride;
+    return make_benchmark(op, config.str(), element::f32, 0, [=]() {
+        auto a = make_shared<op::Parameter>(element::f32, shape);
+        return make_shared<Function>(
+            make_shared<OP>(a, Shape{window, window}, Strides{stride, stride}),
+            ParameterVector{a});
+    });
+}
+
+vector<OpBenchmark> get_op_benchmarks()
+{
+    vector<OpBenchmark> benchmarks;
+
+    // ResNet-50 style layers
+    benchmarks.push_back(convolution(1, 3, 224, 64, 7, 2, 3));
+    benchmarks.push_back(convolution(1, 64, 56, 64, 3, 1, 1));
+    benchmarks.push_back(convolution(1, 256, 56, 64, 1, 1, 0));
+    benchmarks.push_back(convolution(1, 256, 14, 256, 3, 1, 1));
+    benchmarks.push_back(convolution(8, 64, 28, 64, 3, 1, 1));
+
+    benchmarks.push_back(dot(1, 1024, 1024));
+    benchmarks.push_back(dot(64, 1024, 1024));
+    benchmarks.push_back(dot(256, 256, 256));
+    benchmarks.push_back(dot(512, 512, 512));
+
+    for (const element::Type& type : {element::f32, element::i32})
+    {
+        benchmarks.push_back(binary<op::Add>("Add", type, Shape{1 << 20}));
+        benchmarks.push_back(binary<op::Add>("Add", type, Shape{32, 64, 56, 56}));
+        benchmarks.push_back(binary<op::Multiply>("Multiply", type, Shape{1 << 20}));
+    }
+    benchmarks.push_back(unary<op::Relu>("Relu", element::f32, Shape{32, 64, 56, 56}));
+
+    for (const element::Type& type : {element::f32, element::i32})
+    {
+        benchmarks.push_back(reduce<op::Sum>("Sum", type, Shape{1024, 1024}, AxisSet{0}));
+        benchmarks.push_back(reduce<op::Sum>("Sum", type, Shape{1024, 1024}, AxisSet{1}));
+        benchmarks.push_back(reduce<op::Sum>("Sum", type, Shape{32, 256, 14, 14}, AxisSet{2, 3}));
+        benchmarks.push_back(reduce<op::Max>("Max", type, Shape{1024, 1024}, AxisSet{1}));
+    }
+    benchmarks.push_back(reduce<op::Min>("Min", element::f32, Shape{1024, 1024}, AxisSet{1}));
+    benchmarks.push_back(
+        reduce<op::Product>("Product", element::f32, Shape{1024, 1024}, AxisSet{1}));
+
+    benchmarks.push_back(softmax(Shape{64, 1000}, 1));
+    benchmarks.push_back(softmax(Shape{8, 12, 128, 128}, 3));
+
+    benchmarks.push_back(gather(element::f32, Shape{30000, 256}, 4096));
+    benchmarks.push_back(gather(element::i32, Shape{30000, 256}, 4096));
+
+    benchmarks.push_back(broadcast(Shape{1024}, Shape{1024, 1024}, AxisSet{0}));
+    benchmarks.push_back(broadcast(Shape{1024}, Shape{1024, 1024}, AxisSet{1}));
+    benchmarks.push_back(broadcast(Shape{64}, Shape{32, 64, 56, 56}, AxisSet{0, 2, 3}));
+
+    benchmarks.push_back(reshape(Shape{1024, 1024}, AxisVector{1, 0}, Shape{1024, 1024}));
+    benchmarks.push_back(
+        reshape(Shape{32, 64, 56, 56}, AxisVector{0, 2, 3, 1}, Shape{32, 56, 56, 64}));
+    benchmarks.push_back(
+        reshape(Shape{32, 64, 56, 56}, AxisVector{0, 1, 2, 3}, Shape{32, 64 * 56 * 56}));
+
+    benchmarks.push_back(concat(Shape{32, 1, 200}, 6, 1));
+    benchmarks.push_back(concat(Shape{32, 256, 14, 14}, 4, 1));
+    benchmarks.push_back(concat(Shape{256, 1024}, 4, 0));
+
+    benchmarks.push_back(pool<op::MaxPool>("MaxPool", Shape{1, 64, 112, 112}, 3, 2));
+    benchmarks.push_back(pool<op::AvgPool>("AvgPool", Shape{8, 256, 14, 14}, 2, 2));
+
+    return benchmarks;
+}
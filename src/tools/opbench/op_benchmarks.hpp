@@ -0,0 +1,44 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ngraph/function.hpp"
+
+// One op on one configuration of shapes and element type
+struct OpBenchmark
+{
+    std::string op;
+    // Shapes and attributes, for display
+    std::string config;
+    ngraph::element::Type element_type;
+    // Floating point operations per call, 0 for ops bound by memory bandwidth
+    double flops = 0;
+    // Integer inputs are filled with values in [0, int_range) so they can serve as indices
+    int64_t int_range = 16;
+    // Builds a new function holding just the op. Backends may rewrite a function while
+    // compiling it, so each backend gets its own.
+    std::function<std::shared_ptr<ngraph::Function>()> make_function;
+};
+
+// Representative shapes and element types for the core ops
+std::vector<OpBenchmark> get_op_benchmarks();
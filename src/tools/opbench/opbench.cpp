@@ -0,0 +1,367 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+// Benchmarks single ops on each backend. Throughput is GFLOP/s for compute bound ops and GB/s
+// of input and output data for the rest. Comparing backends shows which kernels fall back to
+// slow reference implementations for the shapes benchmarked.
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include <nlohmann/json.hpp>
+
+#include "ngraph/component_manager.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/tensor.hpp"
+#include "ngraph/util.hpp"
+#include "op_benchmarks.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static void configure_static_backends()
+{
+#ifdef NGRAPH_CPU_ENABLE
+    ngraph_register_cpu_backend();
+#endif
+#ifdef NGRAPH_INTERPRETER_ENABLE
+    ngraph_register_interpreter_backend();
+#endif
+#ifdef NGRAPH_GENERIC_CPU_ENABLE
+    ngraph_register_gcpu_backend();
+#endif
+}
+
+struct Options
+{
+    size_t warmup_iterations = 2;
+    size_t repetitions = 5;
+    // Minimum time of one repetition, short ops are called repeatedly to reach it
+    double min_repetition_ms = 20;
+};
+
+struct Measurement
+{
+    bool supported = true;
+    string error;
+    // Median over the repetitions
+    double seconds_per_call = 0;
+};
+
+template <typename T, typename DISTRIBUTION>
+static void fill(const shared_ptr<runtime::Tensor>& tensor, DISTRIBUTION distribution)
+{
+    static default_random_engine engine;
+    vector<T> data(tensor->get_element_count());
+    for (T& value : data)
+    {
+        value = static_cast<T>(distribution(engine));
+    }
+    tensor->write(data.data(), data.size() * sizeof(T));
+}
+
+static void random_init(const shared_ptr<runtime::Tensor>& tensor, int64_t int_range)
+{
+    uniform_real_distribution<double> real(-1, 1);
+    uniform_int_distribution<int64_t> integer(0, max<int64_t>(int_range, 1) - 1);
+    switch (tensor->get_element_type())
+    {
+    case element::Type_t::f32: fill<float>(tensor, real); break;
+    case element::Type_t::f64: fill<double>(tensor, real); break;
+    case element::Type_t::i32: fill<int32_t>(tensor, integer); break;
+    case element::Type_t::i64: fill<int64_t>(tensor, integer); break;
+    default:
+        vector<char> zeros(tensor->get_size_in_bytes());
+        tensor->write(zeros.data(), zeros.size());
+        break;
+    }
+}
+
+static double time_calls(const shared_ptr<runtime::Executable>& exec,
+                         const vector<shared_ptr<runtime::Tensor>>& results,
+                         const vector<shared_ptr<runtime::Tensor>>& args,
+                         size_t calls)
+{
+    stopwatch timer;
+    timer.start();
+    for (size_t i = 0; i < calls; i++)
+    {
+        exec->call(results, args);
+    }
+    timer.stop();
+    return timer.get_nanoseconds() / 1e9;
+}
+
+static Measurement measure(const OpBenchmark& benchmark,
+                           const shared_ptr<runtime::Backend>& backend,
+                           const Options& options)
+{
+    Measurement measurement;
+    try
+    {
+        shared_ptr<Function> f = benchmark.make_function();
+        shared_ptr<runtime::Executable> exec = backend->compile(f);
+        vector<shared_ptr<runtime::Tensor>> args;
+        for (const shared_ptr<op::Parameter>& param : f->get_parameters())
+        {
+            auto tensor = backend->create_tensor(param->get_element_type(), param->get_shape());
+            random_init(tensor, benchmark.int_range);
+            args.push_back(tensor);
+        }
+        vector<shared_ptr<runtime::Tensor>> results;
+        for (const shared_ptr<op::Result>& result : f->get_results())
+        {
+            results.push_back(
+                backend->create_tensor(result->get_element_type(), result->get_shape()));
+        }
+
+        time_calls(exec, results, args, options.warmup_iterations);
+        double estimate = time_calls(exec, results, args, 1);
+        size_t calls = 1;
+        if (estimate > 0)
+        {
+            calls = max<size_t>(1, static_cast<size_t>(options.min_repetition_ms / 1e3 / estimate));
+        }
+        vector<double> times;
+        for (size_t i = 0; i < max<size_t>(1, options.repetitions); i++)
+        {
+            times.push_back(time_calls(exec, results, args, calls) / calls);
+        }
+        sort(times.begin(), times.end());
+        measurement.seconds_per_call = times[times.size() / 2];
+    }
+    catch (const exception& e)
+    {
+        measurement.supported = false;
+        measurement.error = e.what();
+    }
+    return measurement;
+}
+
+// Bytes of input and output data touched by one call
+static double data_bytes(const OpBenchmark& benchmark)
+{
+    shared_ptr<Function> f = benchmark.make_function();
+    double bytes = 0;
+    for (const shared_ptr<op::Parameter>& param : f->get_parameters())
+    {
+        bytes += param->get_element_type().size() * shape_size(param->get_shape());
+    }
+    for (const shared_ptr<op::Result>& result : f->get_results())
+    {
+        bytes += result->get_element_type().size() * shape_size(result->get_shape());
+    }
+    return bytes;
+}
+
+static double throughput(const OpBenchmark& benchmark, double bytes, double seconds)
+{
+    if (seconds <= 0)
+    {
+        return 0;
+    }
+    return (benchmark.flops > 0 ? benchmark.flops : bytes) / seconds / 1e9;
+}
+
+int main(int argc, char** argv)
+{
+    vector<string> backend_names;
+    vector<string> ops;
+    string json_file;
+    Options options;
+    bool failed = false;
+
+    configure_static_backends();
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        try
+        {
+            if ((arg == "-b" || arg == "--backend") && i + 1 < argc)
+            {
+                backend_names.push_back(argv[++i]);
+            }
+            else if (arg == "--op" && i + 1 < argc)
+            {
+                ops.push_back(argv[++i]);
+            }
+            else if ((arg == "-w" || arg == "--warmup_iterations") && i + 1 < argc)
+            {
+                options.warmup_iterations = stoul(argv[++i]);
+            }
+            else if ((arg == "-r" || arg == "--repetitions") && i + 1 < argc)
+            {
+                options.repetitions = stoul(argv[++i]);
+            }
+            else if (arg == "--min_time" && i + 1 < argc)
+            {
+                options.min_repetition_ms = stod(argv[++i]);
+            }
+            else if (arg == "--json" && i + 1 < argc)
+            {
+                json_file = argv[++i];
+            }
+            else
+            {
+                cout << "Unknown option: " << arg << endl;
+                failed = true;
+            }
+        }
+        catch (...)
+        {
+            cout << "Invalid Argument\n";
+            failed = true;
+        }
+    }
+
+    if (failed)
+    {
+        cout << R"###(
+DESCRIPTION
+    Benchmark single ops on representative shapes on each backend. Reports GFLOP/s for
+    Convolution and Dot and GB/s of input and output data for the other ops. Backends
+    within 2x of INTERPRETER are marked with '~ref', their kernel is likely a reference
+    implementation.
+
+SYNOPSIS
+        opbench [-b <backend>]... [--op <op>]...
+
+OPTIONS
+        -b|--backend              Backend to benchmark, may be repeated
+                                  (default: INTERPRETER, GCPU and CPU where available)
+        --op                      Only benchmark this op, may be repeated
+        -w|--warmup_iterations    Untimed calls before measuring (default: 2)
+        -r|--repetitions          Timed repetitions, the median is reported (default: 5)
+        --min_time                Minimum milliseconds per repetition (default: 20)
+        --json                    Write the results to a JSON file
+)###";
+        return 1;
+    }
+
+    if (backend_names.empty())
+    {
+        backend_names = {"INTERPRETER", "GCPU", "CPU"};
+    }
+    vector<string> names;
+    vector<shared_ptr<runtime::Backend>> backends;
+    for (const string& name : backend_names)
+    {
+        try
+        {
+            backends.push_back(runtime::Backend::create(name));
+            names.push_back(name);
+        }
+        catch (const exception& e)
+        {
+            cout << "Backend " << name << " not available\n";
+        }
+    }
+    if (backends.empty())
+    {
+        return 1;
+    }
+    auto interpreter = find(names.begin(), names.end(), "INTERPRETER");
+
+    vector<OpBenchmark> benchmarks;
+    size_t name_width = 0;
+    for (const OpBenchmark& benchmark : get_op_benchmarks())
+    {
+        if (ops.empty() || find(ops.begin(), ops.end(), benchmark.op) != ops.end())
+        {
+            benchmarks.push_back(benchmark);
+            name_width = max(name_width, benchmark.op.size() + benchmark.config.size() + 3);
+        }
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+    const int column_width = 24;
+    cout << setw(name_width) << left << "op" << setw(5) << "type";
+    for (const string& name : names)
+    {
+        cout << setw(column_width) << right << name;
+    }
+    cout << "\n" << fixed << setprecision(2);
+
+    for (const OpBenchmark& benchmark : benchmarks)
+    {
+        double bytes = data_bytes(benchmark);
+        string unit = benchmark.flops > 0 ? " GFLOP/s" : " GB/s";
+        vector<Measurement> measurements;
+        for (const shared_ptr<runtime::Backend>& backend : backends)
+        {
+            measurements.push_back(measure(benchmark, backend, options));
+        }
+
+        string name = benchmark.op + " " + benchmark.config;
+        cout << setw(name_width) << left << name << setw(5)
+             << benchmark.element_type.get_type_name() << right;
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            const Measurement& measurement = measurements[i];
+            stringstream column;
+            column << fixed << setprecision(2);
+            if (measurement.supported)
+            {
+                double value = throughput(benchmark, bytes, measurement.seconds_per_call);
+                column << value << unit;
+                if (interpreter != names.end() && names[i] != "INTERPRETER")
+                {
+                    const Measurement& reference = measurements[interpreter - names.begin()];
+                    if (reference.supported &&
+                        measurement.seconds_per_call * 2 > reference.seconds_per_call)
+                    {
+                        column << " ~ref";
+                    }
+                }
+            }
+            else
+            {
+                column << "unsupported";
+            }
+            cout << setw(column_width) << column.str();
+
+            nlohmann::json result;
+            result["op"] = benchmark.op;
+            result["config"] = benchmark.config;
+            result["element_type"] = benchmark.element_type.get_type_name();
+            result["backend"] = names[i];
+            result["supported"] = measurement.supported;
+            if (measurement.supported)
+            {
+                result["seconds_per_call"] = measurement.seconds_per_call;
+                result[benchmark.flops > 0 ? "gflops" : "gbytes_per_second"] =
+                    throughput(benchmark, bytes, measurement.seconds_per_call);
+            }
+            else
+            {
+                result["error"] = measurement.error;
+            }
+            results.push_back(result);
+        }
+        cout << endl;
+    }
+
+    if (!json_file.empty())
+    {
+        ofstream out(json_file);
+        out << nlohmann::json{{"benchmarks", results}}.dump(4) << "\n";
+    }
+    return 0;
+}
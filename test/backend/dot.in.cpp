@@ -685,6 +685,104 @@ NGRAPH_TEST(${BACKEND_NAME}, dot_matrix_vector_int64)
     EXPECT_EQ((vector<int64_t>{190, 486, 782, 1078}), read_vector<int64_t>(result));
 }
 
+// M = 33, K = 257 and N = 129 are one or two past a multiple of the reference kernel's block
+// sizes, so every dimension ends in a partial block.
+NGRAPH_TEST(${BACKEND_NAME}, dot_matrix_block_boundaries_int64)
+{
+    size_t m = 33;
+    size_t k = 257;
+    size_t n = 129;
+    Shape shape_a{m, k};
+    Shape shape_b{k, n};
+    auto A = make_shared<op::Parameter>(element::i64, shape_a);
+    auto B = make_shared<op::Parameter>(element::i64, shape_b);
+    auto f = make_shared<Function>(make_shared<op::Dot>(A, B), ParameterVector{A, B});
+    Shape shape_r{m, n};
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    vector<int64_t> a_data(m * k);
+    vector<int64_t> b_data(k * n);
+    for (size_t i = 0; i < a_data.size(); i++)
+    {
+        a_data[i] = static_cast<int64_t>(i % 7) - 3;
+    }
+    for (size_t i = 0; i < b_data.size(); i++)
+    {
+        b_data[i] = static_cast<int64_t>(i % 11) - 5;
+    }
+    vector<int64_t> expected(m * n, 0);
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+        {
+            for (size_t p = 0; p < k; p++)
+            {
+                expected[i * n + j] += a_data[i * k + p] * b_data[p * n + j];
+            }
+        }
+    }
+
+    auto a = backend->create_tensor(element::i64, shape_a);
+    copy_data(a, a_data);
+    auto b = backend->create_tensor(element::i64, shape_b);
+    copy_data(b, b_data);
+    auto result = backend->create_tensor(element::i64, shape_r);
+
+    auto handle = backend->compile(f);
+    handle->call_with_validate({result}, {a, b});
+    EXPECT_EQ(expected, read_vector<int64_t>(result));
+}
+
+// The same partial blocks reached through a multi-axis dot, which flattens {3, 11} x {257} and
+// {257} x {3, 43} to the 33 x 257 and 257 x 129 matrices.
+NGRAPH_TEST(${BACKEND_NAME}, dot_multi_axis_block_boundaries)
+{
+    size_t m = 33;
+    size_t k = 257;
+    size_t n = 129;
+    Shape shape_a{3, 11, k};
+    Shape shape_b{k, 3, 43};
+    auto A = make_shared<op::Parameter>(element::f32, shape_a);
+    auto B = make_shared<op::Parameter>(element::f32, shape_b);
+    auto f = make_shared<Function>(make_shared<op::Dot>(A, B, 1), ParameterVector{A, B});
+    Shape shape_r{3, 11, 3, 43};
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    vector<float> a_data(m * k);
+    vector<float> b_data(k * n);
+    for (size_t i = 0; i < a_data.size(); i++)
+    {
+        a_data[i] = static_cast<float>(i % 13) / 8.0f - 0.75f;
+    }
+    for (size_t i = 0; i < b_data.size(); i++)
+    {
+        b_data[i] = static_cast<float>(i % 17) / 4.0f - 2.0f;
+    }
+    vector<float> expected(m * n, 0);
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+        {
+            for (size_t p = 0; p < k; p++)
+            {
+                expected[i * n + j] += a_data[i * k + p] * b_data[p * n + j];
+            }
+        }
+    }
+
+    auto a = backend->create_tensor(element::f32, shape_a);
+    copy_data(a, a_data);
+    auto b = backend->create_tensor(element::f32, shape_b);
+    copy_data(b, b_data);
+    auto result = backend->create_tensor(element::f32, shape_r);
+
+    auto handle = backend->compile(f);
+    handle->call_with_validate({result}, {a, b});
+    EXPECT_TRUE(test::all_close_f(expected, read_vector<float>(result)));
+}
+
 //
 // Numpy test:
 //
@@ -14,8 +14,11 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/dynamic/dynamic_backend.hpp"
 #include "util/all_close_f.hpp"
 #include "util/test_control.hpp"
 #include "util/test_tools.hpp"
@@ -292,3 +295,198 @@ NGRAPH_TEST(${BACKEND_NAME}, dynamic_reverse_shape)
                         Shape{8, 2, 8, 2},
                         Shape{2, 3, 4, 5, 2}});
 }
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_precompile)
+{
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{2, Dimension::dynamic()});
+    auto b = make_shared<op::Parameter>(element::f32, PartialShape{2, Dimension::dynamic()});
+    auto f = make_shared<Function>(NodeVector{a + b}, ParameterVector{a, b});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    if (ex == nullptr)
+    {
+        // The backend supports dynamic shapes natively.
+        return;
+    }
+    ex->precompile({{Shape{2, 1}, Shape{2, 1}}, {Shape{2, 4}, Shape{2, 4}}});
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape{2, Dimension::dynamic()});
+    for (size_t n : {1, 4, 4, 1})
+    {
+        auto t_a = backend->create_tensor(element::f32, Shape{2, n});
+        copy_data(t_a, vector<float>(2 * n, 1));
+        ex->call_with_validate({t_r}, {t_a, t_a});
+        ASSERT_EQ(t_r->get_shape(), (Shape{2, n}));
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r), vector<float>(2 * n, 2)));
+    }
+    EXPECT_EQ(ex->get_cache_statistics().entries, 2);
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_precompile_queue)
+{
+    // Precompilations are queued to one background thread. Calls wait for theirs, and an
+    // executable destroyed with compilations still queued drops them.
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto f = make_shared<Function>(NodeVector{a + a}, ParameterVector{a});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    if (ex == nullptr)
+    {
+        // The backend supports dynamic shapes natively.
+        return;
+    }
+    vector<vector<Shape>> input_shapes;
+    for (size_t n = 1; n <= 8; n++)
+    {
+        input_shapes.push_back({Shape{n}});
+    }
+    ex->precompile(input_shapes);
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape{Dimension::dynamic()});
+    auto t_a = backend->create_tensor(element::f32, Shape{8});
+    copy_data(t_a, vector<float>(8, 1));
+    ex->call_with_validate({t_r}, {t_a});
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r), vector<float>(8, 2)));
+    EXPECT_EQ(ex->get_cache_statistics().entries, 8);
+
+    auto dropped = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    dropped->precompile(input_shapes);
+    dropped.reset();
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_shape_buckets)
+{
+    // The weights are static on both bucketed axes and must not be padded.
+    auto x = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 4});
+    auto w = make_shared<op::Parameter>(element::f32, PartialShape{4, 3});
+    auto f = make_shared<Function>(NodeVector{make_shared<op::Dot>(x, w)}, ParameterVector{x, w});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    if (dynamic_pointer_cast<runtime::dynamic::DynamicBackend>(backend) == nullptr)
+    {
+        // The backend supports dynamic shapes natively.
+        return;
+    }
+    auto exact_ex = backend->compile(f);
+    string error;
+    ASSERT_TRUE(backend->set_config({{"shape_buckets", "0:2,8;1:8"}}, error)) << error;
+    auto ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    ASSERT_NE(ex, nullptr);
+
+    auto t_w = backend->create_tensor(element::f32, Shape{4, 3});
+    copy_data(t_w, vector<float>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    auto t_expected = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    // 1 pads to 2, 3, 5 and 8 share the bucket of 8, and 9 is past the largest bucket
+    for (size_t n : {1, 3, 5, 8, 9})
+    {
+        auto t_x = backend->create_tensor(element::f32, Shape{n, 4});
+        vector<float> x_data(n * 4);
+        iota(x_data.begin(), x_data.end(), 1.0f);
+        copy_data(t_x, x_data);
+        ex->call_with_validate({t_r}, {t_x, t_w});
+        exact_ex->call_with_validate({t_expected}, {t_x, t_w});
+        ASSERT_EQ(t_r->get_shape(), (Shape{n, 3}));
+        EXPECT_TRUE(
+            test::all_close_f(read_vector<float>(t_r), read_vector<float>(t_expected)));
+    }
+    EXPECT_EQ(ex->get_cache_statistics().entries, 3);
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_shape_buckets_static_output)
+{
+    // The second output has a static extent equal to the bucket size on the bucketed axis and
+    // must not be sliced.
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto w = make_shared<op::Parameter>(element::f32, PartialShape{8});
+    auto f = make_shared<Function>(NodeVector{a * a, w + w}, ParameterVector{a, w});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    if (dynamic_pointer_cast<runtime::dynamic::DynamicBackend>(backend) == nullptr)
+    {
+        // The backend supports dynamic shapes natively.
+        return;
+    }
+    string error;
+    ASSERT_TRUE(backend->set_config({{"shape_buckets", "0:8"}}, error)) << error;
+    auto ex = backend->compile(f);
+
+    auto t_a = backend->create_tensor(element::f32, Shape{3});
+    copy_data(t_a, vector<float>{1, 2, 3});
+    auto t_w = backend->create_tensor(element::f32, Shape{8});
+    copy_data(t_w, vector<float>{1, 2, 3, 4, 5, 6, 7, 8});
+    auto t_r0 = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    auto t_r1 = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    ex->call_with_validate({t_r0, t_r1}, {t_a, t_w});
+    ASSERT_EQ(t_r0->get_shape(), (Shape{3}));
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r0), vector<float>{1, 4, 9}));
+    ASSERT_EQ(t_r1->get_shape(), (Shape{8}));
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r1),
+                                  vector<float>{2, 4, 6, 8, 10, 12, 14, 16}));
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_shape_buckets_reused_padding)
+{
+    // Zero padding does not change a sum over the bucketed axis, as long as rows left in the
+    // staging tensor by an earlier, larger input are cleared.
+    auto x = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 2});
+    auto f = make_shared<Function>(NodeVector{make_shared<op::Sum>(x, AxisSet{0})},
+                                   ParameterVector{x});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    if (dynamic_pointer_cast<runtime::dynamic::DynamicBackend>(backend) == nullptr)
+    {
+        // The backend supports dynamic shapes natively.
+        return;
+    }
+    string error;
+    ASSERT_TRUE(backend->set_config({{"shape_buckets", "0:8"}}, error)) << error;
+    auto ex = backend->compile(f);
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    for (size_t n : {5, 3, 3, 7})
+    {
+        auto t_x = backend->create_tensor(element::f32, Shape{n, 2});
+        copy_data(t_x, vector<float>(n * 2, 1.0f));
+        ex->call_with_validate({t_r}, {t_x});
+        ASSERT_EQ(t_r->get_shape(), (Shape{2}));
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r),
+                                      vector<float>(2, static_cast<float>(n))));
+    }
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_compile_fallback)
+{
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto b = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto f = make_shared<Function>(NodeVector{a * b}, ParameterVector{a, b});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    if (dynamic_pointer_cast<runtime::dynamic::DynamicBackend>(backend) == nullptr)
+    {
+        // The backend supports dynamic shapes natively.
+        return;
+    }
+    string error;
+    ASSERT_TRUE(backend->set_config({{"compile_fallback", "INTERPRETER"}}, error)) << error;
+    auto ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    ASSERT_NE(ex, nullptr);
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape{Dimension::dynamic()});
+    for (size_t i = 0; i < 4; i++)
+    {
+        auto t_a = backend->create_tensor(element::f32, Shape{3});
+        copy_data(t_a, vector<float>{1, 2, 3});
+        ex->call_with_validate({t_r}, {t_a, t_a});
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r), vector<float>{1, 4, 9}));
+    }
+
+    // The first call misses and cannot wait for the background compilation, so at least it ran
+    // on the fallback backend, and every fallback call used the one fallback executable.
+    auto fallback_stats = ex->get_fallback_statistics();
+    EXPECT_GE(fallback_stats.hits + fallback_stats.misses, 1);
+    EXPECT_EQ(fallback_stats.entries, 1);
+    EXPECT_EQ(fallback_stats.misses, 1);
+}
@@ -14,9 +14,22 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
 #include "gtest/gtest.h"
+#include "ngraph/env_util.hpp"
+#include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/host_tensor.hpp"
+#include "ngraph/runtime/persistent_cache.hpp"
 #include "ngraph/util.hpp"
 #include "util/all_close_f.hpp"
 #include "util/test_tools.hpp"
@@ -91,6 +104,444 @@ TEST(backend_api, save_load)
 }
 #endif
 
+#ifndef NGRAPH_JSON_DISABLE
+namespace
+{
+    class CountingCache : public runtime::PersistentCache
+    {
+    public:
+        using runtime::PersistentCache::PersistentCache;
+        shared_ptr<runtime::Executable> load(runtime::Backend& backend,
+                                             const string& key) override
+        {
+            auto exec = runtime::PersistentCache::load(backend, key);
+            (exec ? hits : misses)++;
+            return exec;
+        }
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+}
+
+TEST(backend_api, persistent_cache)
+{
+    // relu(A . W - C), with the weights and offsets as constants
+    auto make_function = [](float offset) {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+        auto W = op::Constant::create(element::f32, Shape{3, 2}, {1, 2, 3, 4, 5, 6});
+        auto C = op::Constant::create(element::f32, Shape{2, 2}, vector<float>{1, offset, -10, 0});
+        return make_shared<Function>(make_shared<op::Relu>(make_shared<op::Dot>(A, W) - C),
+                                     ParameterVector{A});
+    };
+    string directory =
+        file_util::path_join(file_util::get_temp_directory_path(), "persistent_cache_test");
+    file_util::remove_directory(directory);
+    auto for_each_entry = [&directory](function<void(const string&)> f) {
+        file_util::iterate_files(directory, [&f](const string& file, bool is_dir) {
+            if (!is_dir && file_util::get_file_ext(file) == ".cache")
+            {
+                f(file);
+            }
+        });
+    };
+    auto count_entries = [&for_each_entry]() {
+        size_t count = 0;
+        for_each_entry([&count](const string&) { count++; });
+        return count;
+    };
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto a = backend->create_tensor(element::f32, Shape{2, 3});
+    auto result = backend->create_tensor(element::f32, Shape{2, 2});
+    copy_data<float>(a, {1, -1, 2, 0, 1, -2});
+    vector<float> expected{7, 0, 3, 0};
+
+    auto first_cache = make_shared<CountingCache>(directory);
+    backend->set_persistent_cache(first_cache);
+    backend->compile(make_function(20));
+    EXPECT_EQ(first_cache->misses, 1);
+    EXPECT_EQ(count_entries(), 1);
+
+    // A new cache on the same directory stands in for another process. It finds the entry
+    // for an identical function built separately, with different node names.
+    auto second_cache = make_shared<CountingCache>(directory);
+    auto other_backend = runtime::Backend::create("INTERPRETER");
+    other_backend->set_persistent_cache(second_cache);
+    auto handle = other_backend->compile(make_function(20));
+    EXPECT_EQ(second_cache->hits, 1);
+    EXPECT_EQ(second_cache->misses, 0);
+    handle->call_with_validate({result}, {a});
+    EXPECT_EQ(read_vector<float>(result), expected);
+
+    // A damaged entry is a miss, the function is compiled again and the entry rewritten
+    for_each_entry([](const string& file) {
+        ofstream out(file, ios_base::binary | ios_base::trunc);
+        out << "not a cache entry";
+    });
+    handle = other_backend->compile(make_function(20));
+    EXPECT_EQ(second_cache->misses, 1);
+    handle->call_with_validate({result}, {a});
+    EXPECT_EQ(read_vector<float>(result), expected);
+    auto third_cache = make_shared<CountingCache>(directory);
+    other_backend->set_persistent_cache(third_cache);
+    other_backend->compile(make_function(20));
+    EXPECT_EQ(third_cache->hits, 1);
+
+    // Different constant data is a different entry
+    handle = other_backend->compile(make_function(0));
+    EXPECT_EQ(third_cache->misses, 1);
+    EXPECT_EQ(count_entries(), 2);
+    handle->call_with_validate({result}, {a});
+    EXPECT_EQ(read_vector<float>(result), (vector<float>{7, 10, 3, 0}));
+
+    file_util::remove_directory(directory);
+}
+#endif
+
+#ifdef NGRAPH_INTERPRETER_ENABLE
+TEST(backend_api, persistent_cache_default)
+{
+    if (!getenv_string("NGRAPH_COMPILATION_CACHE_DIR").empty())
+    {
+        return;
+    }
+    // Without NGRAPH_COMPILATION_CACHE_DIR nothing is cached or created on disk
+    auto backend = runtime::Backend::create("INTERPRETER");
+    EXPECT_EQ(backend->get_persistent_cache(), nullptr);
+
+    string directory =
+        file_util::path_join(file_util::get_temp_directory_path(), "persistent_cache_default");
+    file_util::remove_directory(directory);
+    auto cache = make_shared<runtime::PersistentCache>(directory);
+    backend->set_persistent_cache(cache);
+    EXPECT_EQ(backend->get_persistent_cache(), cache);
+    backend->set_persistent_cache(nullptr);
+    EXPECT_EQ(backend->get_persistent_cache(), nullptr);
+    file_util::remove_directory(directory);
+}
+#endif
+
+namespace
+{
+    /// Holds every call until open is called, and throws from calls without inputs
+    class GatedExecutable : public runtime::Executable
+    {
+    public:
+        bool call(const vector<shared_ptr<runtime::Tensor>>& /* outputs */,
+                  const vector<shared_ptr<runtime::Tensor>>& inputs) override
+        {
+            {
+                unique_lock<mutex> lock(m_mutex);
+                m_threads.insert(this_thread::get_id());
+                m_running++;
+                m_peak_running = max(m_peak_running, m_running);
+                m_cv.notify_all();
+                m_cv.wait(lock, [this]() { return m_open; });
+                m_running--;
+            }
+            if (inputs.empty())
+            {
+                throw ngraph_error("call failed");
+            }
+            return true;
+        }
+
+        /// \returns false if fewer than count calls were running before the timeout
+        bool wait_for_running(size_t count, chrono::seconds timeout)
+        {
+            unique_lock<mutex> lock(m_mutex);
+            return m_cv.wait_for(lock, timeout, [this, count]() { return m_running >= count; });
+        }
+
+        void open()
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_open = true;
+            m_cv.notify_all();
+        }
+
+        size_t get_peak_running()
+        {
+            lock_guard<mutex> lock(m_mutex);
+            return m_peak_running;
+        }
+
+        size_t get_thread_count()
+        {
+            lock_guard<mutex> lock(m_mutex);
+            return m_threads.size();
+        }
+
+    private:
+        mutex m_mutex;
+        condition_variable m_cv;
+        bool m_open = false;
+        size_t m_running = 0;
+        size_t m_peak_running = 0;
+        set<thread::id> m_threads;
+    };
+}
+
+TEST(backend_api, call_async)
+{
+    // The default call_async runs calls concurrently on at most one worker per hardware thread
+    size_t max_threads = max(1u, thread::hardware_concurrency());
+    size_t count = 2 * max_threads + 1;
+    size_t failing = count / 2;
+    auto input = make_shared<runtime::HostTensor>(element::f32, Shape{});
+    vector<future<bool>> futures;
+    {
+        GatedExecutable executable;
+        for (size_t i = 0; i < count; i++)
+        {
+            futures.push_back(executable.call_async(
+                {}, i == failing ? vector<shared_ptr<runtime::Tensor>>{}
+                                 : vector<shared_ptr<runtime::Tensor>>{input}));
+        }
+        EXPECT_TRUE(executable.wait_for_running(max_threads, chrono::seconds(10)));
+        executable.open();
+        for (size_t i = 0; i < count; i++)
+        {
+            if (i == failing)
+            {
+                // Exceptions thrown by call are passed to the future
+                EXPECT_THROW(futures[i].get(), ngraph_error);
+            }
+            else
+            {
+                EXPECT_TRUE(futures[i].get());
+            }
+        }
+        EXPECT_EQ(executable.get_peak_running(), max_threads);
+        EXPECT_LE(executable.get_thread_count(), max_threads);
+        // The destructor joins the workers
+    }
+
+    // A callback may release the last reference to the executable
+    auto executable = make_shared<GatedExecutable>();
+    executable->open();
+    promise<bool> done;
+    executable->call_async({}, {input}, [&done, executable](bool rc, exception_ptr error) mutable {
+        executable.reset();
+        done.set_value(rc && error == nullptr);
+    });
+    executable.reset();
+    EXPECT_TRUE(done.get_future().get());
+}
+
+#ifdef NGRAPH_INTERPRETER_ENABLE
+TEST(backend_api, interpreter_call_async)
+{
+    // Asynchronous calls with different tensors run concurrently on one executable
+    Shape shape{16};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Multiply>(make_shared<op::Add>(A, B), A),
+                                   ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto handle = backend->compile(f);
+    const size_t count = 16;
+    vector<shared_ptr<runtime::Tensor>> a(count);
+    vector<shared_ptr<runtime::Tensor>> b(count);
+    vector<shared_ptr<runtime::Tensor>> result(count);
+    vector<future<bool>> futures;
+    for (size_t i = 0; i < count; i++)
+    {
+        a[i] = backend->create_tensor(element::f32, shape);
+        b[i] = backend->create_tensor(element::f32, shape);
+        result[i] = backend->create_tensor(element::f32, shape);
+        copy_data(a[i], vector<float>(shape_size(shape), static_cast<float>(i)));
+        copy_data(b[i], vector<float>(shape_size(shape), 1.f));
+        futures.push_back(handle->call_async({result[i]}, {a[i], b[i]}));
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        EXPECT_TRUE(futures[i].get());
+        // (i + 1) * i
+        EXPECT_EQ(read_vector<float>(result[i]),
+                  vector<float>(shape_size(shape), static_cast<float>((i + 1) * i)));
+    }
+}
+#endif
+
+#ifdef NGRAPH_INTERPRETER_ENABLE
+TEST(backend_api, interpreter_io_binding)
+{
+    // The executable binds the caller's tensors into its precompiled op calls on every call.
+    // A, the intermediate A + B and a constant all reach the results by different paths.
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = op::Constant::create(element::f32, shape, {1, 1, 2, 2});
+    auto sum = make_shared<op::Add>(A, B);
+    auto f = make_shared<Function>(
+        NodeVector{make_shared<op::Multiply>(sum, A), A, make_shared<op::Add>(sum, C)},
+        ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto handle = backend->compile(f);
+    vector<vector<float>> inputs{{1, 2, 3, 4}, {5, 6, 7, 8}, {-1, 0, 1, 2}};
+    // (A + B) * A and (A + B) + C for each (inputs[i], inputs[i + 1]) pair
+    vector<vector<float>> products{{6, 16, 30, 48}, {20, 36, 56, 80}, {0, 0, 4, 12}};
+    vector<vector<float>> sums{{7, 9, 12, 14}, {5, 7, 10, 12}, {1, 3, 6, 8}};
+    for (size_t i = 0; i < 2 * inputs.size(); i++)
+    {
+        size_t k = i % inputs.size();
+        vector<shared_ptr<runtime::Tensor>> args;
+        vector<shared_ptr<runtime::Tensor>> results;
+        for (const vector<float>& data : {inputs[k], inputs[(k + 1) % inputs.size()]})
+        {
+            args.push_back(backend->create_tensor(element::f32, shape));
+            copy_data(args.back(), data);
+        }
+        for (size_t j = 0; j < 3; j++)
+        {
+            results.push_back(backend->create_tensor(element::f32, shape));
+        }
+        handle->call_with_validate(results, args);
+        EXPECT_EQ(read_vector<float>(results[0]), products[k]);
+        EXPECT_EQ(read_vector<float>(results[1]), inputs[k]);
+        EXPECT_EQ(read_vector<float>(results[2]), sums[k]);
+    }
+}
+
+TEST(backend_api, interpreter_concurrent_calls)
+{
+    // Concurrent calls each run out of their own temporary pool
+    Shape shape{64};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto sum = make_shared<op::Add>(A, B);
+    auto f = make_shared<Function>(make_shared<op::Multiply>(sum, sum), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto handle = backend->compile(f);
+    const size_t thread_count = 8;
+    const size_t iterations = 50;
+    vector<thread> threads;
+    vector<size_t> failures(thread_count, 0);
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&, t]() {
+            auto a = backend->create_tensor(element::f32, shape);
+            auto b = backend->create_tensor(element::f32, shape);
+            auto result = backend->create_tensor(element::f32, shape);
+            copy_data(a, vector<float>(shape_size(shape), static_cast<float>(t)));
+            copy_data(b, vector<float>(shape_size(shape), 1.f));
+            vector<float> expected(shape_size(shape), static_cast<float>((t + 1) * (t + 1)));
+            for (size_t i = 0; i < iterations; i++)
+            {
+                handle->call({result}, {a, b});
+                if (read_vector<float>(result) != expected)
+                {
+                    failures[t]++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(failures, vector<size_t>(thread_count, 0));
+    auto report = handle->get_memory_report();
+    EXPECT_GE(report.contexts, 1);
+    EXPECT_LE(report.contexts, thread_count);
+}
+
+TEST(backend_api, interpreter_concurrent_performance_counters)
+{
+    // Each call times its ops in its own context, so concurrent calls lose no counts
+    Shape shape{64};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Multiply>(make_shared<op::Add>(A, B), B),
+                                   ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto handle = backend->compile(f, true);
+    const size_t thread_count = 4;
+    const size_t iterations = 25;
+    vector<thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&]() {
+            auto a = backend->create_tensor(element::f32, shape);
+            auto b = backend->create_tensor(element::f32, shape);
+            auto result = backend->create_tensor(element::f32, shape);
+            for (size_t i = 0; i < iterations; i++)
+            {
+                handle->call({result}, {a, b});
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    size_t timed_ops = 0;
+    for (const runtime::PerformanceCounter& counter : handle->get_performance_data())
+    {
+        if (is_type<op::Add>(counter.get_node()) || is_type<op::Multiply>(counter.get_node()))
+        {
+            EXPECT_EQ(counter.call_count(), thread_count * iterations);
+            timed_ops++;
+        }
+    }
+    EXPECT_EQ(timed_ops, 2);
+}
+
+TEST(backend_api, memory_report)
+{
+    // (A + B) * B + C. B is used twice but holds one buffer, and A + B and its product with B
+    // are intermediates the size of A.
+    auto make_function = [](size_t n) {
+        Shape shape{n};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = op::Constant::create(element::f32, shape, vector<float>(n, 2.f));
+        auto C = op::Constant::create(element::f32, shape, vector<float>(n, 3.f));
+        auto product = make_shared<op::Multiply>(make_shared<op::Add>(A, B), B);
+        return make_shared<Function>(make_shared<op::Add>(product, C), ParameterVector{A});
+    };
+    // Both sizes are multiples of the interpreter's 64 byte alignment
+    const size_t n = 256;
+    const size_t tensor_bytes = n * sizeof(float);
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto handle = backend->compile(make_function(n));
+    auto report = handle->get_memory_report();
+    EXPECT_GE(report.activation_bytes, tensor_bytes);
+    EXPECT_EQ(report.constant_bytes, 2 * tensor_bytes);
+    EXPECT_EQ(report.scratchpad_bytes, 0);
+    // No context exists before the first call
+    EXPECT_EQ(report.contexts, 0);
+    EXPECT_EQ(report.allocated_contexts, 0);
+    EXPECT_EQ(report.peak_call_bytes, 0);
+    EXPECT_EQ(report.allocated_bytes(), report.constant_bytes);
+
+    // Activations grow with the intermediates, constants with the weights
+    auto large = backend->compile(make_function(4 * n))->get_memory_report();
+    EXPECT_EQ(large.activation_bytes, 4 * report.activation_bytes);
+    EXPECT_EQ(large.constant_bytes, 4 * report.constant_bytes);
+
+    auto a = backend->create_tensor(element::f32, Shape{n});
+    auto result = backend->create_tensor(element::f32, Shape{n});
+    copy_data(a, vector<float>(n, 1.f));
+    for (size_t i = 0; i < 2; i++)
+    {
+        handle->call_with_validate({result}, {a});
+        EXPECT_EQ(read_vector<float>(result), vector<float>(n, 9.f));
+    }
+    // Sequential calls share one context
+    report = handle->get_memory_report();
+    EXPECT_EQ(report.contexts, 1);
+    EXPECT_EQ(report.allocated_contexts, 1);
+    EXPECT_EQ(report.peak_call_bytes, report.activation_bytes);
+    EXPECT_EQ(report.allocated_bytes(), report.constant_bytes + report.activation_bytes);
+}
+#endif
+
 #if defined(NGRAPH_INTERPRETER_ENABLE) && defined(NGRAPH_CPU_ENABLE)
 TEST(backend_api, executable_can_create_tensor)
 {
@@ -0,0 +1,104 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <chrono>
+#include <future>
+
+#include "gtest/gtest.h"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/batching_executable.hpp"
+#include "util/all_close_f.hpp"
+#include "util/test_tools.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+TEST(batching_executable, batch)
+{
+    auto A = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 2});
+    auto B = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 2});
+    auto f = make_shared<Function>(make_shared<op::Multiply>(A, B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    map<size_t, shared_ptr<runtime::Executable>> executables;
+    for (size_t batch_size : {1, 4})
+    {
+        executables[batch_size] =
+            backend->compile(runtime::BatchingExecutable::specialize_batch(f, batch_size));
+    }
+    // The delay never expires during the test, so batches only run when they are full or
+    // flushed
+    runtime::BatchingExecutable batching(backend, executables, chrono::hours(1));
+
+    const size_t count = 6;
+    vector<shared_ptr<runtime::Tensor>> a(count);
+    vector<shared_ptr<runtime::Tensor>> b(count);
+    vector<shared_ptr<runtime::Tensor>> result(count);
+    vector<future<bool>> futures;
+    for (size_t i = 0; i < count; i++)
+    {
+        a[i] = backend->create_tensor(element::f32, Shape{1, 2});
+        b[i] = backend->create_tensor(element::f32, Shape{1, 2});
+        result[i] = backend->create_tensor(element::f32, Shape{1, 2});
+        float value = static_cast<float>(i);
+        copy_data<float>(a[i], {value, value + 1.f});
+        copy_data<float>(b[i], {2.f, 3.f});
+    }
+
+    // Four calls fill the largest batch, which runs at once
+    for (size_t i = 0; i < 4; i++)
+    {
+        futures.push_back(batching.call_async({result[i]}, {a[i], b[i]}));
+    }
+    for (size_t i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(futures[i].get());
+    }
+    EXPECT_EQ(batching.get_statistics().calls, 4);
+    EXPECT_EQ(batching.get_statistics().batches, 1);
+
+    // Two calls wait until they are flushed, then run together in a batch of 4
+    for (size_t i = 4; i < count; i++)
+    {
+        futures.push_back(batching.call_async({result[i]}, {a[i], b[i]}));
+    }
+    EXPECT_EQ(futures[4].wait_for(chrono::milliseconds(50)), future_status::timeout);
+    EXPECT_EQ(batching.get_statistics().batches, 1);
+    batching.flush();
+    for (size_t i = 4; i < count; i++)
+    {
+        EXPECT_TRUE(futures[i].get());
+    }
+    EXPECT_EQ(batching.get_statistics().calls, 6);
+    EXPECT_EQ(batching.get_statistics().batches, 2);
+    for (size_t i = 0; i < count; i++)
+    {
+        float value = static_cast<float>(i);
+        EXPECT_TRUE(
+            test::all_close_f(read_vector<float>(result[i]), {2.f * value, 3.f * value + 3.f}));
+    }
+
+    // A single flushed call runs in the smallest batch
+    auto single = batching.call_async({result[0]}, {a[3], b[3]});
+    batching.flush();
+    EXPECT_TRUE(single.get());
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result[0]), {6.f, 12.f}));
+    EXPECT_EQ(batching.get_statistics().batches, 3);
+
+    auto wrong_shape = backend->create_tensor(element::f32, Shape{2, 2});
+    EXPECT_THROW(batching.call_async({result[0]}, {wrong_shape, b[0]}), CheckFailure);
+}
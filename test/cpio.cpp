@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include <memory>
+#include <sstream>
 
 #include <gtest/gtest.h>
 
@@ -107,3 +108,20 @@ TEST(cpio, write)
         }
     }
 }
+
+TEST(cpio, large_record_header)
+{
+    // Records too large for the 32 bit filesize field carry a 64 bit size after their name.
+    // Only the header is written here, and the reader lists the record without reading it.
+    stringstream archive;
+    uint64_t size = 0x100000004ull;
+    cpio::Header::write(archive, "large", size);
+
+    cpio::Reader reader(archive);
+    auto file_info = reader.get_file_info();
+    ASSERT_EQ(file_info.size(), 1);
+    EXPECT_EQ(file_info[0].get_name(), "large");
+    EXPECT_EQ(file_info[0].get_size(), size);
+    // 26 byte header, "large" and its terminator, then the 64 bit size
+    EXPECT_EQ(file_info[0].get_offset(), 26 + 6 + 8);
+}
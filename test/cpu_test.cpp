@@ -14,8 +14,14 @@
 // limitations under the License.
 //*****************************************************************************
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <future>
 #include <iostream>
 #include <list>
 #include <memory>
@@ -38,9 +44,15 @@
 #include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
+#include "ngraph/runtime/cpu/cpu_arena_pool.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
+#include "ngraph/runtime/cpu/cpu_numa.hpp"
+#include "ngraph/runtime/cpu/cpu_scheduler.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
+#include "ngraph/runtime/cpu/cpu_weight_pool.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/op/convert_layout.hpp"
 #include "ngraph/runtime/cpu/op/max_pool_with_indices.hpp"
@@ -2310,3 +2322,537 @@ TEST(cpu_test, one_hot_scalar_oob_in_3)
     handle->call_with_validate({result}, {a});
     EXPECT_EQ(r_data[3], 0);
 }
+
+TEST(cpu_test, shared_constants)
+{
+    // The weights of a 1x1 convolution with 16 input channels are converted to a blocked
+    // MKLDNN layout at compile time. Two executables with equal weights share the converted
+    // buffer.
+    Shape data_shape{1, 16, 2, 2};
+    Shape weights_shape{32, 16, 1, 1};
+    vector<float> weights(shape_size(weights_shape));
+    for (size_t i = 0; i < weights.size(); i++)
+    {
+        weights[i] = static_cast<float>(i % 13) - 6;
+    }
+    auto make_function = [&]() {
+        auto A = make_shared<op::Parameter>(element::f32, data_shape);
+        auto W = op::Constant::create(element::f32, weights_shape, weights);
+        auto conv = make_shared<op::Convolution>(A,
+                                                 W,
+                                                 Strides{1, 1},
+                                                 Strides{1, 1},
+                                                 CoordinateDiff{0, 0},
+                                                 CoordinateDiff{0, 0},
+                                                 Strides{1, 1});
+        return make_shared<Function>(conv, ParameterVector{A});
+    };
+    auto get_weights = [](const shared_ptr<Function>& f) -> shared_ptr<op::Constant> {
+        for (auto& node : f->get_ops())
+        {
+            if (auto constant = as_type_ptr<op::Constant>(node))
+            {
+                return constant;
+            }
+        }
+        return nullptr;
+    };
+
+    auto& pool = runtime::cpu::WeightPool::get();
+    auto before = pool.get_statistics();
+
+    auto backend = runtime::Backend::create("CPU");
+    auto f1 = make_function();
+    auto handle1 = backend->compile(f1);
+    auto weights1 = get_weights(f1);
+    ASSERT_NE(weights1, nullptr);
+    auto layout = dynamic_pointer_cast<runtime::cpu::LayoutDescriptor>(
+        weights1->get_output_tensor_ptr(0)->get_tensor_layout());
+    ASSERT_NE(layout, nullptr);
+    EXPECT_TRUE(layout->is_mkldnn_layout());
+    EXPECT_EQ(pool.get_statistics().entries, before.entries + 1);
+
+    auto f2 = make_function();
+    auto handle2 = backend->compile(f2);
+    auto weights2 = get_weights(f2);
+    ASSERT_NE(weights2, nullptr);
+    EXPECT_EQ(weights1->get_data_ptr(), weights2->get_data_ptr());
+    auto after = pool.get_statistics();
+    EXPECT_EQ(after.entries, before.entries + 1);
+    EXPECT_EQ(after.hits, before.hits + 1);
+
+    test::Uniform<float> rng(-10.0f, 10.0f);
+    vector<float> data(shape_size(data_shape));
+    rng.initialize(data);
+    auto expected = execute(make_function(), vector<vector<float>>{data}, "INTERPRETER");
+
+    auto a = backend->create_tensor(element::f32, data_shape);
+    auto result = backend->create_tensor(element::f32, f1->get_output_shape(0));
+    copy_data(a, data);
+    for (auto& handle : {handle1, handle2})
+    {
+        handle->call_with_validate({result}, {a});
+        EXPECT_TRUE(test::all_close(read_vector<float>(result), expected.at(0), 1.0e-4f, 1.0e-4f));
+    }
+}
+
+TEST(cpu_test, lazy_arena)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    // A + B is an intermediate kept in the arena
+    auto f = make_shared<Function>(make_shared<op::Multiply>(make_shared<op::Add>(A, B), B),
+                                   ParameterVector{A, B});
+
+    auto& pool = runtime::cpu::ArenaPool::get();
+    auto idle_period = pool.get_idle_period();
+    auto max_bytes = pool.get_max_bytes();
+    pool.set_idle_period(chrono::milliseconds(0));
+    pool.set_max_bytes(1 << 20);
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->compile(f);
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data<float>(a, {1.f, 2.f, 3.f, 4.f});
+    copy_data<float>(b, {5.f, 6.f, 7.f, 8.f});
+
+    // The arena is allocated by the first call, not at compile time
+    EXPECT_EQ(handle->get_memory_report().allocated_contexts, 0);
+    EXPECT_EQ(pool.get_pooled_bytes(), 0);
+    handle->call_with_validate({result}, {a, b});
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {30.f, 48.f, 70.f, 96.f}));
+    EXPECT_EQ(handle->get_memory_report().allocated_contexts, 1);
+
+    // With no idle period the arena is kept
+    this_thread::sleep_for(chrono::milliseconds(50));
+    EXPECT_EQ(handle->get_memory_report().allocated_contexts, 1);
+
+    // The sweep thread gives the idle arena back to the pool without any further call
+    pool.set_idle_period(chrono::milliseconds(10));
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+    while (handle->get_memory_report().allocated_contexts > 0 &&
+           chrono::steady_clock::now() < deadline)
+    {
+        this_thread::sleep_for(chrono::milliseconds(5));
+    }
+    EXPECT_EQ(handle->get_memory_report().allocated_contexts, 0);
+    EXPECT_GT(pool.get_pooled_bytes(), 0);
+
+    // The next call takes the pooled arena again
+    pool.set_idle_period(chrono::milliseconds(0));
+    copy_data<float>(a, {2.f, 2.f, 2.f, 2.f});
+    handle->call_with_validate({result}, {a, b});
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {35.f, 48.f, 63.f, 80.f}));
+    EXPECT_EQ(handle->get_memory_report().allocated_contexts, 1);
+    EXPECT_EQ(pool.get_pooled_bytes(), 0);
+
+    // A negative period would make the sweep thread spin and release every arena
+    pool.set_idle_period(chrono::milliseconds(-5));
+    EXPECT_EQ(pool.get_idle_period().count(), 0);
+
+    pool.set_idle_period(idle_period);
+    pool.set_max_bytes(max_bytes);
+}
+
+TEST(cpu_test, memory_report)
+{
+    // (A + B) * D + C. D equals B, so the WeightPool gives both one buffer, and A + B and its
+    // product with D are intermediates the size of A.
+    auto make_function = [](size_t n) {
+        Shape shape{n};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = op::Constant::create(element::f32, shape, vector<float>(n, 2.f));
+        auto C = op::Constant::create(element::f32, shape, vector<float>(n, 3.f));
+        auto D = op::Constant::create(element::f32, shape, vector<float>(n, 2.f));
+        auto product = make_shared<op::Multiply>(make_shared<op::Add>(A, B), D);
+        return make_shared<Function>(make_shared<op::Add>(product, C), ParameterVector{A});
+    };
+    // Both sizes are multiples of the 4096 byte memory pool alignment
+    const size_t n = 1024;
+    const size_t tensor_bytes = n * sizeof(float);
+
+    set_environment("NGRAPH_CPU_CONCURRENCY", "2", 1);
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->compile(make_function(n));
+    unset_environment("NGRAPH_CPU_CONCURRENCY");
+    auto report = handle->get_memory_report();
+    EXPECT_GE(report.activation_bytes, tensor_bytes);
+    EXPECT_EQ(report.constant_bytes, 2 * tensor_bytes);
+    // Arenas are allocated by the first call that uses their context
+    EXPECT_EQ(report.contexts, 2);
+    EXPECT_EQ(report.allocated_contexts, 0);
+    EXPECT_EQ(report.peak_call_bytes, 0);
+    EXPECT_EQ(report.allocated_bytes(), report.constant_bytes);
+
+    auto large = backend->compile(make_function(4 * n))->get_memory_report();
+    EXPECT_EQ(large.activation_bytes, 4 * report.activation_bytes);
+    EXPECT_EQ(large.constant_bytes, 4 * report.constant_bytes);
+
+    auto a = backend->create_tensor(element::f32, Shape{n});
+    auto result = backend->create_tensor(element::f32, Shape{n});
+    copy_data(a, vector<float>(n, 1.f));
+    for (size_t i = 0; i < 2; i++)
+    {
+        handle->call_with_validate({result}, {a});
+        EXPECT_EQ(read_vector<float>(result), vector<float>(n, 9.f));
+    }
+    // Sequential calls reuse the released context, so only one arena is allocated
+    report = handle->get_memory_report();
+    EXPECT_EQ(report.contexts, 2);
+    EXPECT_EQ(report.allocated_contexts, 1);
+    EXPECT_EQ(report.peak_call_bytes, report.context_bytes());
+    EXPECT_EQ(report.allocated_bytes(), report.constant_bytes + report.context_bytes());
+}
+
+#ifndef NGRAPH_JSON_DISABLE
+TEST(cpu_test, save_load)
+{
+    // ConvolutionRelu with MKLDNN layouts, a ConvertLayout back to the result layout and an
+    // in-place add, so the saved function holds CPU ops, layouts and a memory plan
+    Shape data_shape{1, 16, 8, 8};
+    Shape weights_shape{16, 16, 3, 3};
+    auto make_function = [&]() {
+        auto data = make_shared<op::Parameter>(element::f32, data_shape);
+        vector<float> weights_values(shape_size(weights_shape));
+        test::Uniform<float> rng(-1.0f, 1.0f);
+        rng.initialize(weights_values);
+        auto weights = op::Constant::create(element::f32, weights_shape, weights_values);
+        auto conv = make_shared<op::Convolution>(data, weights, Strides{1, 1}, Strides{1, 1});
+        auto relu = make_shared<op::Relu>(conv);
+        auto bias = op::Constant::create(
+            element::f32, relu->get_shape(), vector<float>(shape_size(relu->get_shape()), 1.f));
+        return make_shared<Function>(make_shared<op::Add>(relu, bias), ParameterVector{data});
+    };
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->compile(make_function());
+    stringstream file;
+    handle->save(file);
+
+    auto other_backend = runtime::Backend::create("CPU");
+    auto loaded = other_backend->load(file);
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(loaded->get_parameters().size(), 1);
+    ASSERT_EQ(loaded->get_results().size(), 1);
+    EXPECT_EQ(loaded->get_results().at(0)->get_shape(), handle->get_results().at(0)->get_shape());
+
+    auto data = handle->create_input_tensor(0);
+    vector<float> data_values(shape_size(data_shape));
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    rng.initialize(data_values);
+    copy_data(data, data_values);
+    auto expected = handle->create_output_tensor(0);
+    auto result = loaded->create_output_tensor(0);
+    handle->call_with_validate({expected}, {data});
+    loaded->call_with_validate({result}, {data});
+    EXPECT_EQ(read_vector<float>(result), read_vector<float>(expected));
+
+    // Executables collecting performance data are not saved
+    auto timed = backend->compile(make_function(), true);
+    stringstream timed_file;
+    EXPECT_THROW(timed->save(timed_file), CheckFailure);
+}
+#endif
+
+TEST(cpu_test, call_after_failed_call)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Multiply>(make_shared<op::Add>(A, B), B),
+                                   ParameterVector{A, B});
+
+    // With the default single context, a context kept by the failed call would block the next
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->compile(f);
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data<float>(a, {1.f, 2.f, 3.f, 4.f});
+    copy_data<float>(b, {5.f, 6.f, 7.f, 8.f});
+
+    // Without outputs the call throws after it has taken its context
+    EXPECT_THROW(handle->call({}, {a, b}), ngraph_error);
+    auto next = async(launch::async, [&]() { return handle->call({result}, {a, b}); });
+    ASSERT_EQ(next.wait_for(chrono::seconds(10)), future_status::ready);
+    EXPECT_TRUE(next.get());
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {30.f, 48.f, 70.f, 96.f}));
+    // The failed call is no longer counted as running
+    EXPECT_EQ(handle->get_memory_report().peak_call_bytes,
+              handle->get_memory_report().context_bytes());
+}
+
+TEST(cpu_test, call_async)
+{
+    Shape shape{16};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Multiply>(make_shared<op::Add>(A, B), A),
+                                   ParameterVector{A, B});
+
+    // Two contexts, each with its own worker thread
+    set_environment("NGRAPH_CPU_CONCURRENCY", "2", 1);
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->compile(f);
+    unset_environment("NGRAPH_CPU_CONCURRENCY");
+
+    const size_t count = 16;
+    const size_t failing = 5;
+    vector<shared_ptr<runtime::Tensor>> a(count);
+    vector<shared_ptr<runtime::Tensor>> b(count);
+    vector<shared_ptr<runtime::Tensor>> result(count);
+    vector<future<bool>> futures;
+    for (size_t i = 0; i < count; i++)
+    {
+        a[i] = backend->create_tensor(element::f32, shape);
+        b[i] = backend->create_tensor(element::f32, shape);
+        result[i] = backend->create_tensor(element::f32, shape);
+        copy_data(a[i], vector<float>(shape_size(shape), static_cast<float>(i)));
+        copy_data(b[i], vector<float>(shape_size(shape), 1.f));
+        if (i == failing)
+        {
+            futures.push_back(handle->call_async({}, {a[i], b[i]}));
+        }
+        else
+        {
+            futures.push_back(handle->call_async({result[i]}, {a[i], b[i]}));
+        }
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i == failing)
+        {
+            // The exception reaches the future and the context is reused by later calls
+            EXPECT_THROW(futures[i].get(), ngraph_error);
+            continue;
+        }
+        EXPECT_TRUE(futures[i].get());
+        // (i + 1) * i
+        EXPECT_EQ(read_vector<float>(result[i]),
+                  vector<float>(shape_size(shape), static_cast<float>((i + 1) * i)));
+    }
+    EXPECT_LE(handle->get_memory_report().peak_call_bytes,
+              2 * handle->get_memory_report().context_bytes());
+
+    promise<bool> done;
+    handle->call_async({result[0]}, {a[1], b[1]}, [&done](bool rc, exception_ptr error) {
+        done.set_value(rc && error == nullptr);
+    });
+    EXPECT_TRUE(done.get_future().get());
+    EXPECT_EQ(read_vector<float>(result[0]), vector<float>(shape_size(shape), 2.f));
+}
+
+TEST(cpu_test, scheduler)
+{
+    // 0 -> {1, 2} -> 3, with 2 on the critical path
+    vector<vector<size_t>> dependencies{{}, {0}, {0}, {1, 2}};
+    runtime::cpu::CPUScheduler scheduler(dependencies, {1, 1, 10, 1}, 4);
+    EXPECT_EQ(scheduler.get_num_workers(), 4);
+    EXPECT_EQ(scheduler.get_priority_order(), (vector<size_t>{0, 2, 1, 3}));
+
+    for (size_t iteration = 0; iteration < 100; iteration++)
+    {
+        mutex order_mutex;
+        vector<size_t> order;
+        scheduler.run([&](size_t op, size_t worker) {
+            EXPECT_LT(worker, 4);
+            lock_guard<mutex> lock(order_mutex);
+            order.push_back(op);
+        });
+        ASSERT_EQ(order.size(), 4);
+        EXPECT_EQ(order.front(), 0);
+        EXPECT_EQ(order.back(), 3);
+    }
+
+    atomic<size_t> num_run{0};
+    EXPECT_THROW(scheduler.run([&](size_t op, size_t /* worker */) {
+        num_run++;
+        if (op == 1)
+        {
+            throw ngraph_error("op failed");
+        }
+    }),
+                 ngraph_error);
+    // Ops after a failure are skipped
+    EXPECT_LE(num_run, 3);
+}
+
+TEST(cpu_test, work_stealing)
+{
+    if (is_codegen_mode())
+    {
+        // TODO change to skip when there is a new release of gtest
+        NGRAPH_WARN << "This test is skipped for CODEGEN mode.";
+        return;
+    }
+
+    // The number of thread pools is fixed when the CPU executor is first used, so the test
+    // runs in a new process that sets it first
+    string death_test_style = ::testing::FLAGS_gtest_death_test_style;
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    set_environment("NGRAPH_INTER_OP_PARALLELISM", "2", 1);
+    EXPECT_EXIT(
+        {
+            // Two convolutions run on MKLDNN and feed an in-place Concat. Elementwise
+            // branches on B and C run concurrently and feed an in-place Reshape.
+            auto make_function = []() {
+                auto A = make_shared<op::Parameter>(element::f32, Shape{1, 16, 8, 8});
+                auto W1 = make_shared<op::Parameter>(element::f32, Shape{16, 16, 3, 3});
+                auto W2 = make_shared<op::Parameter>(element::f32, Shape{16, 16, 1, 1});
+                auto B = make_shared<op::Parameter>(element::f32, Shape{64});
+                auto C = make_shared<op::Parameter>(element::f32, Shape{64});
+                auto conv1 = make_shared<op::Convolution>(A,
+                                                          W1,
+                                                          Strides{1, 1},
+                                                          Strides{1, 1},
+                                                          CoordinateDiff{1, 1},
+                                                          CoordinateDiff{1, 1},
+                                                          Strides{1, 1});
+                auto conv2 = make_shared<op::Convolution>(A,
+                                                          W2,
+                                                          Strides{1, 1},
+                                                          Strides{1, 1},
+                                                          CoordinateDiff{0, 0},
+                                                          CoordinateDiff{0, 0},
+                                                          Strides{1, 1});
+                auto concat =
+                    make_shared<op::Concat>(NodeVector{make_shared<op::Relu>(conv1), conv2}, 1);
+                auto sum = make_shared<op::Add>(make_shared<op::Multiply>(B, C),
+                                                make_shared<op::Subtract>(B, C));
+                auto product = make_shared<op::Multiply>(make_shared<op::Add>(B, C),
+                                                         make_shared<op::Add>(B, B));
+                auto reshape = make_shared<op::Reshape>(
+                    make_shared<op::Add>(sum, product), AxisVector{0}, Shape{8, 8});
+                return make_shared<Function>(NodeVector{concat, reshape},
+                                             ParameterVector{A, W1, W2, B, C});
+            };
+
+            auto backend = runtime::Backend::create("CPU");
+            auto sequential = backend->compile(make_function());
+            set_environment("NGRAPH_CPU_USE_WORK_STEALING", "1", 1);
+            auto function = make_function();
+            auto stealing = backend->compile(function);
+            unset_environment("NGRAPH_CPU_USE_WORK_STEALING");
+
+            test::Uniform<float> rng(-1.0f, 1.0f);
+            vector<shared_ptr<runtime::Tensor>> inputs;
+            for (auto& parameter : function->get_parameters())
+            {
+                inputs.push_back(backend->create_tensor(parameter->get_element_type(),
+                                                        parameter->get_shape()));
+            }
+            auto make_outputs = [&]() {
+                vector<shared_ptr<runtime::Tensor>> outputs;
+                for (size_t i = 0; i < function->get_output_size(); i++)
+                {
+                    outputs.push_back(backend->create_tensor(function->get_output_element_type(i),
+                                                             function->get_output_shape(i)));
+                }
+                return outputs;
+            };
+            auto expected = make_outputs();
+            auto actual = make_outputs();
+            // The first call runs in order, later calls are scheduled across both pools
+            bool equal = true;
+            for (size_t iteration = 0; iteration < 20; iteration++)
+            {
+                for (auto& input : inputs)
+                {
+                    vector<float> data(shape_size(input->get_shape()));
+                    rng.initialize(data);
+                    copy_data(input, data);
+                }
+                sequential->call_with_validate(expected, inputs);
+                stealing->call_with_validate(actual, inputs);
+                for (size_t i = 0; i < expected.size(); i++)
+                {
+                    auto close = test::all_close(read_vector<float>(actual[i]),
+                                                 read_vector<float>(expected[i]),
+                                                 1.0e-5f,
+                                                 1.0e-5f);
+                    if (!close)
+                    {
+                        cerr << "Output " << i << " of call " << iteration << ": "
+                             << close.message();
+                        equal = false;
+                    }
+                }
+            }
+            exit(equal && runtime::cpu::executor::GetCPUExecutor().get_num_thread_pools() == 2
+                     ? 0
+                     : 1);
+        },
+        ::testing::ExitedWithCode(0),
+        "");
+    unset_environment("NGRAPH_INTER_OP_PARALLELISM");
+    ::testing::FLAGS_gtest_death_test_style = death_test_style;
+}
+
+TEST(cpu_test, numa_placement)
+{
+    size_t num_nodes = runtime::cpu::numa::get_num_nodes();
+    ASSERT_GE(num_nodes, 1);
+    for (size_t node = 0; node < num_nodes; node++)
+    {
+        EXPECT_FALSE(runtime::cpu::numa::get_node_cpus(node).empty());
+    }
+    if (num_nodes < 2)
+    {
+#ifdef GTEST_SKIP
+        GTEST_SKIP() << "Placement needs more than one NUMA node";
+#else
+        // TODO change to skip when there is a new release of gtest
+        NGRAPH_WARN << "This test is skipped on hosts with a single NUMA node.";
+        return;
+#endif
+    }
+    size_t node = num_nodes - 1;
+
+    // Placing memory moves pages but never changes their contents
+    const size_t size = 1 << 20;
+    runtime::AlignedBuffer buffer(size, 4096);
+    auto data = buffer.get_ptr<uint8_t>();
+    for (size_t i = 0; i < size; i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    EXPECT_TRUE(runtime::cpu::numa::bind_memory(data + 1, size - 1, node));
+    bool intact = true;
+    for (size_t i = 0; i < size; i++)
+    {
+        intact = intact && data[i] == static_cast<uint8_t>(i);
+    }
+    EXPECT_TRUE(intact);
+
+#if defined(__linux__)
+    // Binding a thread restricts it to CPUs of the node and only affects the thread itself
+    cpu_set_t main_before;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(main_before), &main_before), 0);
+    bool bound = false;
+    int get_result = -1;
+    cpu_set_t worker_mask;
+    CPU_ZERO(&worker_mask);
+    thread([&]() {
+        bound = runtime::cpu::numa::bind_current_thread(node);
+        get_result = sched_getaffinity(0, sizeof(worker_mask), &worker_mask);
+    }).join();
+    ASSERT_TRUE(bound);
+    ASSERT_EQ(get_result, 0);
+    const auto& node_cpus = runtime::cpu::numa::get_node_cpus(node);
+    EXPECT_GT(CPU_COUNT(&worker_mask), 0);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (CPU_ISSET(cpu, &worker_mask))
+        {
+            EXPECT_NE(find(node_cpus.begin(), node_cpus.end(), cpu), node_cpus.end())
+                << "CPU " << cpu << " is not on node " << node;
+        }
+    }
+    cpu_set_t main_after;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(main_after), &main_after), 0);
+    EXPECT_TRUE(CPU_EQUAL(&main_before, &main_after));
+#endif
+}
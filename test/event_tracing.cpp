@@ -24,6 +24,7 @@
 #include "gtest/gtest.h"
 #include "ngraph/event_tracing.hpp"
 #include "ngraph/file_util.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 
 using namespace std;
 
@@ -111,3 +112,93 @@ TEST(event_tracing, event_writer_callback)
         EXPECT_EQ(expected_event_key->second->get_stop(), next_event.get_stop());
     }
 }
+
+TEST(event_tracing, buffered_recorder)
+{
+    mutex events_mutex;
+    string events;
+    auto writer = [&](const string& batch) {
+        lock_guard<mutex> lock(events_mutex);
+        events += (events.empty() ? "" : ",\n") + batch;
+    };
+
+    const size_t num_threads = 4;
+    const size_t num_events = 1000;
+    ngraph::runtime::event::Recorder recorder(writer, 64, chrono::milliseconds(1));
+    vector<thread> threads;
+    for (size_t i = 0; i < num_threads; i++)
+    {
+        threads.emplace_back([&recorder, i]() {
+            for (size_t j = 0; j < num_events; j++)
+            {
+                recorder.record("op \"" + to_string(i) + "\"", "Test", "{\"j\":1}", j, 1);
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    // Args that do not fit in a record are dropped, the event is kept
+    recorder.record("large", "Test", string(1000, 'a'), 0, 1, true);
+    recorder.flush();
+
+    auto statistics = recorder.get_statistics();
+    EXPECT_EQ(statistics.recorded + statistics.dropped, num_threads * num_events + 1);
+    EXPECT_EQ(statistics.dropped_args, 1);
+    EXPECT_EQ(statistics.threads, num_threads + 1);
+
+    lock_guard<mutex> lock(events_mutex);
+    auto json = nlohmann::json::parse("[" + events + "]");
+    size_t num_complete = 0;
+    size_t reported_dropped = 0;
+    for (auto& event : json)
+    {
+        if (event["ph"] == "X")
+        {
+            num_complete++;
+            if (event["name"] != "large")
+            {
+                EXPECT_EQ(event["name"].get<string>().substr(0, 4), "op \"");
+                EXPECT_EQ(event["args"]["j"], 1);
+            }
+            else
+            {
+                EXPECT_EQ(event.count("args"), 0);
+            }
+        }
+        else if (event["ph"] == "C")
+        {
+            reported_dropped = event["args"]["dropped"].get<size_t>();
+        }
+    }
+    EXPECT_EQ(num_complete, statistics.recorded);
+    EXPECT_EQ(reported_dropped, statistics.dropped);
+}
+
+TEST(event_tracing, recorder_truncates_utf8)
+{
+    string events;
+    auto writer = [&](const string& batch) { events += (events.empty() ? "" : ",\n") + batch; };
+
+    // Names hold 64 bytes, so the two and three byte code points at byte 63 do not fit
+    const string prefix(63, 'a');
+    {
+        ngraph::runtime::event::Recorder recorder(writer, 64, chrono::milliseconds(1));
+        recorder.record(prefix + "\xc3\xa9", "Test", "", 0, 1);
+        recorder.record(prefix + "\xe2\x82\xac", "Test", "", 1, 1);
+        recorder.record(string(62, 'a') + "\xc3\xa9", "Test", "", 2, 1);
+    }
+
+    // Parsing fails on invalid UTF-8
+    auto json = nlohmann::json::parse("[" + events + "]");
+    vector<string> names;
+    for (auto& event : json)
+    {
+        if (event["ph"] == "X")
+        {
+            names.push_back(event["name"].get<string>());
+        }
+    }
+    EXPECT_EQ(names, (vector<string>{prefix, prefix, string(62, 'a') + "\xc3\xa9"}));
+}
@@ -14,6 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <fstream>
 #include <random>
 #include <sstream>
 #include <string>
@@ -21,6 +22,7 @@
 
 #include "gtest/gtest.h"
 #include "ngraph/file_util.hpp"
+#include "ngraph/mapped_file.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -90,8 +92,41 @@ TEST(file_util, path_join)
     }
 }
 
+TEST(file_util, get_directory)
+{
+    EXPECT_STREQ("/test1/test2", file_util::get_directory("/test1/test2/model.onnx").c_str());
+    EXPECT_STREQ("test1", file_util::get_directory("test1/model.onnx").c_str());
+    EXPECT_STREQ("", file_util::get_directory("model.onnx").c_str());
+}
+
 TEST(file_util, get_temp_directory_path)
 {
     string tmp = file_util::get_temp_directory_path();
     EXPECT_NE(0, tmp.size());
 }
+
+TEST(file_util, mapped_file_copy_on_write)
+{
+    const string tmp_file = "mapped_file_copy_on_write.bin";
+    {
+        ofstream out(tmp_file, ios_base::binary | ios_base::out);
+        out << "abcd";
+    }
+
+    {
+        MappedFile mapping(tmp_file);
+        ASSERT_EQ(mapping.size(), 4);
+        EXPECT_EQ(string(mapping.data(), mapping.size()), "abcd");
+        // Writes go to a private copy of the page
+        mapping.data()[0] = 'x';
+        EXPECT_EQ(string(mapping.data(), mapping.size()), "xbcd");
+    }
+
+    string contents;
+    {
+        ifstream in(tmp_file, ios_base::binary | ios_base::in);
+        getline(in, contents);
+    }
+    file_util::remove_file(tmp_file);
+    EXPECT_EQ(contents, "abcd");
+}
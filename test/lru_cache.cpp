@@ -0,0 +1,150 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/cache.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// A function whose estimated footprint is an f32 intermediate and result, 8 * size bytes
+static shared_ptr<Function> make_function(size_t size)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{size});
+    return make_shared<Function>(make_shared<op::Negative>(A), ParameterVector{A});
+}
+
+static bool contains(runtime::LRUCache& cache, int64_t key)
+{
+    runtime::LRUCache::Entry entry;
+    return cache.get_entry({key}, entry);
+}
+
+TEST(lru_cache, footprint)
+{
+    EXPECT_EQ(runtime::LRUCache::estimate_footprint(*make_function(10)), 80);
+}
+
+TEST(lru_cache, lru_order)
+{
+    runtime::LRUCache cache(3, 0);
+    cache.add_entry({1}, nullptr, make_function(1));
+    cache.add_entry({2}, nullptr, make_function(1));
+    cache.add_entry({3}, nullptr, make_function(1));
+
+    // Using 1 makes 2 the least recently used
+    EXPECT_TRUE(contains(cache, 1));
+    cache.add_entry({4}, nullptr, make_function(1));
+    EXPECT_FALSE(contains(cache, 2));
+    EXPECT_TRUE(contains(cache, 3));
+    EXPECT_TRUE(contains(cache, 1));
+    EXPECT_TRUE(contains(cache, 4));
+
+    // 3 is now the oldest
+    cache.add_entry({5}, nullptr, make_function(1));
+    EXPECT_FALSE(contains(cache, 3));
+
+    auto stats = cache.get_statistics();
+    EXPECT_EQ(stats.entries, 3);
+    EXPECT_EQ(stats.evictions, 2);
+}
+
+TEST(lru_cache, entry_limit_spans_shards)
+{
+    // With more shards than entries the limit still applies to the whole cache, and the
+    // entries that remain are the most recently added whichever shards they hash to.
+    runtime::LRUCache cache(4, 0, 16);
+    for (int64_t key = 0; key < 64; key++)
+    {
+        cache.add_entry({key}, nullptr, make_function(1));
+        EXPECT_LE(cache.get_statistics().entries, 4);
+    }
+    for (int64_t key = 60; key < 64; key++)
+    {
+        EXPECT_TRUE(contains(cache, key));
+    }
+    EXPECT_EQ(cache.get_statistics().evictions, 60);
+}
+
+TEST(lru_cache, byte_budget)
+{
+    runtime::LRUCache cache(100, 800, 8);
+    cache.add_entry({1}, nullptr, make_function(25));
+    cache.add_entry({2}, nullptr, make_function(25));
+    cache.add_entry({3}, nullptr, make_function(25));
+    cache.add_entry({4}, nullptr, make_function(25));
+    EXPECT_EQ(cache.get_statistics().bytes, 800);
+
+    // 400 more bytes evict the two least recently used entries
+    EXPECT_TRUE(contains(cache, 1));
+    cache.add_entry({5}, nullptr, make_function(50));
+    EXPECT_TRUE(contains(cache, 1));
+    EXPECT_FALSE(contains(cache, 2));
+    EXPECT_FALSE(contains(cache, 3));
+    EXPECT_TRUE(contains(cache, 4));
+    EXPECT_TRUE(contains(cache, 5));
+    EXPECT_EQ(cache.get_statistics().bytes, 800);
+
+    // An entry over the whole budget is not cached and evicts nothing
+    cache.add_entry({6}, nullptr, make_function(101));
+    EXPECT_FALSE(contains(cache, 6));
+    auto stats = cache.get_statistics();
+    EXPECT_EQ(stats.entries, 3);
+    EXPECT_EQ(stats.bytes, 800);
+}
+
+TEST(lru_cache, concurrent_get_and_add)
+{
+    const size_t max_entries = 32;
+    const size_t max_bytes = 32 * 80;
+    runtime::LRUCache cache(max_entries, max_bytes, 4);
+    auto function = make_function(10);
+
+    vector<thread> threads;
+    for (int64_t t = 0; t < 8; t++)
+    {
+        threads.emplace_back([&cache, &function, t]() {
+            for (int64_t i = 0; i < 500; i++)
+            {
+                runtime::CacheKey key{(t * 7 + i) % 64};
+                runtime::LRUCache::Entry entry;
+                if (cache.get_entry(key, entry))
+                {
+                    EXPECT_EQ(entry.function.get(), function.get());
+                }
+                else
+                {
+                    cache.add_entry(key, nullptr, function);
+                }
+            }
+        });
+    }
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+
+    auto stats = cache.get_statistics();
+    EXPECT_EQ(stats.hits + stats.misses, 8 * 500);
+    EXPECT_LE(stats.entries, max_entries);
+    EXPECT_LE(stats.bytes, max_bytes);
+    EXPECT_EQ(stats.bytes, stats.entries * 80);
+}
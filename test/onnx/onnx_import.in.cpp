@@ -27,7 +27,9 @@
 
 #include "gtest/gtest.h"
 #include "ngraph/frontend/onnx_import/onnx.hpp"
+#include "ngraph/mapped_file.hpp"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/shared_buffer.hpp"
 #include "util/all_close.hpp"
 #include "util/all_close_f.hpp"
 #include "util/ndarray.hpp"
@@ -356,6 +358,104 @@ NGRAPH_TEST(onnx_${BACKEND_NAME}, model_initializer_wo_input)
     EXPECT_TRUE(test::all_close_f(expected_output, output.front()));
 }
 
+NGRAPH_TEST(onnx_${BACKEND_NAME}, model_initializer_external_data)
+{
+    // The initializer is read from external_data.bin next to the model file
+    auto function = onnx_import::import_onnx_model(
+        file_util::path_join(SERIALIZED_ZOO, "onnx/external_data.prototxt"));
+
+    Inputs inputs;
+    inputs.emplace_back(std::vector<float>{0, 1, 2, 3, 4, 5});
+
+    std::vector<float> expected_output{0, 2, 6, 12, 20, 30};
+
+    Outputs output{execute(function, inputs, "${BACKEND_NAME}")};
+    EXPECT_TRUE(test::all_close_f(expected_output, output.front()));
+}
+
+NGRAPH_TEST(onnx_${BACKEND_NAME}, model_initializer_external_data_aligned)
+{
+    // Data at offset 0 of the mapping is page aligned, so the constant uses it in place
+    auto function = onnx_import::import_onnx_model(
+        file_util::path_join(SERIALIZED_ZOO, "onnx/external_data_aligned.prototxt"));
+
+    std::shared_ptr<op::Constant> constant;
+    for (const auto& node : function->get_ops())
+    {
+        if (auto c = as_type_ptr<op::Constant>(node))
+        {
+            constant = c;
+        }
+    }
+    ASSERT_NE(constant, nullptr);
+    EXPECT_NE(std::dynamic_pointer_cast<runtime::SharedBuffer<std::shared_ptr<MappedFile>>>(
+                  constant->get_data_buffer()),
+              nullptr);
+    auto address = reinterpret_cast<std::size_t>(constant->get_data_ptr());
+    EXPECT_EQ(address % op::Constant::host_alignment(), 0);
+
+    Inputs inputs;
+    inputs.emplace_back(std::vector<float>{0, 1, 2, 3, 4, 5});
+
+    std::vector<float> expected_output{0, 2, 6, 12, 20, 30};
+
+    Outputs output{execute(function, inputs, "${BACKEND_NAME}")};
+    EXPECT_TRUE(test::all_close_f(expected_output, output.front()));
+}
+
+NGRAPH_TEST(onnx_${BACKEND_NAME}, model_initializer_external_data_stream)
+{
+    // A model read from a stream resolves external data against the given directory
+    std::ifstream model_stream{
+        file_util::path_join(SERIALIZED_ZOO, "onnx/external_data_aligned.prototxt")};
+    auto function = onnx_import::import_onnx_model(
+        model_stream, file_util::path_join(SERIALIZED_ZOO, "onnx"));
+
+    Inputs inputs;
+    inputs.emplace_back(std::vector<float>{0, 1, 2, 3, 4, 5});
+
+    std::vector<float> expected_output{0, 2, 6, 12, 20, 30};
+
+    Outputs output{execute(function, inputs, "${BACKEND_NAME}")};
+    EXPECT_TRUE(test::all_close_f(expected_output, output.front()));
+}
+
+NGRAPH_TEST(onnx_${BACKEND_NAME}, model_initializer_external_data_shared)
+{
+    // W and B are stored 64 bytes apart in one file, which is mapped once for both
+    auto function = onnx_import::import_onnx_model(
+        file_util::path_join(SERIALIZED_ZOO, "onnx/external_data_shared.prototxt"));
+
+    std::vector<std::shared_ptr<op::Constant>> constants;
+    for (const auto& node : function->get_ordered_ops())
+    {
+        if (auto c = as_type_ptr<op::Constant>(node))
+        {
+            constants.push_back(c);
+        }
+    }
+    ASSERT_EQ(constants.size(), 2);
+    auto first = static_cast<const char*>(constants[0]->get_data_ptr());
+    auto second = static_cast<const char*>(constants[1]->get_data_ptr());
+    EXPECT_EQ(std::max(first, second) - std::min(first, second), 64);
+
+    Inputs inputs;
+    inputs.emplace_back(std::vector<float>{0, 1, 2, 3, 4, 5});
+
+    std::vector<float> expected_output{10, 22, 36, 52, 70, 90};
+
+    Outputs output{execute(function, inputs, "${BACKEND_NAME}")};
+    EXPECT_TRUE(test::all_close_f(expected_output, output.front()));
+}
+
+NGRAPH_TEST(onnx_${BACKEND_NAME}, model_initializer_external_data_bad_offset)
+{
+    // The offset is chosen so that offset + length wraps around to a value within the file
+    EXPECT_THROW(onnx_import::import_onnx_model(file_util::path_join(
+                     SERIALIZED_ZOO, "onnx/external_data_bad_offset.prototxt")),
+                 ngraph_error);
+}
+
 // ############################################################################ OPERATOR TESTS
 NGRAPH_TEST(onnx_${BACKEND_NAME}, model_addmul_abc)
 {
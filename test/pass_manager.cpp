@@ -23,6 +23,7 @@
 
 #include "ngraph/graph_util.hpp"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "util/test_tools.hpp"
 
@@ -67,3 +68,41 @@ TEST(pass_manager, serialize_with_revalidate_does_not_crash)
     auto graph = make_test_graph();
     pass_manager.run_passes(graph);
 }
+
+TEST(pass_manager, pass_profiling)
+{
+    auto a = op::Constant::create(element::f32, Shape{2}, {1, 2});
+    auto b = op::Constant::create(element::f32, Shape{2}, {3, 4});
+    auto f = make_shared<Function>(make_shared<op::Add>(a, b), ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.set_per_pass_validation(false);
+    pass_manager.set_pass_profiling(true);
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    auto& records = pass_manager.get_pass_profile().get_records();
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_NE(records[0].name.find("ConstantFolding"), string::npos);
+    EXPECT_EQ(records[0].nodes_before, 4);
+    EXPECT_EQ(records[0].nodes_after, 2);
+    EXPECT_EQ(records[0].rewrites, 1);
+
+    size_t matcher_rewrites = 0;
+    for (auto& matcher : records[0].matchers)
+    {
+        EXPECT_GE(matcher.attempts, matcher.matches);
+        EXPECT_GE(matcher.matches, matcher.rewrites);
+        matcher_rewrites += matcher.rewrites;
+    }
+    EXPECT_EQ(matcher_rewrites, 1);
+
+    stringstream json;
+    pass_manager.get_pass_profile().write_json(json);
+    EXPECT_NE(json.str().find("\"nodes_after\":2"), string::npos);
+
+    // A second run replaces the records of the first
+    pass_manager.run_passes(f);
+    ASSERT_EQ(pass_manager.get_pass_profile().get_records().size(), 1);
+    EXPECT_EQ(pass_manager.get_pass_profile().get_records()[0].nodes_before, 2);
+}
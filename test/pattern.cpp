@@ -765,3 +765,103 @@ TEST(pattern, is_contained_match)
     ASSERT_TRUE(n.match(label_abs2, absn2));
     ASSERT_FALSE(n.is_contained_match());
 }
+
+class DoubleNegationRewrite : public ngraph::pass::GraphRewrite
+{
+public:
+    DoubleNegationRewrite()
+        : GraphRewrite()
+    {
+        construct_double_negation();
+    }
+
+    void construct_double_negation()
+    {
+        auto x = std::make_shared<pattern::op::Label>(element::i32, Shape{});
+        auto pattern = std::make_shared<op::Negative>(std::make_shared<op::Negative>(x));
+
+        m_callback = [this, x](pattern::Matcher& m) {
+            ngraph::replace_node(m.get_match_root(), m.get_pattern_map()[x]);
+            // Request another pass with the same matcher, which only visits the changed nodes
+            this->add_matcher(m_matcher, m_callback, pass::all_pass_property_off);
+            m_rewrites++;
+            return true;
+        };
+
+        m_matcher = make_shared<TestMatcher>(pattern);
+        this->add_matcher(m_matcher, m_callback, pass::all_pass_property_off);
+    }
+
+    shared_ptr<pattern::Matcher> m_matcher;
+    graph_rewrite_callback m_callback;
+    size_t m_rewrites = 0;
+};
+
+TEST(pattern, graph_rewrite_repeated_pass)
+{
+    auto a = make_shared<op::Parameter>(element::i32, Shape{});
+    shared_ptr<Node> graph = a;
+    for (size_t i = 0; i < 5; i++)
+    {
+        graph = make_shared<op::Negative>(graph);
+    }
+    auto f = make_shared<Function>(graph, ParameterVector{a});
+
+    pass::Manager pass_manager;
+    auto rewrite = pass_manager.register_pass<DoubleNegationRewrite>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(rewrite->m_rewrites, 2);
+    auto result_arg = f->get_results().at(0)->get_argument(0);
+    ASSERT_TRUE(is_type<op::Negative>(result_arg));
+    EXPECT_EQ(result_arg->get_argument(0), a);
+}
+
+// Two matchers with the default name, where the first registers the second for another pass.
+// The second never ran before, so the next pass must visit the whole graph rather than only the
+// nodes the first one changed.
+class NegationThenAbsRewrite : public ngraph::pass::GraphRewrite
+{
+public:
+    NegationThenAbsRewrite()
+        : GraphRewrite()
+    {
+        auto x = std::make_shared<pattern::op::Label>(element::i32, Shape{});
+        auto pattern = std::make_shared<op::Negative>(std::make_shared<op::Negative>(x));
+        auto callback = [this, x](pattern::Matcher& m) {
+            ngraph::replace_node(m.get_match_root(), m.get_pattern_map()[x]);
+            construct_double_abs();
+            return true;
+        };
+        this->add_matcher(make_shared<TestMatcher>(pattern), callback, pass::all_pass_property_off);
+    }
+
+    void construct_double_abs()
+    {
+        auto y = std::make_shared<pattern::op::Label>(element::i32, Shape{});
+        auto pattern = std::make_shared<op::Abs>(std::make_shared<op::Abs>(y));
+        auto callback = [](pattern::Matcher& m) {
+            ngraph::replace_node(m.get_match_root(), m.get_match_root()->get_argument(0));
+            return true;
+        };
+        this->add_matcher(make_shared<TestMatcher>(pattern), callback, pass::all_pass_property_off);
+    }
+};
+
+TEST(pattern, graph_rewrite_unnamed_matchers)
+{
+    auto a = make_shared<op::Parameter>(element::i32, Shape{});
+    auto b = make_shared<op::Parameter>(element::i32, Shape{});
+    auto negation = make_shared<op::Negative>(make_shared<op::Negative>(a));
+    auto abs = make_shared<op::Abs>(make_shared<op::Abs>(b));
+    auto f = make_shared<Function>(NodeVector{negation, abs}, ParameterVector{a, b});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<NegationThenAbsRewrite>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(f->get_results().at(0)->get_argument(0), a);
+    auto abs_result = f->get_results().at(1)->get_argument(0);
+    ASSERT_TRUE(is_type<op::Abs>(abs_result));
+    EXPECT_EQ(abs_result->get_argument(0), b);
+}
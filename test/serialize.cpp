@@ -19,6 +19,7 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "ngraph/cpio.hpp"
 
 #include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
@@ -230,6 +231,68 @@ TEST(serialize, constant)
     EXPECT_TRUE(found);
 }
 
+TEST(serialize, constant_binary)
+{
+    const string tmp_file = "serialize_constant_binary.cpio";
+    auto A = op::Constant::create(element::i8, Shape{3}, {1, 2, 3});
+    auto B = op::Constant::create(element::f32, Shape{5}, {1.5, 2.5, 3.5, 4.5, 5.5});
+    auto f = make_shared<Function>(NodeVector{A, B}, ParameterVector{});
+
+    serialize_binary(tmp_file, f);
+    auto g = deserialize(tmp_file);
+    ASSERT_NE(g, nullptr);
+    ASSERT_EQ(g->get_output_size(), 2);
+    auto a = as_type_ptr<op::Constant>(g->get_output_op(0)->get_argument(0));
+    auto b = as_type_ptr<op::Constant>(g->get_output_op(1)->get_argument(0));
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ((vector<int8_t>{1, 2, 3}), a->get_vector<int8_t>());
+    EXPECT_EQ((vector<float>{1.5, 2.5, 3.5, 4.5, 5.5}), b->get_vector<float>());
+    EXPECT_EQ(size_t(a->get_data_ptr()) % op::Constant::host_alignment(), 0);
+    EXPECT_EQ(size_t(b->get_data_ptr()) % op::Constant::host_alignment(), 0);
+
+    // The archive is read by the stream overload as well
+    ifstream in(tmp_file, ios_base::binary | ios_base::in);
+    auto h = deserialize(in);
+    in.close();
+    file_util::remove_file(tmp_file);
+    ASSERT_NE(h, nullptr);
+    auto c = as_type_ptr<op::Constant>(h->get_output_op(1)->get_argument(0));
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ((vector<float>{1.5, 2.5, 3.5, 4.5, 5.5}), c->get_vector<float>());
+
+    EXPECT_THROW(serialize_binary("no_such_directory/" + tmp_file, f), CheckFailure);
+}
+
+TEST(serialize, constant_binary_truncated)
+{
+    const string tmp_file = "serialize_constant_binary_truncated.cpio";
+    auto A = op::Constant::create(element::f32, Shape{5}, {1.5, 2.5, 3.5, 4.5, 5.5});
+    auto f = make_shared<Function>(NodeVector{A}, ParameterVector{});
+    stringstream archive;
+    serialize_binary(archive, f);
+
+    // Copy the archive, dropping the last element of the constant's record
+    {
+        cpio::Reader reader(archive);
+        cpio::Writer writer(tmp_file);
+        for (const cpio::FileInfo& info : reader.get_file_info())
+        {
+            vector<char> data = reader.read(info);
+            if (info.get_name() == A->get_name())
+            {
+                data.resize(data.size() - sizeof(float));
+            }
+            writer.write(info.get_name(), data.data(), data.size(), op::Constant::host_alignment());
+        }
+    }
+    EXPECT_THROW(deserialize(tmp_file), exception);
+    ifstream in(tmp_file, ios_base::binary | ios_base::in);
+    EXPECT_THROW(deserialize(in), exception);
+    in.close();
+    file_util::remove_file(tmp_file);
+}
+
 TEST(benchmark, serialize)
 {
     stopwatch timer;
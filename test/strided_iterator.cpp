@@ -0,0 +1,88 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+TEST(strided_iterator, shape0d)
+{
+    StridedIterator it(Shape{}, {Strides{}});
+    ASSERT_FALSE(it.done());
+    EXPECT_EQ(it.get_inner_size(), 1);
+    EXPECT_EQ(it.get_offset(0), 0);
+    it.next_row();
+    EXPECT_TRUE(it.done());
+}
+
+TEST(strided_iterator, empty_shape)
+{
+    StridedIterator it(Shape{2, 0, 3}, {Strides{0, 3, 1}});
+    EXPECT_TRUE(it.done());
+}
+
+TEST(strided_iterator, matches_coordinate_transform)
+{
+    Shape shape{2, 3, 4};
+    Strides strides{1, 8, 2};
+    CoordinateTransform transform(shape);
+    auto coord = transform.begin();
+    for (StridedIterator it(shape, {strides}); !it.done(); it.next_row())
+    {
+        size_t offset = it.get_offset(0);
+        for (size_t i = 0; i < it.get_inner_size(); ++i, ++coord)
+        {
+            size_t expected = 0;
+            for (size_t axis = 0; axis < shape.size(); ++axis)
+            {
+                expected += (*coord)[axis] * strides[axis];
+            }
+            EXPECT_EQ(offset, expected);
+            offset += it.get_inner_stride(0);
+        }
+    }
+    EXPECT_TRUE(coord == transform.end());
+}
+
+TEST(strided_iterator, reduced_strides)
+{
+    EXPECT_EQ(StridedIterator::reduced_strides(Shape{2, 3, 4}, AxisSet{}), (Strides{12, 4, 1}));
+    EXPECT_EQ(StridedIterator::reduced_strides(Shape{2, 3, 4}, AxisSet{1}), (Strides{4, 0, 1}));
+    EXPECT_EQ(StridedIterator::reduced_strides(Shape{2, 3, 4}, AxisSet{0, 2}),
+              (Strides{0, 1, 0}));
+}
+
+TEST(strided_iterator, multiple_operands)
+{
+    Shape shape{2, 3};
+    vector<size_t> first;
+    vector<size_t> second;
+    for (StridedIterator it(shape, {Strides{3, 1}, Strides{1, 2}}); !it.done(); it.next_row())
+    {
+        for (size_t i = 0; i < it.get_inner_size(); ++i)
+        {
+            first.push_back(it.get_offset(0) + i * it.get_inner_stride(0));
+            second.push_back(it.get_offset(1) + i * it.get_inner_stride(1));
+        }
+    }
+    EXPECT_EQ(first, (vector<size_t>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(second, (vector<size_t>{0, 2, 4, 1, 3, 5}));
+}
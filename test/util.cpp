@@ -21,6 +21,8 @@
 
 #include "gtest/gtest.h"
 
+#include "misc.hpp"
+#include "ngraph/env_util.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
@@ -141,6 +143,27 @@ TEST(util, trim)
     EXPECT_STREQ("test", trim(" \t test \t ").c_str());
 }
 
+TEST(util, fnv1a_hash)
+{
+    FNV1aHash empty;
+    EXPECT_EQ(empty.get(), 0xcbf29ce484222325ULL);
+    FNV1aHash hash;
+    hash.add_bytes("a", 1);
+    EXPECT_EQ(hash.get(), 0xaf63dc4c8601ec8cULL);
+    hash.add_bytes("bc", 2);
+    FNV1aHash single;
+    single.add_bytes("abc", 3);
+    EXPECT_EQ(hash.get(), single.get());
+}
+
+TEST(util, append_json_escaped)
+{
+    string name = "a\"b\\c\n\x01\x1f\xc3\xa9";
+    string out = "x";
+    append_json_escaped(out, name.data(), name.size());
+    EXPECT_EQ(out, "xa\\\"b\\\\c\\u000a\\u0001\\u001f\xc3\xa9");
+}
+
 #if defined(NGRAPH_INTERPRETER_ENABLE)
 TEST(util, all_close)
 {
@@ -691,3 +714,53 @@ TEST(util, clone_function_op_annotations)
     EXPECT_TRUE(found_A);
     EXPECT_TRUE(found_B);
 }
+
+TEST(util, ordered_ops_follow_topology_changes)
+{
+    Shape shape{2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto neg = make_shared<op::Negative>(A);
+    auto add = make_shared<op::Add>(neg, B);
+    auto f = make_shared<Function>(add, ParameterVector{A, B});
+
+    auto ops = f->get_ordered_ops();
+    size_t version = f->get_topology_version();
+    EXPECT_EQ(f->get_ordered_ops(), ops);
+    EXPECT_EQ(f->get_topology_version(), version);
+
+    auto abs = make_shared<op::Abs>(B);
+    EXPECT_EQ(f->get_topology_version(), version);
+    replace_node(neg, abs);
+    EXPECT_NE(f->get_topology_version(), version);
+
+    auto reordered = f->get_ordered_ops();
+    EXPECT_EQ(reordered.size(), ops.size());
+    EXPECT_EQ(count(reordered.begin(), reordered.end(), neg), 0);
+    EXPECT_LT(distance(reordered.begin(), find(reordered.begin(), reordered.end(), abs)),
+              distance(reordered.begin(), find(reordered.begin(), reordered.end(), add)));
+
+    version = f->get_topology_version();
+    add->add_control_dependency(A);
+    EXPECT_NE(f->get_topology_version(), version);
+}
+
+TEST(util, getenv_size)
+{
+    const char* name = "NGRAPH_TEST_GETENV_SIZE";
+    unset_environment(name);
+    EXPECT_EQ(getenv_size(name, 7), 7);
+    // Values that do not fit in 32 bits are not truncated
+    set_environment(name, "4294967296", 1);
+    EXPECT_EQ(getenv_size(name, 7), size_t(1) << 32);
+    // Values that are not positive give the default
+    set_environment(name, "0", 1);
+    EXPECT_EQ(getenv_size(name, 7), 7);
+    set_environment(name, "-3000000000", 1);
+    EXPECT_EQ(getenv_size(name, 7), 7);
+    set_environment(name, "12MB", 1);
+    EXPECT_THROW(getenv_size(name, 7), runtime_error);
+    set_environment(name, "99999999999999999999999", 1);
+    EXPECT_THROW(getenv_size(name, 7), runtime_error);
+    unset_environment(name);
+}